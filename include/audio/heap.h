@@ -5,6 +5,8 @@
 #include "libc/stddef.h"
 #include "unk.h"
 
+struct Sample;
+
 typedef struct {
     /* 0x0 */ size_t heapSize; // total number of bytes allocated to the audio heap. Must be <= the size of `gAudioHeap` (ideally about the same size)
     /* 0x4 */ size_t initPoolSize; // The entire audio heap is split into two pools. 
@@ -71,6 +73,19 @@ typedef struct {
     /* 0x100 */ UNK_TYPE1 pad100[0x10];
 } AudioCache; // size = 0x110
 
+#define AUDIO_CACHE_ID_MAX 0x100
+
+/**
+ * Counters for the seq, font or sample bank cache, kept since boot so cache sizes can be tuned from real use
+ */
+typedef struct {
+    /* 0x00 */ size_t persistentHighWater; // Most bytes ever used in the persistent cache
+    /* 0x04 */ size_t temporaryHighWater; // Largest entry loaded into the temporary cache
+    /* 0x08 */ u32 evictions; // Entries discarded from the persistent or temporary cache
+    /* 0x0C */ u32 bytesLoaded; // Bytes allocated for new entries
+    /* 0x10 */ u32 bytesReloaded; // Part of `bytesLoaded` for ids that had been evicted before
+} AudioCacheStats; // size = 0x14
+
 typedef struct {
     /* 0x0 */ size_t persistentCommonPoolSize;
     /* 0x4 */ size_t temporaryCommonPoolSize;
@@ -88,6 +103,68 @@ typedef struct {
     /* 0xC */ size_t cachePoolSize; 
 } AudioSessionPoolSplit; // size = 0x10
 
+#define AUDIO_PCM_CACHE_SIZE 0x6000
+#define AUDIO_PCM_CACHE_SAMPLE_MAX 0x2000 // Largest decoded sample, in bytes, that is given an entry
+#define AUDIO_PCM_CACHE_ENTRY_MAX 16
+#define AUDIO_PCM_CACHE_CANDIDATE_COUNT 8
+#define AUDIO_PCM_CACHE_MISC_RESERVE 0x1000 // Misc pool space left for reverb buffers allocated after init
+
+typedef enum {
+    /* 0 */ AUDIO_PCM_CACHE_STATE_NONE,
+    /* 1 */ AUDIO_PCM_CACHE_STATE_FILLING, // Notes playing the sample save their decoded frames to the entry
+    /* 2 */ AUDIO_PCM_CACHE_STATE_READY
+} AudioPcmCacheState;
+
+/**
+ * Decoded samples for one ADPCM sample. `offset` is the start of `size` bytes in the cache, holding a frame of
+ * silence followed by every frame of the sample, the way the microcode writes them to DMEM when decoding
+ */
+typedef struct {
+    /* 0x00 */ u8* sampleAddr;
+    /* 0x04 */ u32 sampleSize;
+    /* 0x08 */ u8 codec;
+    /* 0x09 */ u8 state; // See `AudioPcmCacheState`
+    /* 0x0A */ u8 isRam; // Only valid while `ramGeneration` matches, as the sample's memory may be reused
+    /* 0x0B */ u8 pad0B;
+    /* 0x0C */ u32 ramGeneration;
+    /* 0x10 */ u16 serial; // Changes every time the entry is given to another sample
+    /* 0x12 */ u16 numFrames;
+    /* 0x14 */ u16 numFramesFilled;
+    /* 0x16 */ u16 offset;
+    /* 0x18 */ u32 size;
+    /* 0x1C */ s32 lastUsedTask; // `totalTaskCount` the entry was last used in, entries in use are never evicted
+    /* 0x20 */ s32 readyTask; // `totalTaskCount` the last frame was saved in
+} AudioPcmCacheEntry; // size = 0x24
+
+typedef struct {
+    /* 0x0 */ u8 entryIndex; // Index + 1 of the entry the note uses, or 0 if none
+    /* 0x1 */ u8 isHit; // Reads the entry instead of decoding and filling it
+    /* 0x2 */ u16 serial;
+} AudioPcmCacheNote; // size = 0x4
+
+typedef struct {
+    /* 0x000 */ s16* pcm; // NULL if the misc pool had no room for the cache
+    /* 0x004 */ AudioPcmCacheNote* notes;
+    /* 0x008 */ AudioPcmCacheEntry entries[AUDIO_PCM_CACHE_ENTRY_MAX];
+    /* 0x248 */ u8* candidates[AUDIO_PCM_CACHE_CANDIDATE_COUNT]; // Samples that missed recently
+    /* 0x268 */ s32 nextCandidate;
+    /* 0x26C */ u32 ramGeneration;
+    /* 0x270 */ u16 nextSerial;
+    /* 0x272 */ u8 isDisabled;
+} AudioPcmCache; // size = 0x274
+
+/**
+ * Counters for the decoded sample cache, kept since boot
+ */
+typedef struct {
+    /* 0x00 */ u32 hits; // Notes that read decoded samples instead of decoding
+    /* 0x04 */ u32 misses; // Notes on cacheable samples that had to decode
+    /* 0x08 */ u32 fills; // Samples fully saved to the cache
+    /* 0x0C */ u32 evictions;
+    /* 0x10 */ size_t bytesCached; // Bytes currently given to entries
+    /* 0x14 */ size_t maxBytesCached;
+} AudioPcmCacheStats; // size = 0x18
+
 void AudioHeap_DiscardFont(s32 fontId);
 void* AudioHeap_WritebackDCache(void* addr, size_t size);
 void* AudioHeap_AllocAttemptExternal(AudioAllocPool* pool, size_t size);
@@ -107,5 +184,11 @@ void* AudioHeap_AllocPermanent(s32 tableType, s32 id, size_t size);
 void* AudioHeap_AllocSampleCache(size_t size, s32 sampleBankId, void* sampleAddr, s8 medium, s32 cache);
 void AudioHeap_ApplySampleBankCache(s32 sampleBankId);
 void AudioHeap_SetReverbData(s32 reverbIndex, u32 dataType, s32 data, s32 isFirstInit);
+AudioPcmCacheEntry* AudioHeap_SearchPcmCache(struct Sample* sample);
+AudioPcmCacheEntry* AudioHeap_AllocPcmCache(struct Sample* sample, s32 numFrames);
+
+extern AudioCacheStats gAudioCacheStats[3];
+extern AudioPcmCache gAudioPcmCache;
+extern AudioPcmCacheStats gAudioPcmCacheStats;
 
 #endif
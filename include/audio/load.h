@@ -105,6 +105,27 @@ typedef struct {
     /* 0xE */ u8 ttl;        // Time To Live: duration after which the DMA can be discarded
 } SampleDma; // size = 0x10
 
+#define SAMPLE_DMA_HASH_SIZE 64
+#define SAMPLE_DMA_NONE 0xFFFF
+
+// Default for `gSamplePrefetchTicks`
+#define SAMPLE_PREFETCH_TICKS 4
+// Bytes covered by a prefetch, the size of the first chunk of an adpcm sample the synthesizer requests
+#define SAMPLE_PREFETCH_SIZE 0xA0
+// Frame DMA slots kept free for the synthesizer's own requests
+#define SAMPLE_PREFETCH_DMA_RESERVE 0x10
+
+typedef struct {
+    /* 0x00 */ u32 hits;
+    /* 0x04 */ u32 misses; // Requests that started a new DMA
+    /* 0x08 */ u32 evictions; // Misses that replaced a buffer holding earlier data
+    /* 0x0C */ u32 failures; // Requests with no buffer free to DMA into
+    /* 0x10 */ u32 candidatesTested;
+    /* 0x14 */ u32 prefetches; // DMAs started ahead of a note by `AudioLoad_PrefetchSampleData`
+    /* 0x18 */ u32 prefetchHits; // Prefetched buffers later requested by the synthesizer
+    /* 0x1C */ u32 prefetchesWasted; // Prefetched buffers reused before anything requested them
+} SampleDmaCacheStats; // size = 0x20
+
 typedef struct {
     /* 0x00 */ u32 endAndMediumKey;
     /* 0x04 */ struct Sample* sample;
@@ -115,6 +136,7 @@ typedef struct {
 
 void AudioLoad_DecreaseSampleDmaTtls(void);
 void* AudioLoad_DmaSampleData(uintptr_t devAddr, size_t size, s32 arg2, u8* dmaIndexRef, s32 medium);
+void AudioLoad_PrefetchSampleData(uintptr_t devAddr, s32 medium);
 void AudioLoad_InitSampleDmaBuffers(s32 numNotes);
 s32 AudioLoad_IsFontLoadComplete(s32 fontId);
 s32 AudioLoad_IsSeqLoadComplete(s32 seqId);
@@ -142,4 +164,7 @@ void AudioLoad_ScriptLoad(s32 tableType, s32 id, s8* isDone);
 void AudioLoad_ProcessScriptLoads(void);
 void AudioLoad_InitScriptLoads(void);
 
+extern SampleDmaCacheStats gSampleDmaCacheStats;
+extern s32 gSamplePrefetchTicks; // How many ticks before a note starts its sample is prefetched, 0 to disable
+
 #endif
@@ -53,6 +53,7 @@ typedef enum {
     /* 0xE4 */ AUDIOCMD_OP_GLOBAL_SET_CUSTOM_FUNCTION, // TODO: check
     /* 0xE5 */ AUDIOCMD_OP_GLOBAL_E5,                  // TODO: check
     /* 0xE6 */ AUDIOCMD_OP_GLOBAL_SET_REVERB_DATA,
+    /* 0xE7 */ AUDIOCMD_OP_GLOBAL_SET_SAMPLE_PREFETCH_TICKS,
     /* 0xF0 */ AUDIOCMD_OP_GLOBAL_SET_SOUND_MODE = 0xF0,
     /* 0xF1 */ AUDIOCMD_OP_GLOBAL_MUTE,
     /* 0xF2 */ AUDIOCMD_OP_GLOBAL_UNMUTE,
@@ -516,6 +517,14 @@ typedef enum {
 #define AUDIOCMD_GLOBAL_SET_REVERB_DATA(reverbIndex, dataType, data) \
     AudioThread_QueueCmdS32(AUDIO_MK_CMD(AUDIOCMD_OP_GLOBAL_SET_REVERB_DATA, dataType, reverbIndex, 0), data)
 
+/**
+ * Set how many ticks before a note starts its sample is prefetched
+ *
+ * @param ticks (s32) 0 disables prefetching
+ */
+#define AUDIOCMD_GLOBAL_SET_SAMPLE_PREFETCH_TICKS(ticks) \
+    AudioThread_QueueCmdS32(AUDIO_MK_CMD(AUDIOCMD_OP_GLOBAL_SET_SAMPLE_PREFETCH_TICKS, 0, 0, 0), ticks)
+
 /**
  * Change the sound mode of audio
  *
@@ -153,10 +153,13 @@ void EffectSS_Clear(PlayState* play);
 EffectSs* EffectSS_GetTable(void);
 void EffectSS_Delete(EffectSs* effectSs);
 void EffectSS_ResetEntry(EffectSs* particle);
+void EffectSS_SyncSlot(EffectSs* effectSs);
+s32 EffectSS_FindFirstInMask(u32* mask, s32 start);
 s32 EffectSS_FindFreeSpace(s32 priority, s32* tableEntry);
 void EffectSS_Copy(PlayState* play, EffectSs* effectsSs);
 void EffectSs_Spawn(PlayState* play, s32 type, s32 priority, void* initData);
 void EffectSS_UpdateParticle(PlayState* play, s32 index);
+void EffectSS_ClearStats(void);
 void EffectSS_UpdateAllParticles(PlayState* play);
 void EffectSS_DrawParticle(PlayState* play, s32 index);
 void EffectSS_DrawAllParticles(PlayState* play);
@@ -383,6 +386,14 @@ void Actor_InitHalfDaysBit(ActorContext* actorCtx);
 void Actor_InitContext(PlayState* play, ActorContext* actorCtx, ActorEntry* actorEntry);
 void Actor_UpdateAll(PlayState* play, ActorContext* actorCtx);
 s32 Actor_AddToLensActors(PlayState* play, Actor* actor);
+void ActorHotTable_Sync(ActorHotTable* table, ActorContext* actorCtx);
+void ActorHotTable_ProjectAndCull(ActorHotTable* table, PlayState* play);
+void ActorDrawSort_SetEnabled(s32 isEnabled);
+ActorDrawSort* ActorDrawSort_Get(void);
+s32 ActorDrawSort_GetSetupDL(Gfx* gfx, Gfx* end);
+void ActorDrawSort_Begin(ActorDrawSort* sort, PlayState* play);
+void ActorDrawSort_Draw(ActorDrawSort* sort, PlayState* play, Actor* actor);
+void ActorDrawSort_End(ActorDrawSort* sort, PlayState* play);
 void Actor_DrawAll(PlayState* play, ActorContext* actorCtx);
 void Actor_KillAllWithMissingObject(PlayState* play, ActorContext* actorCtx);
 void func_800BA798(PlayState* play, ActorContext* actorCtx);
@@ -443,6 +454,18 @@ uintptr_t ActorOverlayTable_FaultAddrConv(uintptr_t address, void* param);
 void ActorOverlayTable_Init(void);
 void ActorOverlayTable_Cleanup(void);
 
+void ActorGrid_Init(void);
+void ActorGrid_Build(ActorContext* actorCtx);
+void ActorGrid_Insert(Actor* actor);
+void ActorGrid_Remove(Actor* actor);
+Actor* ActorGrid_FindFirst(PlayState* play, Actor* inActor, s16 actorId, u8 actorCategory, f32 distance);
+Actor* ActorGrid_FindNearest(PlayState* play, Vec3f* pos, Actor* exclude, s16 actorId, u8 actorCategory, f32 distance);
+s32 ActorGrid_FindAll(PlayState* play, Vec3f* pos, Actor* exclude, s16 actorId, u8 actorCategory, f32 distance, Actor** outActors, s32 maxActors);
+
+void CullBatch_Project(MtxF* mf, f32* x, f32* y, f32* z, s32 count, f32* outX, f32* outY, f32* outZ, f32* outW);
+u32 CullBatch_GetSortKey(f32 depth);
+void CullBatch_SortByDepth(f32* depths, s32 count, u16* order);
+
 void DynaPolyActor_UpdateCarriedActorPos(CollisionContext* colCtx, s32 bgId, Actor* carriedActor);
 void DynaPolyActor_UpdateCarriedActorRotY(CollisionContext* colCtx, s32 bgId, Actor* carriedActor);
 void DynaPolyActor_AttachCarriedActor(CollisionContext* colCtx, Actor* carriedActor, s32 bgId);
@@ -651,12 +674,16 @@ void Lights_BindPointWithReference(Lights* lights, LightParams* params, Vec3f* p
 void Lights_BindPoint(Lights* lights, LightParams* params, PlayState* play);
 void Lights_BindDirectional(Lights* lights, LightParams* params, void* unused);
 void Lights_BindAll(Lights* lights, LightNode* listHead, Vec3f* refPos, PlayState* play);
+void LightGrid_Build(LightContext* lightCtx);
+void LightGrid_BindAll(Lights* lights, Vec3f* refPos);
+LightGrid* LightGrid_Get(void);
 LightNode* Lights_FindBufSlot(void);
 void Lights_FreeNode(LightNode* light);
 void LightContext_Init(PlayState* play, LightContext* lightCtx);
 void LightContext_SetAmbientColor(LightContext* lightCtx, u8 r, u8 g, u8 b);
 void LightContext_SetFog(LightContext* lightCtx, u8 r, u8 g, u8 b, s16 near, s16 far);
 Lights* LightContext_NewLights(LightContext* lightCtx, GraphicsContext* gfxCtx);
+Lights* LightContext_NewBoundLights(PlayState* play, Vec3f* refPos, s32 enablePosLights);
 void LightContext_InitList(PlayState* play, LightContext* lightCtx);
 void LightContext_DestroyList(PlayState* play, LightContext* lightCtx);
 LightNode* LightContext_InsertLight(PlayState* play, LightContext* lightCtx, LightInfo* info);
@@ -1167,6 +1194,11 @@ void GameAlloc_Cleanup(GameAlloc* this);
 void GameAlloc_Init(GameAlloc* this);
 void Graph_FaultClient(void);
 void Graph_InitTHGA(TwoHeadGfxArena* arena, Gfx* buffer, s32 size);
+GraphDispUsage* Graph_GetDispUsage(s32 framesAgo);
+GraphDispStats* Graph_GetDispStats(void);
+void Graph_SetDispRebalance(s32 isEnabled);
+void Graph_RecordDispUsage(GraphicsContext* gfxCtx);
+void Graph_RebalanceDisps(void);
 void Graph_SetNextGfxPool(GraphicsContext* gfxCtx);
 GameStateOverlay* Graph_GetNextGameState(GameState* gameState);
 uintptr_t Graph_FaultAddrConv(uintptr_t address, void* param);
@@ -1385,6 +1417,17 @@ s32 func_80193C5C(void);
 s32 AudioThread_ResetAudioHeap(s32 specId);
 void AudioThread_PreNMIInternal(void);
 s32 AudioThread_GetEnabledNotesCount(void);
+SampleDmaCacheStats* AudioThread_GetSampleDmaCacheStats(void);
+AudioCacheStats* AudioThread_GetAudioCacheStats(s32 tableType);
+AudioCmdQueueStats* AudioThread_GetCmdQueueStats(void);
+s32 AudioThread_GetCmdQueueFreeSpace(void);
+AudioPcmCacheStats* AudioThread_GetPcmCacheStats(void);
+void AudioThread_SetPcmCacheEnabled(s32 isEnabled);
+void AudioThread_BeginProfileStage(s32 stage);
+void AudioThread_EndProfileStage(void);
+void AudioThread_AddProfileDmaBytes(size_t size);
+AudioFrameProfile* AudioThread_GetFrameProfile(s32 framesAgo);
+s32 AudioThread_WriteFrameProfileCsv(char* buf, s32 bufSize);
 u32 AudioThread_NextRandom(void);
 void AudioThread_InitMesgQueues(void);
 
@@ -1405,6 +1448,10 @@ void AudioPlayback_InitNoteLists(NotePool* pool);
 void AudioPlayback_InitNoteFreeList(void);
 void AudioPlayback_NotePoolClear(NotePool* pool);
 void AudioPlayback_NotePoolFill(NotePool* pool, s32 count);
+void AudioPlayback_InitNoteListIndex(void);
+void AudioPlayback_NoteListIndexAdd(AudioListItem* list, AudioListItem* item);
+void AudioPlayback_NoteListIndexRemove(AudioListItem* item);
+void AudioPlayback_SetNotePriority(Note* note, s32 priority);
 void AudioPlayback_AudioListRemove(AudioListItem* item);
 Note* AudioPlayback_AllocNote(SequenceLayer* layer);
 void AudioPlayback_NoteInitAll(void);
@@ -1419,6 +1466,10 @@ void AudioScript_SkipForwardSequence(SequencePlayer* seqPlayer);
 void AudioScript_ResetSequencePlayer(SequencePlayer* seqPlayer);
 void AudioScript_InitSequencePlayerChannels(s32 seqPlayerIndex);
 void AudioScript_InitSequencePlayers(void);
+void AudioScript_FlushSeqPlayerDecodedInstrs(SequencePlayer* seqPlayer);
+void AudioScript_FlushDecodedInstrs(void);
+void AudioScript_InvalidateDecodedInstrs(u8* addr, s32 size);
+SeqDecodeCacheStats* AudioScript_GetDecodeCacheStats(void);
 
 void func_8019AE40(s32 param_1, s32 param_2, u32 param_3, s32 param_4);
 void func_8019AEC0(UNK_PTR param_1, UNK_PTR param_2);
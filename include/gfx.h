@@ -107,14 +107,46 @@ typedef struct {
 typedef struct GfxPool {
     /* 0x00000 */ u16 headMagic; // GFXPOOL_HEAD_MAGIC
     /* 0x00008 */ GfxMasterList master;
-    /* 0x00308 */ Gfx polyXluBuffer[0x800];
-    /* 0x04308 */ Gfx overlayBuffer[0x400];
-    /* 0x06308 */ Gfx workBuffer[0x40];
-    /* 0x06508 */ Gfx debugBuffer[0x40];
-    /* 0x06708 */ Gfx polyOpaBuffer[0x3380];
+    /* 0x00308 */ Gfx workBuffer[0x40];
+    /* 0x00508 */ Gfx debugBuffer[0x40];
+    /* 0x00708 */ union {
+                    struct {
+                        /* 0x00708 */ Gfx polyXluBuffer[0x800];
+                        /* 0x04708 */ Gfx overlayBuffer[0x400];
+                        /* 0x06708 */ Gfx polyOpaBuffer[0x3380];
+                    };
+                    /* 0x00708 */ Gfx dispBuffer[0x800 + 0x400 + 0x3380]; // Split differently when rebalanced
+                };
     /* 0x20308 */ u16 tailMagic; // GFXPOOL_TAIL_MAGIC
 } GfxPool; // size = 0x20310
 
+typedef enum GraphDisp {
+    /* 0 */ GRAPH_DISP_OPA,
+    /* 1 */ GRAPH_DISP_XLU,
+    /* 2 */ GRAPH_DISP_OVERLAY,
+    /* 3 */ GRAPH_DISP_WORK,
+    /* 4 */ GRAPH_DISP_DEBUG,
+    /* 5 */ GRAPH_DISP_MAX
+} GraphDisp;
+
+#define GRAPH_DISP_USAGE_COUNT 32
+
+typedef struct GraphDispUsage {
+    /* 0x00 */ u32 used[GRAPH_DISP_MAX]; // Bytes allocated from both ends of each arena, over its size if it overflowed
+    /* 0x14 */ u32 size[GRAPH_DISP_MAX];
+    /* 0x28 */ u32 frame; // Frames recorded before this one
+    /* 0x2C */ u8 poolIdx;
+    /* 0x2D */ u8 warnMask; // Bits of the arenas that were close to full
+    /* 0x2E */ u8 crashMask; // Bits of the arenas that overflowed, the frame was then dropped
+} GraphDispUsage; // size = 0x30
+
+typedef struct GraphDispStats {
+    /* 0x00 */ u32 highWater[2][GRAPH_DISP_MAX]; // Most bytes used by each arena, for each of `gGfxPools`
+    /* 0x28 */ u32 warnings; // Times an arena became close to full
+    /* 0x2C */ u32 droppedFrames;
+    /* 0x30 */ u32 rebalances;
+} GraphDispStats; // size = 0x34
+
 typedef struct GraphicsContext {
     /* 0x000 */ Gfx* polyOpaBuffer; // Pointer to "Zelda 0"
     /* 0x004 */ Gfx* polyXluBuffer; // Pointer to "Zelda 1"
@@ -156,6 +188,10 @@ typedef struct GraphicsContext {
 Gfx* Gfx_SetFog(Gfx* gfx, s32 r, s32 g, s32 b, s32 a, s32 n, s32 f);
 Gfx* Gfx_SetFogWithSync(Gfx* gfx, s32 r, s32 g, s32 b, s32 a, s32 n, s32 f);
 Gfx* Gfx_SetFog2(Gfx* gfx, s32 r, s32 g, s32 b, s32 a, s32 n, s32 f);
+void Gfx_ResetSetupDLCache(void);
+s32 Gfx_KeepsSetupDLState(Gfx* start, Gfx* end);
+void Gfx_AppendSetupDL(Gfx** gfxp, s32 disp, u32 i);
+u32 Gfx_GetSetupDLSavedCmds(void);
 Gfx* Gfx_SetupDLImpl(Gfx* gfx, u32 i);
 Gfx* Gfx_SetupDL(Gfx* gfx, u32 i);
 void Gfx_SetupDLAtPtr(Gfx** gfxp, u32 i);
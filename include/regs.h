@@ -74,6 +74,11 @@ extern RegEditor* gRegEditor;
 #define R_VI_MODE_EDIT_LRY_ADJ            SREG(52)
 #define R_VI_MODE_EDIT_ULX_ADJ            SREG(53)
 #define R_VI_MODE_EDIT_LRX_ADJ            SREG(54)
+#define R_PRERENDER_FILTER_BUDGET         SREG(70) // Microseconds per frame for pause background filters, 0 = thread
+#define R_PRERENDER_FILTER_PROGRESS       SREG(71) // Percentage of rows filtered within R_PRERENDER_FILTER_BUDGET
+#define R_PRERENDER_FILTER_TIME           SREG(72) // Microseconds spent filtering in the last frame
+#define R_BGCHECK_STATS                   SREG(73) // Count static line tests and their time in gStaticLookupStats
+#define R_BGCHECK_STATIC_BVH              SREG(74) // Line test BVH at scene load, 0 = sSceneBvhList, 1 = all, -1 = none
 #define R_FB_FILTER_TYPE                  SREG(80)
 #define R_FB_FILTER_PRIM_COLOR(c)         SREG(81 + c)
 #define R_FB_FILTER_A                     SREG(84)
@@ -696,6 +696,73 @@ typedef struct BlinkInfo {
     /* 0x2 */ s16 blinkTimer;
 } BlinkInfo; // size = 0x4
 
+#define ACTOR_GRID_CELL_SHIFT 8 // grid cells are 256 units wide along x and z
+#define ACTOR_GRID_BUCKET_COUNT 64
+#define ACTOR_GRID_ACTOR_BUCKET_COUNT 64 // buckets of the actor pointer hash used to find an actor's entry
+#define ACTOR_GRID_ENTRY_MAX 256
+#define ACTOR_GRID_ENTRY_NONE 0xFFFF
+// Actors may move this far between the grid being built and a query, queries are widened by it
+#define ACTOR_GRID_MOVE_MARGIN 160.0f
+
+typedef struct ActorGridEntry {
+    /* 0x0 */ Actor* actor;  // NULL if the entry is free
+    /* 0x4 */ u16 order;     // Position in the category's actor list. Spawned actors are appended so this stays ordered
+    /* 0x6 */ u16 next;      // Next entry in the same bucket, or in the free list
+    /* 0x8 */ u16 bucket;    // Index into the flattened `ActorGrid.heads` of the bucket the entry was added to
+    /* 0xA */ u16 actorNext; // Next entry in the same `ActorGrid.actorHeads` bucket
+} ActorGridEntry; // size = 0xC
+
+typedef struct ActorGrid {
+    /* 0x0000 */ u16 heads[ACTORCAT_MAX][ACTOR_GRID_BUCKET_COUNT];
+    /* 0x0600 */ ActorGridEntry entries[ACTOR_GRID_ENTRY_MAX];
+    /* 0x1200 */ u16 actorHeads[ACTOR_GRID_ACTOR_BUCKET_COUNT]; // entries hashed by actor pointer, for removal
+    /* 0x1280 */ u16 nextOrder[ACTORCAT_MAX];
+    /* 0x1298 */ u16 freeHead;
+    /* 0x129A */ u8 isBuilt;
+} ActorGrid; // size = 0x129C
+
+#define ACTOR_HOT_TABLE_MAX 256
+
+/**
+ * Structure-of-arrays copy of the actor fields read by the per-frame projection and culling pass of
+ * `Actor_DrawAll`, so that pass runs over contiguous memory instead of following `Actor.next` through the heap.
+ * Entries are in actor list order and are only valid for the frame they were synced in.
+ */
+typedef struct ActorHotTable {
+    /* 0x0000 */ Actor* actors[ACTOR_HOT_TABLE_MAX];
+    /* 0x0400 */ f32 posX[ACTOR_HOT_TABLE_MAX];
+    /* 0x0800 */ f32 posY[ACTOR_HOT_TABLE_MAX];
+    /* 0x0C00 */ f32 posZ[ACTOR_HOT_TABLE_MAX];
+    /* 0x1000 */ f32 uncullZoneForward[ACTOR_HOT_TABLE_MAX];
+    /* 0x1400 */ f32 uncullZoneScale[ACTOR_HOT_TABLE_MAX];
+    /* 0x1800 */ f32 uncullZoneDownward[ACTOR_HOT_TABLE_MAX];
+    /* 0x1C00 */ f32 projectedX[ACTOR_HOT_TABLE_MAX];
+    /* 0x2000 */ f32 projectedY[ACTOR_HOT_TABLE_MAX];
+    /* 0x2400 */ f32 projectedZ[ACTOR_HOT_TABLE_MAX];
+    /* 0x2800 */ f32 projectedW[ACTOR_HOT_TABLE_MAX];
+    /* 0x2C00 */ u8 isInView[ACTOR_HOT_TABLE_MAX];
+    /* 0x2D00 */ s32 count;
+} ActorHotTable; // size = 0x2D04
+
+#define ACTOR_DRAW_SORT_MAX 256
+// Commands at the start of a packet searched for the first render-mode preset, see `ActorDrawSort_GetSetupDL`
+#define ACTOR_DRAW_SORT_SCAN_MAX 32
+#define ACTOR_DRAW_SORT_SETUPDL_NONE 0xFF
+
+/**
+ * Opaque commands of the actors drawn by `Actor_DrawAll`, recorded as separate display lists so they can be called in
+ * order of object and render-mode preset instead of actor list order. Only valid for the frame they were recorded in.
+ */
+typedef struct ActorDrawSort {
+    /* 0x000 */ Gfx* packets[ACTOR_DRAW_SORT_MAX]; // Start of each actor's opaque commands, ended by gSPEndDisplayList
+    /* 0x400 */ f32 keys[ACTOR_DRAW_SORT_MAX]; // Object bank index and preset, as f32 for `CullBatch_SortByDepth`
+    /* 0x800 */ u16 order[ACTOR_DRAW_SORT_MAX];
+    /* 0xA00 */ Gfx* head; // Reserved before the first packet, branches over the packets to the sorted calls
+    /* 0xA04 */ s32 count;
+    /* 0xA08 */ u16 stateChanges[2]; // Object or preset changes between consecutive packets, in list then sorted order
+    /* 0xA0C */ u8 isEnabled;
+} ActorDrawSort; // size = 0xA10
+
 extern TargetRangeParams gTargetRanges[TARGET_MODE_MAX];
 extern s16 D_801AED48[8];
 extern Gfx D_801AEF88[];
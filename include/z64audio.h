@@ -211,6 +211,33 @@ typedef struct {
     /* 0x19 */ s8 value;
 } SeqScriptState; // size = 0x1C
 
+#define SEQ_DECODE_CACHE_BITS 8
+#define SEQ_DECODE_CACHE_SIZE (1 << SEQ_DECODE_CACHE_BITS) // per sequence player
+#define SEQ_DECODE_CACHE_FILL_MAX (SEQ_DECODE_CACHE_SIZE * 3 / 4) // a player's cache is flushed past this many entries
+#define SEQ_DECODE_MAX_LENGTH 5 // command byte and up to 4 bytes of args
+
+typedef enum {
+    /* 0 */ SEQ_DECODE_KIND_NONE,
+    /* 1 */ SEQ_DECODE_KIND_CHANNEL,
+    /* 2 */ SEQ_DECODE_KIND_LAYER_SMALL_NOTES, // Layer of a channel without `largeNotes`
+    /* 3 */ SEQ_DECODE_KIND_LAYER_LARGE_NOTES
+} SeqDecodeKind;
+
+typedef struct {
+    /* 0x0 */ u8* pc; // address of the command byte
+    /* 0x4 */ u8 cmd;
+    /* 0x5 */ u8 kind; // SeqDecodeKind, as the same bytes decode differently per interpreter
+    /* 0x6 */ u8 length; // command byte and args
+    /* 0x8 */ s16 args[3];
+} SeqDecodedInstr; // size = 0x10
+
+typedef struct {
+    /* 0x0 */ u32 hits;
+    /* 0x4 */ u32 misses;
+    /* 0x8 */ u32 invalidations; // Entries dropped because the script wrote over their bytes
+    /* 0xC */ u32 flushes;       // Caches of a sequence player emptied because they reached SEQ_DECODE_CACHE_FILL_MAX
+} SeqDecodeCacheStats; // size = 0x10
+
 // Also known as a Group, according to debug strings.
 typedef struct SequencePlayer {
     /* 0x000 */ u8 enabled : 1;
@@ -600,6 +627,38 @@ typedef struct {
     };
 } AudioCmd; // size = 0x8
 
+typedef struct {
+    /* 0x00 */ u32 queued;
+    /* 0x04 */ u32 coalesced; // Commands merged into an unpublished command for the same channel and field
+    /* 0x08 */ u32 dropped; // Commands lost because the audio thread had not processed enough of the buffer
+    /* 0x0C */ u32 publishFailures; // Batches left for the next publish because the message queue was full
+    /* 0x10 */ u32 maxPending; // Most commands queued but not yet processed
+} AudioCmdQueueStats; // size = 0x14
+
+#define AUDIO_PROFILE_FRAME_COUNT 32
+#define AUDIO_PROFILE_MAX_DEPTH 4
+#define AUDIO_PROFILE_CSV_LINE_MAX 128
+
+typedef enum {
+    /* 0 */ AUDIO_PROFILE_STAGE_DMA_WAIT, // Blocked on sample DMAs of the previous frame and on synchronous loads
+    /* 1 */ AUDIO_PROFILE_STAGE_LOADS, // `AudioLoad_ProcessLoads` and `AudioLoad_ProcessScriptLoads`
+    /* 2 */ AUDIO_PROFILE_STAGE_CMDS, // Commands sent by the game thread
+    /* 3 */ AUDIO_PROFILE_STAGE_SEQUENCES, // `AudioScript_ProcessSequences`
+    /* 4 */ AUDIO_PROFILE_STAGE_NOTES, // `AudioPlayback_ProcessNotes`
+    /* 5 */ AUDIO_PROFILE_STAGE_SYNTH, // `AudioSynth_Update`
+    /* 6 */ AUDIO_PROFILE_STAGE_MAX
+} AudioProfileStage;
+
+typedef struct {
+    /* 0x00 */ u32 frame; // `totalTaskCount` of the frame
+    /* 0x04 */ u32 totalTime; // Whole of `AudioThread_Update`, in `osGetTime` ticks
+    /* 0x08 */ u32 stageTimes[AUDIO_PROFILE_STAGE_MAX]; // Time spent in each stage, not counting the stages it calls
+    /* 0x20 */ u32 dmaBytes; // Bytes requested from the cartridge, including sample DMAs for the next frame
+    /* 0x24 */ u16 numAbiCmds;
+    /* 0x26 */ u8 numActiveNotes;
+    /* 0x27 */ u8 numSampledNotes; // Active notes playing samples that are DMA'd from the cartridge
+} AudioFrameProfile; // size = 0x28
+
 typedef struct {
     /* 0x00 */ OSTask task;
     /* 0x40 */ OSMesgQueue* taskQueue;
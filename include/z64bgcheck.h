@@ -24,6 +24,8 @@ struct DynaPolyActor;
 #define BGCHECK_XYZ_ABSMAX 32760.0f
 #define BGCHECK_SUBDIV_OVERLAP 50
 #define BGCHECK_SUBDIV_MIN 150.0f
+#define BGCHECK_BVH_LEAF_MAX 8    // maximum number of polys stored in a StaticBvh leaf node
+#define BGCHECK_BVH_STACK_MAX 64  // traversal stack depth, scenes with a deeper tree use the lookup table instead
 
 #define WATERBOX_ROOM(p) ((((s32)p) >> 13) & 0x3F)
 
@@ -296,6 +298,28 @@ typedef struct {
     /* 0x4 */ SSList ceiling;
 } StaticLookup; // size = 0x6
 
+typedef struct {
+    /* 0x0 */ Vec3s min;
+    /* 0x6 */ Vec3s max;
+    /* 0xC */ u16 index; // leaf: first entry of StaticBvh.polyIds, internal: node index of the second child
+    /* 0xE */ u16 count; // leaf: number of polys, internal: 0. The first child always directly follows its parent
+} StaticBvhNode; // size = 0x10
+
+typedef struct {
+    /* 0x00 */ OSTime gridBuildTime; // time spent in BgCheck_InitStaticLookup
+    /* 0x08 */ OSTime bvhBuildTime;  // time spent in BgCheck_InitStaticBvh
+    /* 0x10 */ OSTime lineTestTime;  // accumulated line test time against static collision
+    /* 0x18 */ u32 lineTestCount;   // this and the following counters, like the time, are only kept if R_BGCHECK_STATS
+    /* 0x1C */ u32 cellsVisited; // lookup table cells (grid) or nodes (bvh) visited by line tests
+    /* 0x20 */ u32 polysTested;  // polys tested by line tests, including duplicates skipped by the polyCheckTbl
+} StaticLookupStats; // size = 0x28
+
+typedef struct {
+    /* 0x0 */ StaticBvhNode* nodes; // flat tree, nodes[0] is the root. NULL if the scene uses the lookup table only
+    /* 0x4 */ s16* polyIds;         // static poly ids, grouped by leaf
+    /* 0x8 */ s32 nodeCount;
+} StaticBvh; // size = 0xC
+
 typedef struct {
     /* 0x0 */ s16 polyStartIndex;
     /* 0x2 */ SSList ceiling;
@@ -459,6 +483,8 @@ void BgCheck_GetSubdivisionMaxBounds(CollisionContext* colCtx, Vec3f* pos, s32*
 void BgCheck_GetPolySubdivisionBounds(CollisionContext* colCtx, Vec3s* vtxList, CollisionPoly* polyList, s32* subdivMinX, s32* subdivMinY, s32* subdivMinZ, s32* subdivMaxX, s32* subdivMaxY, s32* subdivMaxZ, s16 polyId);
 s32 BgCheck_PolyIntersectsSubdivision(Vec3f* min, Vec3f* max, CollisionPoly* polyList, Vec3s* vtxList, s16 polyId);
 u32 BgCheck_InitStaticLookup(CollisionContext* colCtx, struct PlayState* play, StaticLookup* lookupTbl);
+s32 BgCheck_UseStaticBvh(struct PlayState* play);
+u32 BgCheck_InitStaticBvh(CollisionContext* colCtx, struct PlayState* play);
 s32 BgCheck_IsSmallMemScene(struct PlayState* play);
 s32 BgCheck_TryGetCustomMemsize(s32 sceneId, u32* memSize);
 void BgCheck_SetSubdivisionDimension(f32 min, s32 subdivAmount, f32* max, f32* subdivLength, f32* subdivLengthInv);
@@ -592,4 +618,6 @@ s32 func_800CA6F0(struct PlayState* play, CollisionContext* colCtx, f32 x, f32 z
 s32 func_800CA9D0(struct PlayState* play, CollisionContext* colCtx, f32 x, f32 z, f32* ySurface, WaterBox** outWaterBox);
 s32 func_800CAA14(CollisionPoly* polyA, CollisionPoly* polyB, Vec3f* pointA, Vec3f* pointB, Vec3f* closestPoint);
 
+extern StaticLookupStats gStaticLookupStats;
+
 #endif
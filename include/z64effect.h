@@ -282,6 +282,29 @@ typedef struct {
     /* 0x8 */ s32 size;
 } EffectSsInfo; // size = 0xC
 
+#define EFFECT_SS_BUCKET_COUNT 16
+#define EFFECT_SS_KEY_FREE 0xFFFF
+
+/**
+ * Bitmask index over `EffectSsInfo.data_table`, kept in sync with each entry's life, priority and flags.
+ * Occupied entries are bucketed by their eviction key, `(priority << 1) | !(flags & 1)`, so that an entry can be
+ * evicted by a spawn of priority p exactly when its key is at least `(p << 1) | 1`
+ */
+typedef struct {
+    /* 0x00 */ u32* freeMask; // Entries with life == -1
+    /* 0x04 */ u32* bucketMasks; // [EFFECT_SS_BUCKET_COUNT][maskWords], occupied entries by eviction key >> 5
+    /* 0x08 */ u32* candidateMask; // Scratch mask for eviction searches
+    /* 0x0C */ u16* keys; // Eviction key of each entry when last synced, or EFFECT_SS_KEY_FREE
+    /* 0x10 */ s32 maskWords;
+} EffectSsSlots; // size = 0x14
+
+typedef struct {
+    /* 0x00 */ u32 spawnCount;
+    /* 0x04 */ u32 evictCount; // Spawns and copies that replaced a lower priority entry
+    /* 0x08 */ u32 failCount; // Spawns dropped because no entry could be replaced
+    /* 0x0C */ u32 wordsScanned; // Mask words read while searching for an entry
+} EffectSsStats; // size = 0x10
+
 #define DEFINE_EFFECT_SS(_name, enumValue) enumValue,
 #define DEFINE_EFFECT_SS_UNSET(enumValue) enumValue,
 
@@ -293,4 +316,6 @@ typedef enum EffectSsType {
 #undef DEFINE_EFFECT_SS
 #undef DEFINE_EFFECT_SS_UNSET
 
+extern EffectSsStats gEffectSsStats;
+
 #endif
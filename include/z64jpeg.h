@@ -9,12 +9,21 @@ typedef struct {
     /* 0x00 */ u16 table[8*8];
 } JpegQuantizationTable; // size = 0x80
 
+// Number of bits `JpegHuffmanLookup` decodes at once, codes longer than this use the per-length search
+#define JPEG_HUFFMAN_LOOKAHEAD_BITS 8
+
+typedef struct {
+    /* 0x000 */ u8 lengths[1 << JPEG_HUFFMAN_LOOKAHEAD_BITS]; // 0 if the code is longer than the lookahead
+    /* 0x100 */ u8 symbols[1 << JPEG_HUFFMAN_LOOKAHEAD_BITS];
+} JpegHuffmanLookup; // size = 0x200
+
 typedef struct {
     /* 0x00 */ u8 codeOffs[16];
     /* 0x10 */ u16 codesA[16];
     /* 0x30 */ u16 codesB[16];
     /* 0x50 */ u8* symbols;
-} JpegHuffmanTable; // size = 0x54
+    /* 0x54 */ JpegHuffmanLookup* lookup; // optional
+} JpegHuffmanTable; // size = 0x58
 
 // this struct might be inaccurate but it's not used outside jpegutils.c
 typedef struct {
@@ -80,6 +89,10 @@ void Jpeg_ScheduleDecoderTask(JpegContext* jpegCtx);
 void Jpeg_CopyToZbuffer(u16* src, u16* zbuffer, s32 x, s32 y);
 u16 Jpeg_GetUnalignedU16(u8* ptr);
 void Jpeg_ParseMarkers(u8* ptr, JpegContext* jpegCtx);
+void Jpeg_SetDecodeOnCpu(s32 onCpu);
+void Jpeg_InverseDctBlock(u16* coeffs, JpegQuantizationTable* qTable, u8* out, s32 outStride);
+void Jpeg_DecodeMcuOnCpu(u16* mcu, JpegWork* workBuf);
+void Jpeg_DecodeOnCpu(JpegContext* jpegCtx);
 s32 Jpeg_Decode(void* data, void* zbuffer, void* work, u32 workSize);
 
 void JpegUtils_ProcessQuantizationTable(u8* dqt, JpegQuantizationTable* qt, u8 count);
@@ -88,6 +101,7 @@ s32 JpegUtils_GetHuffmanCodes(u8* codesLengths, u16* codes);
 s32 JpegUtils_SetHuffmanTable(u8* data, JpegHuffmanTable* ht, u16* codes);
 u32 JpegUtils_ProcessHuffmanTableImpl(u8* data, JpegHuffmanTable* ht, u8* codesLengths, u16* codes, u8 isAc);
 u32 JpegUtils_ProcessHuffmanTable(u8* dht, JpegHuffmanTable* ht, u8* codesLengths, u16* codes, u8 count);
+void JpegUtils_SetHuffmanLookup(JpegHuffmanTable* ht, JpegHuffmanLookup* lookup);
 void JpegUtils_SetHuffmanTableOld(u8* data, JpegHuffmanTableOld* ht, u8* codesLengths, u16* codes, s16 count, u8 isAc);
 u32 JpegUtils_ProcessHuffmanTableImplOld(u8* dht, JpegHuffmanTableOld* ht, u8* codesLengths, u16* codes);
 
@@ -75,6 +75,22 @@ typedef struct LightsBuffer {
     /* 0x008 */ LightNode lights[LIGHTS_BUFFER_SIZE];
 } LightsBuffer; // size = 0x188
 
+#define LIGHT_GRID_BUCKET_COUNT 64
+#define LIGHT_GRID_CELL_SHIFT 8
+// Lights may move this far between the grid being built and binding, their reach is widened by it
+#define LIGHT_GRID_MOVE_MARGIN 40.0f
+
+typedef struct LightGrid {
+    /* 0x000 */ LightNode* nodes[LIGHTS_BUFFER_SIZE]; // Light list in order, as it was when the grid was built
+    /* 0x080 */ u32 bucketMasks[LIGHT_GRID_BUCKET_COUNT]; // Bit n is set if `nodes[n]` may reach a cell of the bucket
+    /* 0x180 */ u32 globalMask; // Directional lights, and point lights reaching too many cells to bucket
+    /* 0x184 */ s32 count;
+    /* 0x188 */ Lights* prevLights; // Last group returned by `LightContext_NewBoundLights`
+    /* 0x18C */ u16 numGroups; // Groups returned by `LightContext_NewBoundLights` since the grid was built
+    /* 0x18E */ u16 numReused; // How many of them were `prevLights` returned again
+    /* 0x190 */ u8 isBuilt;
+} LightGrid; // size = 0x194
+
 typedef struct LightContext {
     /* 0x0 */ LightNode* listHead;
     /* 0x4 */ Color_RGB8 ambient;
@@ -42,6 +42,13 @@ typedef struct PreRender {
     /* 0x4D */ u8 filterState; // See `PrerenderFilterState`
 } PreRender; // size = 0x50
 
+typedef struct PreRenderDivotState {
+    /* 0x00 */ u8* redRow[3];
+    /* 0x0C */ u8* greenRow[3];
+    /* 0x18 */ u8* blueRow[3];
+    /* 0x24 */ u8* cvgFull;
+} PreRenderDivotState; // size = 0x28
+
 
 void PreRender_SetValuesSave(PreRender* this, u32 width, u32 height, void* fbuf, void* zbuf, void* cvg);
 void PreRender_Init(PreRender* this);
@@ -61,11 +68,21 @@ void func_80170798(PreRender* this, Gfx** gfxp);
 void func_80170AE0(PreRender* this, Gfx** gfxp, s32 alpha);
 void PreRender_RestoreFramebuffer(PreRender* this, Gfx** gfxp);
 void PreRender_AntiAliasFilterPixel(PreRender* this, s32 x, s32 y);
+void PreRender_AntiAliasFilterInnerPixel(PreRender* this, s32 x, s32 y, s32* neighborOffsets);
+void PreRender_AntiAliasFilterRow(PreRender* this, s32 y);
 void PreRender_AntiAliasFilter(PreRender* this);
+u32 PreRender_Median3(u32 a, u32 b, u32 c);
+void PreRender_Sort5bColumn(u8** rows, s32 x, u8* sorted);
+u32 PreRender_Get5bMedian9Sorted(u8* sorted0, u8* sorted1, u8* sorted2);
 u32 PreRender_Get5bMedian9(u8* px1, u8* px2, u8* px3);
+void PreRender_DivotFilterInit(PreRender* this, PreRenderDivotState* state, u8* buffer);
+void PreRender_DivotFilterRow(PreRender* this, PreRenderDivotState* state, u32 y);
 void PreRender_DivotFilter(PreRender* this);
 void PreRender_ApplyFilters(PreRender* this);
+void PreRender_ApplyFiltersBudgetedDestroy(PreRender* this);
+void PreRender_ApplyFiltersBudgeted(PreRender* this, s32 budgetUs);
 void PreRender_ApplyFiltersSlowlyInit(PreRender* this);
+void PreRender_ApplyFiltersSlowlyUpdate(PreRender* this);
 void PreRender_ApplyFiltersSlowlyDestroy(PreRender* this);
 void func_801720C4(PreRender* this);
 void Prerender_DrawBackground2D(Gfx** gfxp, void* timg, void* tlut, u16 width, u16 height, u8 fmt, u8 siz, u16 tt, u16 tlutCount, f32 x, f32 y, f32 xScale, f32 yScale, u32 flags);
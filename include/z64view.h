@@ -65,6 +65,9 @@ typedef struct View {
     }                                      \
     (void)0
 
+// Maximum number of spheres handled by one `CullBatch_Project` or `CullBatch_SortByDepth` call
+#define CULL_BATCH_MAX 256
+
 void View_Init(View* view, struct GraphicsContext* gfxCtx);
 void View_LookAt(View* view, Vec3f* eye, Vec3f* at, Vec3f* up);
 void View_SetScale(View* view, f32 scale);
@@ -12,9 +12,21 @@ void AudioHeap_DiscardSampleBank(s32 sampleBankId);
 void AudioHeap_ApplySampleBankCacheInternal(s32 apply, s32 sampleBankId);
 void AudioHeap_DiscardSampleBanks(void);
 void AudioHeap_InitReverb(s32 reverbIndex, ReverbSettings* settings, s32 isFirstInit);
+void AudioHeap_RecordCacheEviction(s32 tableType, s32 id);
+void AudioHeap_InitPcmCache(void);
+void AudioHeap_ShareReverbFilters(SynthesisReverb* reverb);
 
 #define gTatumsPerBeat (gAudioTatumInit[1])
 
+// Entry index + 1 of the first entry holding each id, per table type, or 0 if none does
+u8 sPersistentCacheIndex[3][AUDIO_CACHE_ID_MAX];
+u8 sPermanentCacheIndex[3][AUDIO_CACHE_ID_MAX];
+// Ids evicted from the persistent or temporary caches since they were last loaded, per table type
+u32 sEvictedCacheIds[3][AUDIO_CACHE_ID_MAX / 32];
+AudioCacheStats gAudioCacheStats[3];
+AudioPcmCache gAudioPcmCache;
+AudioPcmCacheStats gAudioPcmCacheStats;
+
 /**
  * Effectively scales `updatesPerFrameInv` by the reciprocal of `scaleInv`
  * `updatesPerFrameInvScaled` is just `updatesPerFrameInv` scaled down by a factor of 256.0f
@@ -101,7 +113,7 @@ void AudioHeap_ReleaseNotesForFont(s32 fontId) {
 
         if (playbackState->fontId == fontId) {
             if (playbackState->priority != 0) {
-                playbackState->priority = 1;
+                AudioPlayback_SetNotePriority(note, 1);
                 playbackState->adsr.fadeOutVel = gAudioCtx.audioBufferParameters.updatesPerFrameInv;
                 playbackState->adsr.action.s.release = true;
             }
@@ -275,6 +287,7 @@ void AudioHeap_PopPersistentCache(s32 tableType) {
     AudioPersistentCache* persistent;
     void* entryAddr;
     u8* loadStatus;
+    s32 id;
 
     switch (tableType) {
         case SEQUENCE_TABLE:
@@ -312,9 +325,42 @@ void AudioHeap_PopPersistentCache(s32 tableType) {
     }
 
     loadStatus[persistent->entries[persistent->numEntries - 1].id] = LOAD_STATUS_NOT_LOADED;
+
+    id = persistent->entries[persistent->numEntries - 1].id;
+    AudioHeap_RecordCacheEviction(tableType, id);
+    // The index holds the first entry with each id, so an earlier entry with the same id is never dropped here
+    if (((u32)id < AUDIO_CACHE_ID_MAX) && (sPersistentCacheIndex[tableType][id] == persistent->numEntries)) {
+        sPersistentCacheIndex[tableType][id] = 0;
+    }
     persistent->numEntries--;
 }
 
+/**
+ * Called after `id` is loaded into a new cache entry of `size` bytes
+ */
+void AudioHeap_RecordCacheLoad(s32 tableType, s32 id, size_t size) {
+    AudioCacheStats* stats = &gAudioCacheStats[tableType];
+
+    stats->bytesLoaded += size;
+    if (((u32)id < AUDIO_CACHE_ID_MAX) && (sEvictedCacheIds[tableType][id >> 5] & (1 << (id & 0x1F)))) {
+        sEvictedCacheIds[tableType][id >> 5] &= ~(1 << (id & 0x1F));
+        stats->bytesReloaded += size;
+    }
+}
+
+/**
+ * Called when the cache entry holding `id` is discarded to make room for another
+ */
+void AudioHeap_RecordCacheEviction(s32 tableType, s32 id) {
+    if (tableType == SAMPLE_TABLE) {
+        gAudioPcmCache.ramGeneration++;
+    }
+    gAudioCacheStats[tableType].evictions++;
+    if ((u32)id < AUDIO_CACHE_ID_MAX) {
+        sEvictedCacheIds[tableType][id >> 5] |= 1 << (id & 0x1F);
+    }
+}
+
 void AudioHeap_InitMainPool(size_t initPoolSize) {
     AudioHeap_InitPool(&gAudioCtx.initPool, gAudioCtx.audioHeap, initPoolSize);
     AudioHeap_InitPool(&gAudioCtx.sessionPool, gAudioCtx.audioHeap + initPoolSize,
@@ -357,6 +403,7 @@ void AudioHeap_InitPersistentPoolsAndCaches(AudioCommonPoolSplit* split) {
     AudioHeap_InitPersistentCache(&gAudioCtx.seqCache.persistent);
     AudioHeap_InitPersistentCache(&gAudioCtx.fontCache.persistent);
     AudioHeap_InitPersistentCache(&gAudioCtx.sampleBankCache.persistent);
+    bzero(sPersistentCacheIndex, sizeof(sPersistentCacheIndex));
 }
 
 void AudioHeap_InitTemporaryPoolsAndCaches(AudioCommonPoolSplit* split) {
@@ -544,6 +591,7 @@ void* AudioHeap_AllocCached(s32 tableType, size_t size, s32 cache, s32 id) {
         side = temporaryCache->nextSide;
 
         if (temporaryCache->entries[side].id != -1) {
+            AudioHeap_RecordCacheEviction(tableType, temporaryCache->entries[side].id);
             if (tableType == SAMPLE_TABLE) {
                 AudioHeap_DiscardSampleBank(temporaryCache->entries[side].id);
             }
@@ -564,6 +612,7 @@ void* AudioHeap_AllocCached(s32 tableType, size_t size, s32 cache, s32 id) {
 
                 if ((temporaryCache->entries[1].id != -1) &&
                     (temporaryCache->entries[1].addr < temporaryPool->curAddr)) {
+                    AudioHeap_RecordCacheEviction(tableType, temporaryCache->entries[1].id);
                     if (tableType == SAMPLE_TABLE) {
                         AudioHeap_DiscardSampleBank(temporaryCache->entries[1].id);
                     }
@@ -594,6 +643,7 @@ void* AudioHeap_AllocCached(s32 tableType, size_t size, s32 cache, s32 id) {
                 temporaryCache->entries[1].size = size;
                 if ((temporaryCache->entries[0].id != -1) &&
                     (temporaryCache->entries[1].addr < temporaryPool->curAddr)) {
+                    AudioHeap_RecordCacheEviction(tableType, temporaryCache->entries[0].id);
                     if (tableType == SAMPLE_TABLE) {
                         AudioHeap_DiscardSampleBank(temporaryCache->entries[0].id);
                     }
@@ -622,6 +672,8 @@ void* AudioHeap_AllocCached(s32 tableType, size_t size, s32 cache, s32 id) {
         }
 
         temporaryCache->nextSide ^= 1;
+        AudioHeap_RecordCacheLoad(tableType, id, size);
+        gAudioCacheStats[tableType].temporaryHighWater = MAX(gAudioCacheStats[tableType].temporaryHighWater, size);
         return temporaryAddr;
     }
 
@@ -642,6 +694,14 @@ void* AudioHeap_AllocCached(s32 tableType, size_t size, s32 cache, s32 id) {
     loadedCache->persistent.entries[loadedCache->persistent.numEntries].id = id;
     loadedCache->persistent.entries[loadedCache->persistent.numEntries].size = size;
 
+    if (((u32)id < AUDIO_CACHE_ID_MAX) && (sPersistentCacheIndex[tableType][id] == 0)) {
+        sPersistentCacheIndex[tableType][id] = loadedCache->persistent.numEntries + 1;
+    }
+    AudioHeap_RecordCacheLoad(tableType, id, size);
+    gAudioCacheStats[tableType].persistentHighWater =
+        MAX(gAudioCacheStats[tableType].persistentHighWater,
+            (size_t)(loadedCache->persistent.pool.curAddr - loadedCache->persistent.pool.startAddr));
+
     return loadedCache->persistent.entries[loadedCache->persistent.numEntries++].addr;
 }
 
@@ -695,9 +755,16 @@ void* AudioHeap_SearchRegularCaches(s32 tableType, s32 cache, s32 id) {
 
     persistent = &loadedCache->persistent;
 
-    for (i = 0; i < persistent->numEntries; i++) {
-        if (persistent->entries[i].id == id) {
-            return persistent->entries[i].addr;
+    if ((u32)id < AUDIO_CACHE_ID_MAX) {
+        i = sPersistentCacheIndex[tableType][id];
+        if (i != 0) {
+            return persistent->entries[i - 1].addr;
+        }
+    } else {
+        for (i = 0; i < persistent->numEntries; i++) {
+            if (persistent->entries[i].id == id) {
+                return persistent->entries[i].addr;
+            }
         }
     }
 
@@ -1069,6 +1136,7 @@ void AudioHeap_Init(void) {
     // Initialize two additional caches on the audio heap to store individual audio samples
     AudioHeap_InitSampleCaches(spec->persistentSampleCacheSize, spec->temporarySampleCacheSize);
     AudioLoad_InitSampleDmaBuffers(gAudioCtx.numNotes);
+    AudioHeap_InitPcmCache();
 
     // Initalize Loads
     gAudioCtx.preloadSampleStackTop = 0;
@@ -1086,6 +1154,11 @@ void AudioHeap_Init(void) {
 void* AudioHeap_SearchPermanentCache(s32 tableType, s32 id) {
     s32 i;
 
+    if (((u32)tableType < ARRAY_COUNT(sPermanentCacheIndex)) && ((u32)id < AUDIO_CACHE_ID_MAX)) {
+        i = sPermanentCacheIndex[tableType][id];
+        return (i != 0) ? gAudioCtx.permanentEntries[i - 1].addr : NULL;
+    }
+
     for (i = 0; i < gAudioCtx.permanentPool.count; i++) {
         if (gAudioCtx.permanentEntries[i].tableType == tableType && gAudioCtx.permanentEntries[i].id == id) {
             return gAudioCtx.permanentEntries[i].addr;
@@ -1108,6 +1181,11 @@ void* AudioHeap_AllocPermanent(s32 tableType, s32 id, size_t size) {
     gAudioCtx.permanentEntries[index].tableType = tableType;
     gAudioCtx.permanentEntries[index].id = id;
     gAudioCtx.permanentEntries[index].size = size;
+    // The permanent pool is only initialized once, so the index is never cleared
+    if (((u32)tableType < ARRAY_COUNT(sPermanentCacheIndex)) && ((u32)id < AUDIO_CACHE_ID_MAX) &&
+        (sPermanentCacheIndex[tableType][id] == 0)) {
+        sPermanentCacheIndex[tableType][id] = index + 1;
+    }
     //! @bug UB: missing return. "addr" is in v0 at this point, but doing an
     // explicit return uses an additional register.
 #ifdef AVOID_UB
@@ -1301,6 +1379,8 @@ void AudioHeap_DiscardSampleCacheEntry(SampleCacheEntry* entry) {
     s32 sampleBankId2;
     s32 fontId;
 
+    gAudioPcmCache.ramGeneration++;
+
     numFonts = gAudioCtx.soundFontTable->numEntries;
     for (fontId = 0; fontId < numFonts; fontId++) {
         sampleBankId1 = gAudioCtx.soundFontList[fontId].sampleBankId1;
@@ -1529,6 +1609,173 @@ void AudioHeap_DiscardSampleBanks(void) {
     }
 }
 
+/**
+ * Sets up the decoded sample cache with whatever the misc pool has to spare once everything else is allocated
+ */
+void AudioHeap_InitPcmCache(void) {
+    AudioPcmCache* cache = &gAudioPcmCache;
+    s32 i;
+
+    cache->pcm = NULL;
+    cache->notes = AudioHeap_AllocZeroed(&gAudioCtx.miscPool, gAudioCtx.numNotes * sizeof(AudioPcmCacheNote));
+    if ((cache->notes != NULL) &&
+        ((size_t)(gAudioCtx.miscPool.startAddr + gAudioCtx.miscPool.size - gAudioCtx.miscPool.curAddr) >=
+         AUDIO_PCM_CACHE_SIZE + AUDIO_PCM_CACHE_MISC_RESERVE)) {
+        cache->pcm = AudioHeap_AllocDmaMemory(&gAudioCtx.miscPool, AUDIO_PCM_CACHE_SIZE);
+    }
+
+    for (i = 0; i < AUDIO_PCM_CACHE_ENTRY_MAX; i++) {
+        cache->entries[i].state = AUDIO_PCM_CACHE_STATE_NONE;
+    }
+    for (i = 0; i < AUDIO_PCM_CACHE_CANDIDATE_COUNT; i++) {
+        cache->candidates[i] = NULL;
+    }
+    gAudioPcmCacheStats.bytesCached = 0;
+}
+
+/**
+ * Finds the entry holding `sample`. Entries are matched on where the sample is read from, which never changes for
+ * samples on cart or disk. Samples in ram can be discarded and their memory reused, so every discard invalidates
+ * their entries
+ */
+AudioPcmCacheEntry* AudioHeap_SearchPcmCache(Sample* sample) {
+    AudioPcmCacheEntry* entry;
+    s32 i;
+
+    for (i = 0; i < AUDIO_PCM_CACHE_ENTRY_MAX; i++) {
+        entry = &gAudioPcmCache.entries[i];
+        if ((entry->state != AUDIO_PCM_CACHE_STATE_NONE) && (entry->sampleAddr == sample->sampleAddr) &&
+            (entry->sampleSize == sample->size) && (entry->codec == sample->codec) &&
+            (!entry->isRam || (entry->ramGeneration == gAudioPcmCache.ramGeneration))) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * returns the offset of `size` free bytes in the cache, or -1 if no space between entries is large enough
+ */
+s32 AudioHeap_FindPcmCacheSpace(u32 size) {
+    AudioPcmCacheEntry* entry;
+    s32 offset = 0;
+    s32 i;
+    s32 j;
+
+    // Free space always starts either at the start of the cache or at the end of an entry
+    for (i = -1; i < AUDIO_PCM_CACHE_ENTRY_MAX; i++) {
+        if (i >= 0) {
+            if (gAudioPcmCache.entries[i].state == AUDIO_PCM_CACHE_STATE_NONE) {
+                continue;
+            }
+            offset = gAudioPcmCache.entries[i].offset + gAudioPcmCache.entries[i].size;
+        }
+
+        if (offset + size > AUDIO_PCM_CACHE_SIZE) {
+            continue;
+        }
+
+        for (j = 0; j < AUDIO_PCM_CACHE_ENTRY_MAX; j++) {
+            entry = &gAudioPcmCache.entries[j];
+            if ((entry->state != AUDIO_PCM_CACHE_STATE_NONE) && (offset < entry->offset + entry->size) &&
+                (entry->offset < offset + size)) {
+                break;
+            }
+        }
+        if (j == AUDIO_PCM_CACHE_ENTRY_MAX) {
+            return offset;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Gives `sample` an entry of `numFrames` frames to fill, evicting the least recently used entries not in use to make
+ * room. Samples are only given an entry when they miss a second time while still among the recent candidates, so
+ * sounds that play once do not push out the ones that repeat
+ * returns the entry, or NULL if the sample is not given one
+ */
+AudioPcmCacheEntry* AudioHeap_AllocPcmCache(Sample* sample, s32 numFrames) {
+    AudioPcmCache* cache = &gAudioPcmCache;
+    AudioPcmCacheEntry* entry;
+    AudioPcmCacheEntry* lru;
+    u32 size = (numFrames + 1) * SAMPLES_PER_FRAME * SAMPLE_SIZE;
+    s32 offset;
+    s32 i;
+
+    if ((cache->pcm == NULL) || (size > AUDIO_PCM_CACHE_SAMPLE_MAX)) {
+        return NULL;
+    }
+
+    for (i = 0; i < AUDIO_PCM_CACHE_CANDIDATE_COUNT; i++) {
+        if (cache->candidates[i] == sample->sampleAddr) {
+            break;
+        }
+    }
+    if (i == AUDIO_PCM_CACHE_CANDIDATE_COUNT) {
+        cache->candidates[cache->nextCandidate] = sample->sampleAddr;
+        cache->nextCandidate = (cache->nextCandidate + 1) % AUDIO_PCM_CACHE_CANDIDATE_COUNT;
+        return NULL;
+    }
+    cache->candidates[i] = NULL;
+
+    while (true) {
+        entry = NULL;
+        for (i = 0; i < AUDIO_PCM_CACHE_ENTRY_MAX; i++) {
+            if (cache->entries[i].state == AUDIO_PCM_CACHE_STATE_NONE) {
+                entry = &cache->entries[i];
+                break;
+            }
+        }
+
+        if (entry != NULL) {
+            offset = AudioHeap_FindPcmCacheSpace(size);
+            if (offset >= 0) {
+                break;
+            }
+        }
+
+        // Entries used this task or the last may still be read by a note that has not been processed yet
+        lru = NULL;
+        for (i = 0; i < AUDIO_PCM_CACHE_ENTRY_MAX; i++) {
+            if ((cache->entries[i].state != AUDIO_PCM_CACHE_STATE_NONE) &&
+                (cache->entries[i].lastUsedTask < gAudioCtx.totalTaskCount - 1) &&
+                ((lru == NULL) || (cache->entries[i].lastUsedTask < lru->lastUsedTask))) {
+                lru = &cache->entries[i];
+            }
+        }
+        if (lru == NULL) {
+            return NULL;
+        }
+
+        lru->state = AUDIO_PCM_CACHE_STATE_NONE;
+        gAudioPcmCacheStats.evictions++;
+        gAudioPcmCacheStats.bytesCached -= lru->size;
+    }
+
+    entry->sampleAddr = sample->sampleAddr;
+    entry->sampleSize = sample->size;
+    entry->codec = sample->codec;
+    entry->state = AUDIO_PCM_CACHE_STATE_FILLING;
+    entry->isRam = (sample->medium == MEDIUM_RAM);
+    entry->ramGeneration = cache->ramGeneration;
+    entry->serial = cache->nextSerial++;
+    entry->numFrames = numFrames;
+    entry->numFramesFilled = 0;
+    entry->offset = offset;
+    entry->size = size;
+    entry->lastUsedTask = gAudioCtx.totalTaskCount;
+
+    gAudioPcmCacheStats.bytesCached += size;
+    if (gAudioPcmCacheStats.maxBytesCached < gAudioPcmCacheStats.bytesCached) {
+        gAudioPcmCacheStats.maxBytesCached = gAudioPcmCacheStats.bytesCached;
+    }
+
+    return entry;
+}
+
 void AudioHeap_SetReverbData(s32 reverbIndex, u32 dataType, s32 data, s32 isFirstInit) {
     s32 delayNumSamples;
     SynthesisReverb* reverb = &gAudioCtx.synthesisReverbs[reverbIndex];
@@ -1615,6 +1862,7 @@ void AudioHeap_SetReverbData(s32 reverbIndex, u32 dataType, s32 data, s32 isFirs
                     reverb->filterLeftInit = NULL;
                 }
             }
+            AudioHeap_ShareReverbFilters(reverb);
             break;
 
         case REVERB_DATA_TYPE_FILTER_RIGHT:
@@ -1634,6 +1882,7 @@ void AudioHeap_SetReverbData(s32 reverbIndex, u32 dataType, s32 data, s32 isFirs
                     reverb->filterRightInit = NULL;
                 }
             }
+            AudioHeap_ShareReverbFilters(reverb);
             break;
 
         case REVERB_DATA_TYPE_9:
@@ -1650,6 +1899,30 @@ void AudioHeap_SetReverbData(s32 reverbIndex, u32 dataType, s32 data, s32 isFirs
     }
 }
 
+/**
+ * Points the right filter at the left one when their coefficients are the same, so `AudioSynth_FilterReverb` only sets
+ * them once. `filterRightInit` keeps the right coefficients either way
+ */
+void AudioHeap_ShareReverbFilters(SynthesisReverb* reverb) {
+    s32 i;
+
+    if (reverb->filterRight == NULL) {
+        return;
+    }
+
+    reverb->filterRight = reverb->filterRightInit;
+    if (reverb->filterLeft == NULL) {
+        return;
+    }
+
+    for (i = 0; i < 8; i++) {
+        if (reverb->filterLeft[i] != reverb->filterRightInit[i]) {
+            return;
+        }
+    }
+    reverb->filterRight = reverb->filterLeft;
+}
+
 void AudioHeap_InitReverb(s32 reverbIndex, ReverbSettings* settings, s32 isFirstInit) {
     SynthesisReverb* reverb = &gAudioCtx.synthesisReverbs[reverbIndex];
 
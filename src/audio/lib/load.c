@@ -91,6 +91,16 @@ s8* sScriptLoadDonePointers[0x10];
 s32 sAudioLoadPad1[2]; // file padding
 s32 D_801FD1E0;
 
+// Index of `gAudioCtx.sampleDmas` by device address, see `AudioLoad_FindSampleDma`
+u16 sSampleDmaHashHeads[SAMPLE_DMA_HASH_SIZE];
+u16 sSampleDmaHashNext[0x100];
+s32 sSampleDmaHashShift;
+u32 sSampleDmaMinSize;
+SampleDmaCacheStats gSampleDmaCacheStats;
+u8 sSampleDmaPrefetched[0x100];
+s32 sIsPrefetchingSample;
+s32 gSamplePrefetchTicks = SAMPLE_PREFETCH_TICKS;
+
 DmaHandler sDmaHandler = osEPiStartDma;
 void* sUnusedHandler = NULL;
 s32 gAudioCtxInitalized = false;
@@ -127,6 +137,80 @@ void AudioLoad_DecreaseSampleDmaTtls(void) {
     gAudioCtx.unused2648 = 0;
 }
 
+s32 AudioLoad_GetSampleDmaBucket(uintptr_t devAddr) {
+    return (devAddr >> sSampleDmaHashShift) & (SAMPLE_DMA_HASH_SIZE - 1);
+}
+
+void AudioLoad_AddSampleDmaToIndex(u32 index) {
+    u16* head = &sSampleDmaHashHeads[AudioLoad_GetSampleDmaBucket(gAudioCtx.sampleDmas[index].devAddr)];
+
+    sSampleDmaHashNext[index] = *head;
+    *head = index;
+}
+
+void AudioLoad_RemoveSampleDmaFromIndex(u32 index) {
+    u16* link = &sSampleDmaHashHeads[AudioLoad_GetSampleDmaBucket(gAudioCtx.sampleDmas[index].devAddr)];
+
+    while (*link != SAMPLE_DMA_NONE) {
+        if (*link == index) {
+            *link = sSampleDmaHashNext[index];
+            return;
+        }
+        link = &sSampleDmaHashNext[*link];
+    }
+}
+
+/**
+ * Finds the lowest index in [start, end) of a DMA buffer holding [devAddr, devAddr + size), the one a linear scan
+ * of `gAudioCtx.sampleDmas` would find.
+ *
+ * Buffers are bucketed by their device address in blocks at least as large as any buffer, so the buffers that can
+ * hold `devAddr` are all in its block or the previous one.
+ * returns the index, or -1 if there is none
+ */
+s32 AudioLoad_FindSampleDma(uintptr_t devAddr, size_t size, u32 start, u32 end) {
+    SampleDma* dma;
+    s32 bufferPos;
+    s32 found = -1;
+    s32 pass;
+    u32 i;
+    u16 index;
+    s32 bucket = AudioLoad_GetSampleDmaBucket(devAddr);
+    s32 prevBucket = AudioLoad_GetSampleDmaBucket(devAddr - (1 << sSampleDmaHashShift));
+
+    if (size > sSampleDmaMinSize) {
+        // `dma->size - size` wraps around, which makes far away buffers match too
+        for (i = start; i < end; i++) {
+            dma = &gAudioCtx.sampleDmas[i];
+            bufferPos = devAddr - dma->devAddr;
+            if ((0 <= bufferPos) && ((u32)bufferPos <= (dma->size - size))) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    for (pass = 0; pass < 2; pass++) {
+        for (index = sSampleDmaHashHeads[bucket]; index != SAMPLE_DMA_NONE; index = sSampleDmaHashNext[index]) {
+            if ((index >= start) && (index < end) && ((found < 0) || (index < found))) {
+                dma = &gAudioCtx.sampleDmas[index];
+                bufferPos = devAddr - dma->devAddr;
+                gSampleDmaCacheStats.candidatesTested++;
+                if ((0 <= bufferPos) && ((u32)bufferPos <= (dma->size - size))) {
+                    found = index;
+                }
+            }
+        }
+
+        if (bucket == prevBucket) {
+            break;
+        }
+        bucket = prevBucket;
+    }
+
+    return found;
+}
+
 void* AudioLoad_DmaSampleData(uintptr_t devAddr, size_t size, s32 arg2, u8* dmaIndexRef, s32 medium) {
     s32 pad1;
     SampleDma* dma;
@@ -139,26 +223,29 @@ void* AudioLoad_DmaSampleData(uintptr_t devAddr, size_t size, s32 arg2, u8* dmaI
     u32 i;
 
     if ((arg2 != 0) || (*dmaIndexRef >= gAudioCtx.sampleDmaListSize1)) {
-        for (i = gAudioCtx.sampleDmaListSize1; i < gAudioCtx.sampleDmaCount; i++) {
+        i = AudioLoad_FindSampleDma(devAddr, size, gAudioCtx.sampleDmaListSize1, gAudioCtx.sampleDmaCount);
+        if ((s32)i >= 0) {
             dma = &gAudioCtx.sampleDmas[i];
-            bufferPos = devAddr - dma->devAddr;
-            if ((0 <= bufferPos) && ((u32)bufferPos <= (dma->size - size))) {
-                // We already have a DMA request for this memory range.
-                if ((dma->ttl == 0) && (gAudioCtx.sampleDmaReuseQueue2RdPos != gAudioCtx.sampleDmaReuseQueue2WrPos)) {
-                    // Move the DMA out of the reuse queue, by swapping it with the
-                    // read pos, and then incrementing the read pos.
-                    if (dma->reuseIndex != gAudioCtx.sampleDmaReuseQueue2RdPos) {
-                        gAudioCtx.sampleDmaReuseQueue2[dma->reuseIndex] =
-                            gAudioCtx.sampleDmaReuseQueue2[gAudioCtx.sampleDmaReuseQueue2RdPos];
-                        gAudioCtx.sampleDmas[gAudioCtx.sampleDmaReuseQueue2[gAudioCtx.sampleDmaReuseQueue2RdPos]]
-                            .reuseIndex = dma->reuseIndex;
-                    }
-                    gAudioCtx.sampleDmaReuseQueue2RdPos++;
+            // We already have a DMA request for this memory range.
+            if ((dma->ttl == 0) && (gAudioCtx.sampleDmaReuseQueue2RdPos != gAudioCtx.sampleDmaReuseQueue2WrPos)) {
+                // Move the DMA out of the reuse queue, by swapping it with the
+                // read pos, and then incrementing the read pos.
+                if (dma->reuseIndex != gAudioCtx.sampleDmaReuseQueue2RdPos) {
+                    gAudioCtx.sampleDmaReuseQueue2[dma->reuseIndex] =
+                        gAudioCtx.sampleDmaReuseQueue2[gAudioCtx.sampleDmaReuseQueue2RdPos];
+                    gAudioCtx.sampleDmas[gAudioCtx.sampleDmaReuseQueue2[gAudioCtx.sampleDmaReuseQueue2RdPos]]
+                        .reuseIndex = dma->reuseIndex;
                 }
-                dma->ttl = 32;
-                *dmaIndexRef = (u8)i;
-                return dma->ramAddr + (devAddr - dma->devAddr);
+                gAudioCtx.sampleDmaReuseQueue2RdPos++;
             }
+            dma->ttl = 32;
+            *dmaIndexRef = (u8)i;
+            gSampleDmaCacheStats.hits++;
+            if (sSampleDmaPrefetched[i]) {
+                sSampleDmaPrefetched[i] = false;
+                gSampleDmaCacheStats.prefetchHits++;
+            }
+            return dma->ramAddr + (devAddr - dma->devAddr);
         }
 
         if (arg2 == 0) {
@@ -174,11 +261,15 @@ void* AudioLoad_DmaSampleData(uintptr_t devAddr, size_t size, s32 arg2, u8* dmaI
         }
     } else {
     search_short_lived:
+        // Try the DMA used last time first, then the lowest index in the short-lived list
         dma = gAudioCtx.sampleDmas + *dmaIndexRef;
-        i = 0;
-    again:
         bufferPos = devAddr - dma->devAddr;
-        if (0 <= bufferPos && (u32)bufferPos <= dma->size - size) {
+        if (!(0 <= bufferPos && (u32)bufferPos <= dma->size - size)) {
+            i = AudioLoad_FindSampleDma(devAddr, size, 0, gAudioCtx.sampleDmaListSize1);
+            dma = ((s32)i >= 0) ? &gAudioCtx.sampleDmas[i] : NULL;
+        }
+
+        if (dma != NULL) {
             // We already have DMA for this memory range.
             if (dma->ttl == 0) {
                 // Move the DMA out of the reuse queue, by swapping it with the
@@ -192,16 +283,18 @@ void* AudioLoad_DmaSampleData(uintptr_t devAddr, size_t size, s32 arg2, u8* dmaI
                 gAudioCtx.sampleDmaReuseQueue1RdPos++;
             }
             dma->ttl = 2;
+            gSampleDmaCacheStats.hits++;
+            if (sSampleDmaPrefetched[dma - gAudioCtx.sampleDmas]) {
+                sSampleDmaPrefetched[dma - gAudioCtx.sampleDmas] = false;
+                gSampleDmaCacheStats.prefetchHits++;
+            }
             return dma->ramAddr + (devAddr - dma->devAddr);
         }
-        dma = gAudioCtx.sampleDmas + i++;
-        if (i <= gAudioCtx.sampleDmaListSize1) {
-            goto again;
-        }
     }
 
     if (!hasDma) {
         if (gAudioCtx.sampleDmaReuseQueue1RdPos == gAudioCtx.sampleDmaReuseQueue1WrPos) {
+            gSampleDmaCacheStats.failures++;
             return NULL;
         }
         // Allocate a DMA from reuse queue 1.
@@ -210,10 +303,25 @@ void* AudioLoad_DmaSampleData(uintptr_t devAddr, size_t size, s32 arg2, u8* dmaI
         hasDma = true;
     }
 
+    if (sIsPrefetchingSample) {
+        gSampleDmaCacheStats.prefetches++;
+    } else {
+        gSampleDmaCacheStats.misses++;
+    }
+    if (dma->sizeUnused != 0) {
+        gSampleDmaCacheStats.evictions++;
+    }
+    if (sSampleDmaPrefetched[dmaIndex]) {
+        gSampleDmaCacheStats.prefetchesWasted++;
+    }
+    sSampleDmaPrefetched[dmaIndex] = sIsPrefetchingSample;
+
     transfer = dma->size;
     dmaDevAddr = devAddr & ~0xF;
     dma->ttl = 3;
+    AudioLoad_RemoveSampleDmaFromIndex(dmaIndex);
     dma->devAddr = dmaDevAddr;
+    AudioLoad_AddSampleDmaToIndex(dmaIndex);
     dma->sizeUnused = transfer;
     AudioLoad_Dma(&gAudioCtx.currAudioFrameDmaIoMesgBuf[gAudioCtx.curAudioFrameDmaCount++], OS_MESG_PRI_NORMAL, OS_READ,
                   dmaDevAddr, dma->ramAddr, transfer, &gAudioCtx.curAudioFrameDmaQueue, medium, "SUPERDMA");
@@ -221,6 +329,30 @@ void* AudioLoad_DmaSampleData(uintptr_t devAddr, size_t size, s32 arg2, u8* dmaI
     return (devAddr - dmaDevAddr) + dma->ramAddr;
 }
 
+/**
+ * Starts loading the sample data at `devAddr` into a long-lived DMA buffer ahead of the note that will play it, so
+ * that the synthesizer finds it resident when the note starts. Does nothing if the data is already in a buffer, or
+ * if taking a buffer would leave none for the synthesizer's own requests, or no frame DMA slot is free
+ */
+void AudioLoad_PrefetchSampleData(uintptr_t devAddr, s32 medium) {
+    u8 dmaIndex = 0;
+
+    // Keep the last free long-lived buffer for demand loads
+    if ((gAudioCtx.curAudioFrameDmaCount >=
+         (s32)ARRAY_COUNT(gAudioCtx.currAudioFrameDmaIoMesgBuf) - SAMPLE_PREFETCH_DMA_RESERVE) ||
+        ((u8)(gAudioCtx.sampleDmaReuseQueue2WrPos - gAudioCtx.sampleDmaReuseQueue2RdPos) <= 1)) {
+        return;
+    }
+
+    if (AudioLoad_FindSampleDma(devAddr, SAMPLE_PREFETCH_SIZE, 0, gAudioCtx.sampleDmaCount) >= 0) {
+        return;
+    }
+
+    sIsPrefetchingSample = true;
+    AudioLoad_DmaSampleData(devAddr, SAMPLE_PREFETCH_SIZE, A_INIT, &dmaIndex, medium);
+    sIsPrefetchingSample = false;
+}
+
 // This string does not appear to belong in context to any function between the previous string and the next string
 const char D_801E030C[] = "TYPE %d:ID %d is not External Map.\n";
 
@@ -293,6 +425,22 @@ void AudioLoad_InitSampleDmaBuffers(s32 numNotes) {
 
     gAudioCtx.sampleDmaReuseQueue2RdPos = 0;
     gAudioCtx.sampleDmaReuseQueue2WrPos = gAudioCtx.sampleDmaCount - gAudioCtx.sampleDmaListSize1;
+
+    // Index every buffer by device address, in blocks at least as large as the largest buffer
+    sSampleDmaMinSize = MIN(gAudioCtx.sampleDmaBufSize1, gAudioCtx.sampleDmaBufSize2);
+    sSampleDmaHashShift = 4;
+    while ((1 << sSampleDmaHashShift) < MAX(gAudioCtx.sampleDmaBufSize1, gAudioCtx.sampleDmaBufSize2)) {
+        sSampleDmaHashShift++;
+    }
+
+    for (i = 0; i < SAMPLE_DMA_HASH_SIZE; i++) {
+        sSampleDmaHashHeads[i] = SAMPLE_DMA_NONE;
+    }
+    for (i = 0; (u32)i < gAudioCtx.sampleDmaCount; i++) {
+        AudioLoad_AddSampleDmaToIndex(i);
+        sSampleDmaPrefetched[i] = false;
+    }
+    bzero(&gSampleDmaCacheStats, sizeof(SampleDmaCacheStats));
 }
 
 s32 AudioLoad_IsFontLoadComplete(s32 fontId) {
@@ -612,6 +760,7 @@ s32 AudioLoad_SyncInitSeqPlayerInternal(s32 playerIndex, s32 seqId, s32 arg2) {
     }
 
     seqPlayer->seqData = seqData;
+    AudioScript_FlushSeqPlayerDecodedInstrs(seqPlayer);
     seqPlayer->enabled = true;
     seqPlayer->scriptState.pc = seqData;
     seqPlayer->scriptState.depth = 0;
@@ -996,6 +1145,7 @@ void AudioLoad_SyncDma(uintptr_t devAddr, u8* ramAddr, size_t size, s32 medium)
 
     Audio_InvalDCache(ramAddr, size);
 
+    AudioThread_BeginProfileStage(AUDIO_PROFILE_STAGE_DMA_WAIT);
     while (true) {
         if (size < 0x400) {
             break;
@@ -1011,6 +1161,7 @@ void AudioLoad_SyncDma(uintptr_t devAddr, u8* ramAddr, size_t size, s32 medium)
         AudioLoad_Dma(ioMesg, OS_MESG_PRI_HIGH, OS_READ, devAddr, ramAddr, size, msgQueue, medium, "FastCopy");
         osRecvMesg(msgQueue, NULL, OS_MESG_BLOCK);
     }
+    AudioThread_EndProfileStage();
 }
 
 void AudioLoad_SyncDmaUnkMedium(uintptr_t devAddr, u8* ramAddr, size_t size, s32 unkMediumParam) {
@@ -1049,6 +1200,7 @@ s32 AudioLoad_Dma(OSIoMesg* mesg, u32 priority, s32 direction, uintptr_t devAddr
     mesg->devAddr = devAddr;
     mesg->size = size;
     handle->transferInfo.cmdType = 2;
+    AudioThread_AddProfileDmaBytes(size);
     sDmaHandler(handle, mesg, direction);
     return 0;
 }
@@ -1425,6 +1577,8 @@ void AudioLoad_FinishSlowLoad(AudioSlowLoad* slowLoad) {
     Sample* sample;
 
     if (slowLoad->sample.sampleAddr == NULL) {
+        // Sequence loads may overwrite script that has already been decoded
+        AudioScript_FlushDecodedInstrs();
         return;
     }
 
@@ -5,6 +5,30 @@ void AudioPlayback_NoteSetResamplingRate(NoteSampleState* sampleState, f32 resam
 void AudioPlayback_AudioListPushFront(AudioListItem* list, AudioListItem* item);
 void AudioPlayback_NoteInitForLayer(Note* note, SequenceLayer* layer);
 
+// Note priorities are 4 bits, see `AudioScript_SetChannelPriorities`
+#define NOTE_PRIORITY_COUNT 16
+
+// Non-empty note lists that can be indexed at once. Lists beyond this are searched linearly until they empty
+#define NOTE_LIST_SLOT_MAX 64
+// No note or no slot. Note indices fit in a u8 below this, as `AudioSpec.numNotes` is a u8
+#define NOTE_LIST_NONE 0xFF
+
+// Index of the priorities in each note list, see `AudioPlayback_FindNodeWithPrioLessThan`.
+// Per note:
+u8 sNoteListSlot[0x100];
+s32 sNoteListKeys[0x100];     // increases along the list
+u8 sNoteListPrevSame[0x100]; // neighbours in the list with the same priority
+u8 sNoteListNextSame[0x100];
+// Per slot:
+u8 sNoteListFreeSlots[NOTE_LIST_SLOT_MAX];
+s32 sNoteListNumFreeSlots;
+u8 sNoteListNoteCounts[NOTE_LIST_SLOT_MAX];
+u16 sNoteListPriorityMasks[NOTE_LIST_SLOT_MAX];
+u8 sNoteListPriorityHeads[NOTE_LIST_SLOT_MAX][NOTE_PRIORITY_COUNT];
+u8 sNoteListPriorityTails[NOTE_LIST_SLOT_MAX][NOTE_PRIORITY_COUNT];
+s32 sNoteListFrontKeys[NOTE_LIST_SLOT_MAX];
+s32 sNoteListBackKeys[NOTE_LIST_SLOT_MAX];
+
 void AudioPlayback_InitSampleState(Note* note, NoteSampleState* sampleState, NoteSubAttributes* subAttrs) {
     f32 volLeft;
     f32 volRight;
@@ -151,7 +175,7 @@ void AudioPlayback_NoteDisable(Note* note) {
     if (note->sampleState.bitField0.needsInit == true) {
         note->sampleState.bitField0.needsInit = false;
     }
-    note->playbackState.priority = 0;
+    AudioPlayback_SetNotePriority(note, 0);
     note->sampleState.bitField0.enabled = false;
     note->playbackState.status = PLAYBACK_STATUS_0;
     note->sampleState.bitField0.finished = false;
@@ -186,7 +210,7 @@ void AudioPlayback_ProcessNotes(void) {
             if ((note != playbackState->parentLayer->note) && (playbackState->status == PLAYBACK_STATUS_0)) {
                 playbackState->adsr.action.s.release = true;
                 playbackState->adsr.fadeOutVel = gAudioCtx.audioBufferParameters.updatesPerFrameInv;
-                playbackState->priority = 1;
+                AudioPlayback_SetNotePriority(note, 1);
                 playbackState->status = PLAYBACK_STATUS_2;
                 goto out;
             } else if (!playbackState->parentLayer->enabled && (playbackState->status == PLAYBACK_STATUS_0) &&
@@ -194,7 +218,7 @@ void AudioPlayback_ProcessNotes(void) {
                 // do nothing
             } else if (playbackState->parentLayer->channel->seqPlayer == NULL) {
                 AudioScript_SequenceChannelDisable(playbackState->parentLayer->channel);
-                playbackState->priority = 1;
+                AudioPlayback_SetNotePriority(note, 1);
                 playbackState->status = PLAYBACK_STATUS_1;
                 continue;
             } else if (playbackState->parentLayer->channel->seqPlayer->muted &&
@@ -207,7 +231,7 @@ void AudioPlayback_ProcessNotes(void) {
             AudioPlayback_SeqLayerNoteRelease(playbackState->parentLayer);
             AudioPlayback_AudioListRemove(&note->listItem);
             AudioPlayback_AudioListPushFront(&note->listItem.pool->decaying, &note->listItem);
-            playbackState->priority = 1;
+            AudioPlayback_SetNotePriority(note, 1);
             playbackState->status = PLAYBACK_STATUS_2;
         } else if ((playbackState->status == PLAYBACK_STATUS_0) && (playbackState->priority >= 1)) {
             continue;
@@ -544,10 +568,10 @@ void AudioPlayback_SeqLayerDecayRelease(SequenceLayer* layer, s32 target) {
             } else {
                 attrs->stereoData = layer->stereoData;
             }
-            note->playbackState.priority = channel->someOtherPriority;
+            AudioPlayback_SetNotePriority(note, channel->someOtherPriority);
         } else {
             attrs->stereoData = layer->stereoData;
-            note->playbackState.priority = 1;
+            AudioPlayback_SetNotePriority(note, 1);
         }
 
         note->playbackState.prevParentLayer = note->playbackState.parentLayer;
@@ -669,6 +693,7 @@ void AudioPlayback_InitNoteLists(NotePool* pool) {
 void AudioPlayback_InitNoteFreeList(void) {
     s32 i;
 
+    AudioPlayback_InitNoteListIndex();
     AudioPlayback_InitNoteLists(&gAudioCtx.noteFreeLists);
     for (i = 0; i < gAudioCtx.numNotes; i++) {
         gAudioCtx.notes[i].listItem.u.value = &gAudioCtx.notes[i];
@@ -764,6 +789,171 @@ void AudioPlayback_NotePoolFill(NotePool* pool, s32 count) {
     }
 }
 
+/**
+ * Note lists keep their notes of each priority linked in list order, so the last note with the lowest priority in a
+ * list is found without walking it. Each non-empty list owns a slot holding the heads and tails of those links, and
+ * every note records the slot of the list it is in. Only lists belonging to a `NotePool` are indexed, the layer free
+ * list has no pool
+ */
+void AudioPlayback_InitNoteListIndex(void) {
+    s32 i;
+
+    for (i = 0; i < ARRAY_COUNT(sNoteListFreeSlots); i++) {
+        sNoteListFreeSlots[i] = i;
+    }
+    sNoteListNumFreeSlots = ARRAY_COUNT(sNoteListFreeSlots);
+}
+
+s32 AudioPlayback_GetNoteListSlot(AudioListItem* item) {
+    return sNoteListSlot[(Note*)item->u.value - gAudioCtx.notes];
+}
+
+/**
+ * Links note `index` among the notes of its priority in `slot`, by its key
+ */
+void AudioPlayback_NoteListLinkPriority(s32 slot, s32 index) {
+    s32 priority = gAudioCtx.notes[index].playbackState.priority;
+    s32 key = sNoteListKeys[index];
+    s32 prev = sNoteListPriorityTails[slot][priority];
+    s32 next = NOTE_LIST_NONE;
+
+    if ((prev != NOTE_LIST_NONE) && ((key - sNoteListKeys[sNoteListPriorityHeads[slot][priority]]) < 0)) {
+        // Before the first note, always the case for notes pushed to the front
+        next = sNoteListPriorityHeads[slot][priority];
+        prev = NOTE_LIST_NONE;
+    } else {
+        // After the last note with a smaller key. Only a priority change in the middle of a list walks here
+        while ((prev != NOTE_LIST_NONE) && ((key - sNoteListKeys[prev]) < 0)) {
+            next = prev;
+            prev = sNoteListPrevSame[prev];
+        }
+    }
+
+    sNoteListPrevSame[index] = prev;
+    sNoteListNextSame[index] = next;
+    if (prev != NOTE_LIST_NONE) {
+        sNoteListNextSame[prev] = index;
+    } else {
+        sNoteListPriorityHeads[slot][priority] = index;
+    }
+    if (next != NOTE_LIST_NONE) {
+        sNoteListPrevSame[next] = index;
+    } else {
+        sNoteListPriorityTails[slot][priority] = index;
+    }
+    sNoteListPriorityMasks[slot] |= 1 << priority;
+}
+
+void AudioPlayback_NoteListUnlinkPriority(s32 slot, s32 index) {
+    s32 priority = gAudioCtx.notes[index].playbackState.priority;
+    s32 prev = sNoteListPrevSame[index];
+    s32 next = sNoteListNextSame[index];
+
+    if (prev != NOTE_LIST_NONE) {
+        sNoteListNextSame[prev] = next;
+    } else {
+        sNoteListPriorityHeads[slot][priority] = next;
+    }
+    if (next != NOTE_LIST_NONE) {
+        sNoteListPrevSame[next] = prev;
+    } else {
+        sNoteListPriorityTails[slot][priority] = prev;
+    }
+    if (sNoteListPriorityHeads[slot][priority] == NOTE_LIST_NONE) {
+        sNoteListPriorityMasks[slot] &= ~(1 << priority);
+    }
+}
+
+/**
+ * Called after `item` is linked into `list`, at its front or back
+ */
+void AudioPlayback_NoteListIndexAdd(AudioListItem* list, AudioListItem* item) {
+    s32 index = (Note*)item->u.value - gAudioCtx.notes;
+    s32 slot;
+    s32 i;
+
+    if (list->pool == NULL) {
+        return;
+    }
+
+    // Join the slot of a neighbouring note, or take a new one if the list was empty
+    if (item->next != list) {
+        slot = AudioPlayback_GetNoteListSlot(item->next);
+    } else if (item->prev != list) {
+        slot = AudioPlayback_GetNoteListSlot(item->prev);
+    } else if (sNoteListNumFreeSlots == 0) {
+        // The list is left unindexed until it empties again
+        slot = NOTE_LIST_NONE;
+    } else {
+        slot = sNoteListFreeSlots[--sNoteListNumFreeSlots];
+        sNoteListNoteCounts[slot] = 0;
+        sNoteListPriorityMasks[slot] = 0;
+        sNoteListFrontKeys[slot] = 0;
+        sNoteListBackKeys[slot] = 0;
+        for (i = 0; i < NOTE_PRIORITY_COUNT; i++) {
+            sNoteListPriorityHeads[slot][i] = NOTE_LIST_NONE;
+            sNoteListPriorityTails[slot][i] = NOTE_LIST_NONE;
+        }
+    }
+
+    sNoteListSlot[index] = slot;
+    if (slot == NOTE_LIST_NONE) {
+        return;
+    }
+
+    if (item->next == list) {
+        sNoteListKeys[index] = sNoteListBackKeys[slot]++;
+    } else {
+        sNoteListKeys[index] = --sNoteListFrontKeys[slot];
+    }
+    sNoteListNoteCounts[slot]++;
+    AudioPlayback_NoteListLinkPriority(slot, index);
+}
+
+/**
+ * Called before `item` is unlinked from its list
+ */
+void AudioPlayback_NoteListIndexRemove(AudioListItem* item) {
+    s32 index = (Note*)item->u.value - gAudioCtx.notes;
+    s32 slot;
+
+    if (item->pool == NULL) {
+        return;
+    }
+
+    slot = sNoteListSlot[index];
+    if (slot == NOTE_LIST_NONE) {
+        return;
+    }
+
+    AudioPlayback_NoteListUnlinkPriority(slot, index);
+    if (--sNoteListNoteCounts[slot] == 0) {
+        sNoteListFreeSlots[sNoteListNumFreeSlots++] = slot;
+    }
+}
+
+/**
+ * All changes to a note's priority go through here, to keep the index of the list the note is in up to date
+ */
+void AudioPlayback_SetNotePriority(Note* note, s32 priority) {
+    AudioListItem* item = &note->listItem;
+    s32 index = note - gAudioCtx.notes;
+    s32 slot = NOTE_LIST_NONE;
+
+    if ((item->prev != NULL) && (item->pool != NULL)) {
+        slot = sNoteListSlot[index];
+    }
+
+    if ((slot == NOTE_LIST_NONE) || (note->playbackState.priority == priority)) {
+        note->playbackState.priority = priority;
+        return;
+    }
+
+    AudioPlayback_NoteListUnlinkPriority(slot, index);
+    note->playbackState.priority = priority;
+    AudioPlayback_NoteListLinkPriority(slot, index);
+}
+
 void AudioPlayback_AudioListPushFront(AudioListItem* list, AudioListItem* item) {
     // add 'item' to the front of the list given by 'list', if it's not in any list
     if (item->prev == NULL) {
@@ -773,41 +963,58 @@ void AudioPlayback_AudioListPushFront(AudioListItem* list, AudioListItem* item)
         list->next = item;
         list->u.count++;
         item->pool = list->pool;
+        AudioPlayback_NoteListIndexAdd(list, item);
     }
 }
 
 void AudioPlayback_AudioListRemove(AudioListItem* item) {
     // remove 'item' from the list it's in, if any
     if (item->prev != NULL) {
+        AudioPlayback_NoteListIndexRemove(item);
         item->prev->next = item->next;
         item->next->prev = item->prev;
         item->prev = NULL;
     }
 }
 
+/**
+ * Finds the note with the lowest priority in `list`, the last one in list order if several share it.
+ * returns the note, or NULL if the list is empty or the lowest priority is not below `limit`
+ */
 Note* AudioPlayback_FindNodeWithPrioLessThan(AudioListItem* list, s32 limit) {
-    AudioListItem* cur = list->next;
+    AudioListItem* cur = list->prev;
     AudioListItem* best;
+    s32 slot;
+    u32 mask;
+    s32 lowest;
 
     if (cur == list) {
         return NULL;
     }
 
-    for (best = cur; cur != list; cur = cur->next) {
-        if (((Note*)best->u.value)->playbackState.priority >= ((Note*)cur->u.value)->playbackState.priority) {
-            best = cur;
+    slot = AudioPlayback_GetNoteListSlot(cur);
+    if (slot == NOTE_LIST_NONE) {
+        for (best = cur = list->next; cur != list; cur = cur->next) {
+            if (((Note*)best->u.value)->playbackState.priority >= ((Note*)cur->u.value)->playbackState.priority) {
+                best = cur;
+            }
         }
+        if (limit <= ((Note*)best->u.value)->playbackState.priority) {
+            return NULL;
+        }
+        return best->u.value;
     }
 
-    if (best == NULL) {
-        return NULL;
+    mask = sNoteListPriorityMasks[slot];
+    for (lowest = 0; (lowest < NOTE_PRIORITY_COUNT) && !(mask & 1); lowest++) {
+        mask >>= 1;
     }
 
-    if (limit <= ((Note*)best->u.value)->playbackState.priority) {
+    if (limit <= lowest) {
         return NULL;
     }
 
-    return best->u.value;
+    return &gAudioCtx.notes[sNoteListPriorityTails[slot][lowest]];
 }
 
 void AudioPlayback_NoteInitForLayer(Note* note, SequenceLayer* layer) {
@@ -819,7 +1026,7 @@ void AudioPlayback_NoteInitForLayer(Note* note, SequenceLayer* layer) {
 
     playbackState->prevParentLayer = NO_LAYER;
     playbackState->parentLayer = layer;
-    playbackState->priority = channel->notePriority;
+    AudioPlayback_SetNotePriority(note, channel->notePriority);
     layer->notePropertiesNeedInit = true;
     layer->bit3 = true;
     layer->note = note;
@@ -864,7 +1071,7 @@ void func_801963E8(Note* note, SequenceLayer* layer) {
 
 void AudioPlayback_NoteReleaseAndTakeOwnership(Note* note, SequenceLayer* layer) {
     note->playbackState.wantedParentLayer = layer;
-    note->playbackState.priority = layer->channel->notePriority;
+    AudioPlayback_SetNotePriority(note, layer->channel->notePriority);
 
     note->playbackState.adsr.fadeOutVel = gAudioCtx.audioBufferParameters.updatesPerFrameInv;
     note->playbackState.adsr.action.s.release = true;
@@ -918,11 +1125,11 @@ Note* AudioPlayback_AllocNoteFromActive(NotePool* pool, SequenceLayer* layer) {
         AudioPlayback_AudioListRemove(&aNote->listItem);
         func_801963E8(aNote, layer);
         AudioScript_AudioListPushBack(&pool->releasing, &aNote->listItem);
-        aNote->playbackState.priority = layer->channel->notePriority;
+        AudioPlayback_SetNotePriority(aNote, layer->channel->notePriority);
         return aNote;
     }
     rNote->playbackState.wantedParentLayer = layer;
-    rNote->playbackState.priority = layer->channel->notePriority;
+    AudioPlayback_SetNotePriority(rNote, layer->channel->notePriority);
     return rNote;
 }
 
@@ -21,11 +21,21 @@ u8 AudioScript_ScriptReadU8(SeqScriptState* state);
 s16 AudioScript_ScriptReadS16(SeqScriptState* state);
 u16 AudioScript_ScriptReadCompressedU16(SeqScriptState* state);
 void AudioScript_SeqLayerProcessScriptStep1(SequenceLayer* layer);
+void AudioScript_SeqLayerPrefetchNextNote(SequenceLayer* layer);
 s32 AudioScript_SeqLayerProcessScriptStep5(SequenceLayer* layer, s32 sameTunedSample);
-s32 AudioScript_SeqLayerProcessScriptStep2(SequenceLayer* layer);
+s32 AudioScript_SeqLayerProcessScriptStep2(SequenceLayer* layer, SeqDecodedInstr** noteInstr);
 s32 AudioScript_SeqLayerProcessScriptStep4(SequenceLayer* layer, s32 cmd);
-s32 AudioScript_SeqLayerProcessScriptStep3(SequenceLayer* layer, s32 cmd);
+s32 AudioScript_SeqLayerProcessScriptStep3(SequenceLayer* layer, SeqDecodedInstr* instr);
 u8 AudioScript_GetInstrument(SequenceChannel* channel, u8 instId, Instrument** instOut, AdsrSettings* adsr);
+SeqDecodedInstr* AudioScript_GetDecodedInstr(SequencePlayer* seqPlayer, SeqScriptState* state, s32 kind);
+
+// Decoded channel and layer instructions of each sequence player, open addressed by a hash of their address
+SeqDecodedInstr sSeqDecodeCaches[SEQ_PLAYER_MAX][SEQ_DECODE_CACHE_SIZE];
+s32 sSeqDecodeCacheFill[SEQ_PLAYER_MAX]; // used entries, including those dropped by invalidation
+SeqDecodeCacheStats gSeqDecodeCacheStats;
+
+// Marks an entry dropped by `AudioScript_InvalidateDecodedInstrs`, which lookups probe past
+#define SEQ_DECODE_DROPPED ((u8*)1)
 
 /**
  * sSeqInstructionArgsTable is a table for each sequence instruction
@@ -168,9 +178,10 @@ u16 AudioScript_GetScriptControlFlowArgument(SeqScriptState* state, u8 cmd) {
     // only 1 argument
     if (lowBits == 1) {
         if (!(highBits & 0x80)) {
-            cmdArg = AudioScript_ScriptReadU8(state);
+            cmdArg = *state->pc++;
         } else {
-            cmdArg = AudioScript_ScriptReadS16(state);
+            cmdArg = (state->pc[0] << 8) | state->pc[1];
+            state->pc += 2;
         }
     }
 
@@ -501,6 +512,7 @@ void AudioScript_AudioListPushBack(AudioListItem* list, AudioListItem* item) {
         list->prev = item;
         list->u.count++;
         item->pool = list->pool;
+        AudioPlayback_NoteListIndexAdd(list, item);
     }
 }
 
@@ -511,6 +523,7 @@ void* AudioScript_AudioListPopBack(AudioListItem* list) {
         return NULL;
     }
 
+    AudioPlayback_NoteListIndexRemove(item);
     item->prev->next = list;
     list->prev = item->prev;
     item->prev = NULL;
@@ -555,7 +568,202 @@ u16 AudioScript_ScriptReadCompressedU16(SeqScriptState* state) {
     return ret;
 }
 
+/**
+ * Decodes the instruction at `pc` into `instr` the way the interpreter for `kind` reads it, without running it.
+ * Bytes an instruction reads past its args while running (e.g. the delay of 0xFD) are not part of `length`
+ */
+void AudioScript_DecodeInstr(u8* pc, s32 kind, SeqDecodedInstr* instr) {
+    SeqScriptState reader;
+    u8 cmd;
+    u8 highBits;
+    u8 lowBits;
+    s32 i;
+
+    reader.pc = pc;
+    cmd = AudioScript_ScriptReadU8(&reader);
+
+    instr->pc = pc;
+    instr->cmd = cmd;
+    instr->kind = kind;
+    instr->args[0] = instr->args[1] = instr->args[2] = 0;
+
+    if ((cmd >= 0xF2) || ((kind == SEQ_DECODE_KIND_CHANNEL) && (cmd >= 0xA0))) {
+        // Args as given by `sSeqInstructionArgsTable`, which control flow instructions also follow
+        highBits = sSeqInstructionArgsTable[cmd - 0xA0];
+        lowBits = highBits & 3;
+
+        for (i = 0; i < lowBits; i++, highBits <<= 1) {
+            if (!(highBits & 0x80)) {
+                instr->args[i] = AudioScript_ScriptReadU8(&reader);
+            } else {
+                instr->args[i] = AudioScript_ScriptReadS16(&reader);
+            }
+        }
+    } else if (kind == SEQ_DECODE_KIND_CHANNEL) {
+        // Commands 0x00 - 0x9F read their args while running
+    } else if (cmd == 0xC0) {
+        instr->args[0] = AudioScript_ScriptReadCompressedU16(&reader);
+    } else if (cmd < 0xC0) {
+        // Notes, args as read by `AudioScript_SeqLayerProcessScriptStep3`: delay, velocity, gateTime
+        if (kind == SEQ_DECODE_KIND_LAYER_LARGE_NOTES) {
+            if ((cmd & 0xC0) != 0x80) {
+                instr->args[0] = AudioScript_ScriptReadCompressedU16(&reader);
+            }
+            instr->args[1] = AudioScript_ScriptReadU8(&reader);
+            if ((cmd & 0xC0) != 0x40) {
+                instr->args[2] = AudioScript_ScriptReadU8(&reader);
+            }
+        } else if ((cmd & 0xC0) == 0x00) {
+            instr->args[0] = AudioScript_ScriptReadCompressedU16(&reader);
+        }
+    } else {
+        // Layer commands, args as read by `AudioScript_SeqLayerProcessScriptStep2`
+        switch (cmd) {
+            case 0xC1:
+            case 0xC2:
+            case 0xC6:
+            case 0xC9:
+            case 0xCA:
+            case 0xCD:
+            case 0xCE:
+            case 0xCF:
+            case 0xF1:
+                instr->args[0] = AudioScript_ScriptReadU8(&reader);
+                break;
+
+            case 0xC3:
+                instr->args[0] = AudioScript_ScriptReadCompressedU16(&reader);
+                break;
+
+            case 0xC7:
+                instr->args[0] = AudioScript_ScriptReadU8(&reader);
+                instr->args[1] = AudioScript_ScriptReadU8(&reader);
+                // If special, the portamento time is u8 instead of var
+                if (instr->args[0] & 0x80) {
+                    instr->args[2] = AudioScript_ScriptReadU8(&reader);
+                } else {
+                    instr->args[2] = AudioScript_ScriptReadCompressedU16(&reader);
+                }
+                break;
+
+            case 0xCB:
+                instr->args[0] = AudioScript_ScriptReadS16(&reader);
+                instr->args[1] = AudioScript_ScriptReadU8(&reader);
+                break;
+
+            case 0xF0:
+                instr->args[0] = AudioScript_ScriptReadS16(&reader);
+                break;
+        }
+    }
+
+    instr->length = reader.pc - pc;
+}
+
+s32 AudioScript_GetDecodeCacheIndex(u8* pc) {
+    return ((u32)(uintptr_t)pc * 0x9E3779B1) >> (32 - SEQ_DECODE_CACHE_BITS);
+}
+
+/**
+ * Finds the entry for `pc` and `kind` in `cache`.
+ * returns the entry, or the empty entry ending the probe if there is none
+ */
+SeqDecodedInstr* AudioScript_FindDecodedInstr(SeqDecodedInstr* cache, u8* pc, s32 kind) {
+    s32 index = AudioScript_GetDecodeCacheIndex(pc);
+    SeqDecodedInstr* instr;
+
+    // The fill limit keeps empty entries in every cache, so the probe ends
+    while (true) {
+        instr = &cache[index];
+        if ((instr->pc == NULL) || ((instr->pc == pc) && (instr->kind == kind))) {
+            return instr;
+        }
+        index = (index + 1) & (SEQ_DECODE_CACHE_SIZE - 1);
+    }
+}
+
+/**
+ * Drops every decoded instruction of `seqPlayer`, for when it starts a new sequence
+ */
+void AudioScript_FlushSeqPlayerDecodedInstrs(SequencePlayer* seqPlayer) {
+    s32 playerIndex = seqPlayer - gAudioCtx.seqPlayers;
+    s32 i;
+
+    for (i = 0; i < SEQ_DECODE_CACHE_SIZE; i++) {
+        sSeqDecodeCaches[playerIndex][i].pc = NULL;
+    }
+    sSeqDecodeCacheFill[playerIndex] = 0;
+}
+
+/**
+ * Returns the decoded instruction at the pc of `state` and steps the pc over it, as reading the command byte and its
+ * args would. Each sequence player keeps its own decoded instructions, so scripts that loop only decode each
+ * instruction once unless the player runs through more than SEQ_DECODE_CACHE_FILL_MAX different ones
+ */
+SeqDecodedInstr* AudioScript_GetDecodedInstr(SequencePlayer* seqPlayer, SeqScriptState* state, s32 kind) {
+    s32 playerIndex = seqPlayer - gAudioCtx.seqPlayers;
+    SeqDecodedInstr* instr = AudioScript_FindDecodedInstr(sSeqDecodeCaches[playerIndex], state->pc, kind);
+
+    if (instr->pc != NULL) {
+        gSeqDecodeCacheStats.hits++;
+    } else {
+        gSeqDecodeCacheStats.misses++;
+        if (sSeqDecodeCacheFill[playerIndex] >= SEQ_DECODE_CACHE_FILL_MAX) {
+            gSeqDecodeCacheStats.flushes++;
+            AudioScript_FlushSeqPlayerDecodedInstrs(seqPlayer);
+            instr = AudioScript_FindDecodedInstr(sSeqDecodeCaches[playerIndex], state->pc, kind);
+        }
+        sSeqDecodeCacheFill[playerIndex]++;
+        AudioScript_DecodeInstr(state->pc, kind, instr);
+    }
+
+    state->pc += instr->length;
+    return instr;
+}
+
+/**
+ * Drops every decoded instruction, for when script memory is replaced as a whole
+ */
+void AudioScript_FlushDecodedInstrs(void) {
+    s32 i;
+
+    for (i = 0; i < ARRAY_COUNT(gAudioCtx.seqPlayers); i++) {
+        AudioScript_FlushSeqPlayerDecodedInstrs(&gAudioCtx.seqPlayers[i]);
+    }
+}
+
+/**
+ * Drops the decoded instructions that read any of the `size` bytes at `addr`, for scripts that write into script data
+ */
+void AudioScript_InvalidateDecodedInstrs(u8* addr, s32 size) {
+    SeqDecodedInstr* instr;
+    s32 playerIndex;
+    s32 kind;
+    u8* pc;
+
+    for (playerIndex = 0; playerIndex < SEQ_PLAYER_MAX; playerIndex++) {
+        for (pc = addr - (SEQ_DECODE_MAX_LENGTH - 1); pc < addr + size; pc++) {
+            for (kind = SEQ_DECODE_KIND_CHANNEL; kind <= SEQ_DECODE_KIND_LAYER_LARGE_NOTES; kind++) {
+                instr = AudioScript_FindDecodedInstr(sSeqDecodeCaches[playerIndex], pc, kind);
+                if ((instr->pc != NULL) && (pc + instr->length > addr)) {
+                    // Still counted in the fill, as later entries may have probed past it
+                    instr->pc = SEQ_DECODE_DROPPED;
+                    gSeqDecodeCacheStats.invalidations++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Debug accessor for the decoded instruction cache counters, kept since boot
+ */
+SeqDecodeCacheStats* AudioScript_GetDecodeCacheStats(void) {
+    return &gSeqDecodeCacheStats;
+}
+
 void AudioScript_SeqLayerProcessScript(SequenceLayer* layer) {
+    SeqDecodedInstr* noteInstr;
     s32 cmd;
 
     if (!layer->enabled) {
@@ -568,18 +776,21 @@ void AudioScript_SeqLayerProcessScript(SequenceLayer* layer) {
             AudioPlayback_SeqLayerNoteDecay(layer);
             layer->muted = true;
         }
+        if ((gSamplePrefetchTicks != 0) && (layer->delay == gSamplePrefetchTicks)) {
+            AudioScript_SeqLayerPrefetchNextNote(layer);
+        }
         return;
     }
 
     AudioScript_SeqLayerProcessScriptStep1(layer);
 
     do {
-        cmd = AudioScript_SeqLayerProcessScriptStep2(layer);
+        cmd = AudioScript_SeqLayerProcessScriptStep2(layer, &noteInstr);
         if (cmd == PROCESS_SCRIPT_END) {
             return;
         }
 
-        cmd = AudioScript_SeqLayerProcessScriptStep3(layer, cmd);
+        cmd = AudioScript_SeqLayerProcessScriptStep3(layer, noteInstr);
 
     } while ((cmd == -1) && (layer->delay == 0));
 
@@ -599,6 +810,73 @@ void AudioScript_SeqLayerProcessScript(SequenceLayer* layer) {
     }
 }
 
+/**
+ * Peeks at the next layer command and, if it plays a note, starts loading the start of the note's sample so it is
+ * resident by the time the note starts. Only a note directly following the current delay is found, and notes using
+ * portamento are skipped since their sample depends on the portamento target. Mirrors how
+ * `AudioScript_SeqLayerProcessScriptStep4` picks the sample, without raising audio errors
+ */
+void AudioScript_SeqLayerPrefetchNextNote(SequenceLayer* layer) {
+    SequenceChannel* channel = layer->channel;
+    SoundFont* soundFont;
+    Instrument* instrument;
+    Drum* drum;
+    Sample* sample;
+    s32 instOrWave = layer->instOrWave;
+    s32 cmd = *layer->scriptState.pc;
+    u8 semitone;
+
+    // Delays and other commands (>= 0xC0) are not looked past
+    if (cmd >= 0xC0) {
+        return;
+    }
+    semitone = cmd & 0x3F;
+
+    if (instOrWave == 0xFF) {
+        if (!channel->hasInstrument) {
+            return;
+        }
+        instOrWave = channel->instOrWave;
+    }
+
+    if (instOrWave == 0) {
+        // Drums
+        semitone += channel->transposition + layer->transposition;
+
+        if ((channel->fontId == 0xFF) || !AudioLoad_IsFontLoadComplete(channel->fontId)) {
+            return;
+        }
+        soundFont = &gAudioCtx.soundFontList[channel->fontId];
+        if ((semitone >= soundFont->numDrums) || ((u32)soundFont->drums < AUDIO_RELOCATED_ADDRESS_START)) {
+            return;
+        }
+        drum = soundFont->drums[semitone];
+        if (drum == NULL) {
+            return;
+        }
+        sample = drum->tunedSample.sample;
+    } else if (instOrWave == 1) {
+        // Sfxs are not prefetched
+        return;
+    } else {
+        semitone += channel->seqPlayer->transposition + channel->transposition + layer->transposition;
+        if ((semitone >= 0x80) || (layer->portamento.mode != PORTAMENTO_MODE_OFF)) {
+            return;
+        }
+
+        instrument = (layer->instOrWave == 0xFF) ? channel->instrument : layer->instrument;
+        if (instrument == NULL) {
+            // Synthetic wave
+            return;
+        }
+        sample = AudioPlayback_GetInstrumentTunedSample(instrument, semitone)->sample;
+    }
+
+    if ((sample != NULL) && (sample->medium != MEDIUM_RAM) && (sample->medium != MEDIUM_UNK)) {
+        AudioLoad_PrefetchSampleData((uintptr_t)sample->sampleAddr, sample->medium);
+    }
+}
+
 void AudioScript_SeqLayerProcessScriptStep1(SequenceLayer* layer) {
     if (!layer->continuousNotes) {
         AudioPlayback_SeqLayerNoteDecay(layer);
@@ -650,27 +928,31 @@ s32 AudioScript_SeqLayerProcessScriptStep5(SequenceLayer* layer, s32 sameTunedSa
     return 0;
 }
 
-s32 AudioScript_SeqLayerProcessScriptStep2(SequenceLayer* layer) {
+s32 AudioScript_SeqLayerProcessScriptStep2(SequenceLayer* layer, SeqDecodedInstr** noteInstr) {
     SequenceChannel* channel = layer->channel;
     SeqScriptState* state = &layer->scriptState;
     SequencePlayer* seqPlayer = channel->seqPlayer;
+    SeqDecodedInstr* instr;
+    s32 kind = (channel->largeNotes == true) ? SEQ_DECODE_KIND_LAYER_LARGE_NOTES : SEQ_DECODE_KIND_LAYER_SMALL_NOTES;
     u8 cmd;
     u8 cmdArg8;
     u16 cmdArg16;
     u16 velocity;
 
     while (true) {
-        cmd = AudioScript_ScriptReadU8(state);
+        instr = AudioScript_GetDecodedInstr(seqPlayer, state, kind);
+        cmd = instr->cmd;
 
         // Note Commands
         // To be processed in AudioScript_SeqLayerProcessScriptStep3
         if (cmd <= 0xC0) {
+            *noteInstr = instr;
             return cmd;
         }
 
         // Control Flow Commands
         if (cmd >= 0xF2) {
-            cmdArg16 = AudioScript_GetScriptControlFlowArgument(state, cmd);
+            cmdArg16 = instr->args[0];
 
             if (AudioScript_HandleScriptFlowControl(seqPlayer, state, cmd, cmdArg16) == 0) {
                 continue;
@@ -682,7 +964,7 @@ s32 AudioScript_SeqLayerProcessScriptStep2(SequenceLayer* layer) {
         switch (cmd) {
             case 0xC1: // layer: set short note velocity
             case 0xCA: // layer: set pan
-                cmdArg8 = *(state->pc++);
+                cmdArg8 = instr->args[0];
                 if (cmd == 0xC1) {
                     layer->velocitySquare = SQ(cmdArg8) / SQ(127.0f);
                 } else {
@@ -692,7 +974,7 @@ s32 AudioScript_SeqLayerProcessScriptStep2(SequenceLayer* layer) {
 
             case 0xC9: // layer: set short note gatetime
             case 0xC2: // layer: set transposition in semitones
-                cmdArg8 = *(state->pc++);
+                cmdArg8 = instr->args[0];
                 if (cmd == 0xC9) {
                     layer->gateTime = cmdArg8;
                 } else {
@@ -712,12 +994,12 @@ s32 AudioScript_SeqLayerProcessScriptStep2(SequenceLayer* layer) {
                 break;
 
             case 0xC3: // layer: set short note default delay
-                cmdArg16 = AudioScript_ScriptReadCompressedU16(state);
+                cmdArg16 = instr->args[0];
                 layer->shortNoteDefaultDelay = cmdArg16;
                 break;
 
             case 0xC6: // layer: set instrument
-                cmd = AudioScript_ScriptReadU8(state);
+                cmd = instr->args[0];
                 if (cmd >= 0x7E) {
                     if (cmd == 0x7E) {
                         // Sfxs
@@ -744,9 +1026,9 @@ s32 AudioScript_SeqLayerProcessScriptStep2(SequenceLayer* layer) {
                 break;
 
             case 0xC7: // layer: enable portamento
-                layer->portamento.mode = AudioScript_ScriptReadU8(state);
+                layer->portamento.mode = instr->args[0];
 
-                cmd = AudioScript_ScriptReadU8(state);
+                cmd = instr->args[1];
                 cmd += channel->transposition;
                 cmd += layer->transposition;
                 cmd += seqPlayer->transposition;
@@ -757,14 +1039,8 @@ s32 AudioScript_SeqLayerProcessScriptStep2(SequenceLayer* layer) {
 
                 layer->portamentoTargetNote = cmd;
 
-                // If special, the next param is u8 instead of var
-                if (PORTAMENTO_IS_SPECIAL(layer->portamento)) {
-                    layer->portamentoTime = *(state->pc++);
-                    break;
-                }
-
-                cmdArg16 = AudioScript_ScriptReadCompressedU16(state);
-                layer->portamentoTime = cmdArg16;
+                // If special, the time was read as u8 instead of var
+                layer->portamentoTime = instr->args[2];
                 break;
 
             case 0xC8: // layer: disable portamento
@@ -772,11 +1048,13 @@ s32 AudioScript_SeqLayerProcessScriptStep2(SequenceLayer* layer) {
                 break;
 
             case 0xCB: // layer: set envelope and decay index
-                cmdArg16 = AudioScript_ScriptReadS16(state);
+                cmdArg16 = instr->args[0];
                 layer->adsr.envelope = (EnvelopePoint*)(seqPlayer->seqData + cmdArg16);
-                // fallthrough
+                layer->adsr.decayIndex = instr->args[1];
+                break;
+
             case 0xCF: // layer: set decay index
-                layer->adsr.decayIndex = AudioScript_ScriptReadU8(state);
+                layer->adsr.decayIndex = instr->args[0];
                 break;
 
             case 0xCC: // layer: ignore drum pan
@@ -784,21 +1062,21 @@ s32 AudioScript_SeqLayerProcessScriptStep2(SequenceLayer* layer) {
                 break;
 
             case 0xCD: // layer: stereo effects
-                layer->stereoData.asByte = AudioScript_ScriptReadU8(state);
+                layer->stereoData.asByte = instr->args[0];
                 break;
 
             case 0xCE: // layer: bend pitch
-                cmdArg8 = AudioScript_ScriptReadU8(state);
+                cmdArg8 = instr->args[0];
                 layer->bend = gBendPitchTwoSemitonesFrequencies[(u8)(cmdArg8 + 0x80)];
                 break;
 
             case 0xF0: // layer:
-                cmdArg16 = AudioScript_ScriptReadS16(state);
+                cmdArg16 = instr->args[0];
                 layer->unk_0A.asByte &= (cmdArg16 ^ 0xFFFF);
                 break;
 
             case 0xF1: // layer:
-                layer->surroundEffectIndex = AudioScript_ScriptReadU8(state);
+                layer->surroundEffectIndex = instr->args[0];
                 break;
 
             default:
@@ -1027,8 +1305,8 @@ s32 AudioScript_SeqLayerProcessScriptStep4(SequenceLayer* layer, s32 cmd) {
     return sameTunedSample;
 }
 
-s32 AudioScript_SeqLayerProcessScriptStep3(SequenceLayer* layer, s32 cmd) {
-    SeqScriptState* state = &layer->scriptState;
+s32 AudioScript_SeqLayerProcessScriptStep3(SequenceLayer* layer, SeqDecodedInstr* instr) {
+    s32 cmd = instr->cmd;
     u16 delay;
     s32 velocity;
     SequenceChannel* channel = layer->channel;
@@ -1037,7 +1315,7 @@ s32 AudioScript_SeqLayerProcessScriptStep3(SequenceLayer* layer, s32 cmd) {
     f32 floatDelta;
 
     if (cmd == 0xC0) { // layer: delay
-        layer->delay = AudioScript_ScriptReadCompressedU16(state);
+        layer->delay = instr->args[0];
         layer->muted = true;
         layer->bit1 = false;
         return PROCESS_SCRIPT_END;
@@ -1048,23 +1326,23 @@ s32 AudioScript_SeqLayerProcessScriptStep3(SequenceLayer* layer, s32 cmd) {
     if (channel->largeNotes == true) {
         switch (cmd & 0xC0) {
             case 0x00: // layer: large note 0
-                delay = AudioScript_ScriptReadCompressedU16(state);
-                velocity = *(state->pc++);
-                layer->gateTime = *(state->pc++);
+                delay = instr->args[0];
+                velocity = instr->args[1];
+                layer->gateTime = instr->args[2];
                 layer->lastDelay = delay;
                 break;
 
             case 0x40: // layer: large note 1
-                delay = AudioScript_ScriptReadCompressedU16(state);
-                velocity = *(state->pc++);
+                delay = instr->args[0];
+                velocity = instr->args[1];
                 layer->gateTime = 0;
                 layer->lastDelay = delay;
                 break;
 
             case 0x80: // layer: large note 2
                 delay = layer->lastDelay;
-                velocity = *(state->pc++);
-                layer->gateTime = *(state->pc++);
+                velocity = instr->args[1];
+                layer->gateTime = instr->args[2];
                 break;
         }
 
@@ -1076,7 +1354,7 @@ s32 AudioScript_SeqLayerProcessScriptStep3(SequenceLayer* layer, s32 cmd) {
     } else {
         switch (cmd & 0xC0) {
             case 0x00: // layer: small note 0
-                delay = AudioScript_ScriptReadCompressedU16(state);
+                delay = instr->args[0];
                 layer->lastDelay = delay;
                 break;
 
@@ -1222,14 +1500,14 @@ void AudioScript_SequenceChannelProcessScript(SequenceChannel* channel) {
 
     while (true) {
         SeqScriptState* scriptState = &channel->scriptState;
+        SeqDecodedInstr* instr = AudioScript_GetDecodedInstr(seqPlayer, scriptState, SEQ_DECODE_KIND_CHANNEL);
         s32 param;
         s16 temp1;
         u16 cmdArgU16;
         u32 cmdArgs[3];
         s8 cmdArgS8;
-        u8 cmd = AudioScript_ScriptReadU8(scriptState);
+        u8 cmd = instr->cmd;
         u8 lowBits;
-        u8 highBits;
         s32 delay;
         s32 temp2;
         u8 phi_v0_3;
@@ -1240,16 +1518,9 @@ void AudioScript_SequenceChannelProcessScript(SequenceChannel* channel) {
 
         // Commands 0xA0 - 0xFF
         if (cmd >= 0xA0) {
-            highBits = sSeqInstructionArgsTable[cmd - 0xA0];
-            lowBits = highBits & 3;
-
-            // read in arguments for the instruction
-            for (i = 0; i < lowBits; i++, highBits <<= 1) {
-                if (!(highBits & 0x80)) {
-                    cmdArgs[i] = AudioScript_ScriptReadU8(scriptState);
-                } else {
-                    cmdArgs[i] = AudioScript_ScriptReadS16(scriptState);
-                }
+            // arguments for the instruction, already read in by `AudioScript_GetDecodedInstr`
+            for (i = 0; i < ARRAY_COUNT(cmdArgs); i++) {
+                cmdArgs[i] = instr->args[i];
             }
 
             // Control Flow Commands
@@ -1443,6 +1714,7 @@ void AudioScript_SequenceChannelProcessScript(SequenceChannel* channel) {
                     cmdArgU16 = (u16)cmdArgs[1];
                     seqData = &seqPlayer->seqData[cmdArgU16];
                     seqData[0] = (u8)scriptState->value + cmd;
+                    AudioScript_InvalidateDecodedInstrs(seqData, 1);
                     break;
 
                 case 0xC8: // channel: subtract -> set value
@@ -1485,6 +1757,7 @@ void AudioScript_SequenceChannelProcessScript(SequenceChannel* channel) {
                     seqData = &seqPlayer->seqData[cmdArgU16];
                     seqData[0] = (channel->unk_22 >> 8) & 0xFF;
                     seqData[1] = channel->unk_22 & 0xFF;
+                    AudioScript_InvalidateDecodedInstrs(seqData, 2);
                     break;
 
                 case 0xD0: // channel: stereo headset effects
@@ -1606,6 +1879,7 @@ void AudioScript_SequenceChannelProcessScript(SequenceChannel* channel) {
                         lowBits = (cmd >> 4) & 0xF; // LowPassCutoff
                         cmd &= 0xF;                 // HighPassCutoff
                         AudioHeap_LoadFilter(channel->filter, lowBits, cmd);
+                        AudioScript_InvalidateDecodedInstrs((u8*)channel->filter, FILTER_SIZE);
                     }
                     break;
 
@@ -1708,6 +1982,7 @@ void AudioScript_SequenceChannelProcessScript(SequenceChannel* channel) {
                     cmdArgU16 = (u16)cmdArgs[1];
                     seqData = seqPlayer->seqData + (u32)(cmdArgU16 + channel->channelIndex);
                     seqData[0] = (u8)scriptState->value + cmd;
+                    AudioScript_InvalidateDecodedInstrs(seqData, 1);
                     break;
 
                 case 0xA7: // channel:
@@ -2077,6 +2352,7 @@ void AudioScript_SequencePlayerProcessSequence(SequencePlayer* seqPlayer) {
                         temp = AudioScript_ScriptReadS16(seqScript);
                         data2 = &seqPlayer->seqData[temp];
                         *data2 = (u8)seqScript->value + cmd;
+                        AudioScript_InvalidateDecodedInstrs(data2, 1);
                         break;
 
                     case 0xC2: // seqPlayer:
@@ -2200,6 +2476,7 @@ void AudioScript_ProcessSequences(s32 arg0) {
     SequencePlayer* seqPlayer;
     u32 i;
 
+    AudioThread_BeginProfileStage(AUDIO_PROFILE_STAGE_SEQUENCES);
     gAudioCtx.sampleStateOffset = (gAudioCtx.audioBufferParameters.updatesPerFrame - arg0 - 1) * gAudioCtx.numNotes;
 
     for (i = 0; i < (u32)gAudioCtx.audioBufferParameters.numSequencePlayers; i++) {
@@ -2210,7 +2487,10 @@ void AudioScript_ProcessSequences(s32 arg0) {
         }
     }
 
+    AudioThread_BeginProfileStage(AUDIO_PROFILE_STAGE_NOTES);
     AudioPlayback_ProcessNotes();
+    AudioThread_EndProfileStage();
+    AudioThread_EndProfileStage();
 }
 
 void AudioScript_SkipForwardSequence(SequencePlayer* seqPlayer) {
@@ -2303,6 +2583,7 @@ void AudioScript_InitSequencePlayers(void) {
     s32 i;
 
     AudioScript_InitLayerFreelist();
+    AudioScript_FlushDecodedInstrs();
 
     for (i = 0; i < ARRAY_COUNT(gAudioCtx.sequenceLayers); i++) {
         gAudioCtx.sequenceLayers[i].channel = NULL;
@@ -37,6 +37,9 @@ Acmd* AudioSynth_LoadWaveSamples(Acmd* cmd, NoteSampleState* sampleState, NoteSy
                                  s32 numSamplesToLoad);
 Acmd* AudioSynth_ApplyHaasEffect(Acmd* cmd, NoteSampleState* sampleState, NoteSynthesisState* synthState, s32 size,
                                  s32 flags, s32 haasEffectDelaySide);
+void AudioSynth_InitNotePcmCache(s32 noteIndex, Note* note, NoteSampleState* sampleState, Sample* sample);
+AudioPcmCacheEntry* AudioSynth_GetNotePcmCache(s32 noteIndex);
+Acmd* AudioSynth_FillPcmCache(Acmd* cmd, AudioPcmCacheEntry* entry, s32 dmem, s32 frameIndex, s32 numFrames);
 
 s32 D_801D5FB0 = 0;
 
@@ -559,7 +562,10 @@ Acmd* AudioSynth_FilterReverb(Acmd* cmd, s32 size, SynthesisReverb* reverb) {
     }
 
     if (reverb->filterRight != NULL) {
-        aFilter(cmd++, 2, size, reverb->filterRight);
+        // Both sides share the left coefficients when they are the same, see `AudioHeap_ShareReverbFilters`
+        if (reverb->filterRight != reverb->filterLeft) {
+            aFilter(cmd++, 2, size, reverb->filterRight);
+        }
         aFilter(cmd++, reverb->resampleFlags, DMEM_WET_RIGHT_CH, reverb->filterRightState);
     }
 
@@ -612,33 +618,39 @@ Acmd* AudioSynth_LoadSubReverbSamples(Acmd* cmd, s32 numSamplesPerUpdate, Synthe
     return cmd;
 }
 
+/**
+ * Saves `size` bytes at `dmem` to `startAddr`, which may not be 16-byte aligned. The samples are moved next to the
+ * 16-byte block holding the start, then the rest of the block holding the end is moved in after them, so the other
+ * bytes of both blocks are saved back unchanged in a single save
+ */
 Acmd* AudioSynth_SaveResampledReverbSamplesImpl(Acmd* cmd, u16 dmem, u16 size, uintptr_t startAddr) {
-    s32 startAddrAlignDropped;
-    u32 endAddr;
-    s32 endAddrAlignDropped;
-
-    endAddr = startAddr + size;
-
-    endAddrAlignDropped = endAddr & 0xF;
-    if (endAddrAlignDropped != 0) {
-        aLoadBuffer(cmd++, (endAddr - endAddrAlignDropped), DMEM_TEMP, 0x10);
-        aDMEMMove(cmd++, dmem, DMEM_TEMP2, size);
-        aDMEMMove(cmd++, DMEM_TEMP + endAddrAlignDropped, size + DMEM_TEMP2, 0x10 - endAddrAlignDropped);
-
-        size += (0x10 - endAddrAlignDropped);
-        dmem = DMEM_TEMP2;
+    s32 startAddrAlignDropped = startAddr & 0xF;
+    uintptr_t alignedStartAddr = startAddr - startAddrAlignDropped;
+    u32 endAddr = startAddr + size;
+    s32 endAddrAlignDropped = endAddr & 0xF;
+    u16 alignedSize = ALIGN16(startAddrAlignDropped + size);
+    // DMEMMOVE rounds its count up to 16, so the end block is kept clear of everything the samples' move can write
+    u16 endBlockDmem = DMEM_TEMP + alignedSize + 0x10;
+
+    if ((startAddrAlignDropped == 0) && (endAddrAlignDropped == 0)) {
+        aSaveBuffer(cmd++, dmem, startAddr, size);
+        return cmd;
     }
 
-    startAddrAlignDropped = startAddr & 0xF;
     if (startAddrAlignDropped != 0) {
-        aLoadBuffer(cmd++, startAddr - startAddrAlignDropped, DMEM_TEMP, 0x10);
-        aDMEMMove(cmd++, dmem, startAddrAlignDropped + DMEM_TEMP, size);
+        aLoadBuffer(cmd++, alignedStartAddr, DMEM_TEMP, 0x10);
+    }
 
-        size += startAddrAlignDropped;
-        dmem = DMEM_TEMP;
+    aDMEMMove(cmd++, dmem, DMEM_TEMP + startAddrAlignDropped, size);
+
+    // Only after the samples, as their move overwrites the rest of the last block
+    if (endAddrAlignDropped != 0) {
+        aLoadBuffer(cmd++, endAddr - endAddrAlignDropped, endBlockDmem, 0x10);
+        aDMEMMove(cmd++, endBlockDmem + endAddrAlignDropped, DMEM_TEMP + startAddrAlignDropped + size,
+                  0x10 - endAddrAlignDropped);
     }
 
-    aSaveBuffer(cmd++, dmem, startAddr - startAddrAlignDropped, size);
+    aSaveBuffer(cmd++, DMEM_TEMP, alignedStartAddr, alignedSize);
 
     return cmd;
 }
@@ -874,6 +886,102 @@ Acmd* AudioSynth_ProcessSamples(s16* aiBuf, s32 numSamplesPerUpdate, Acmd* cmd,
     return cmd;
 }
 
+/**
+ * Picks how a note starting on `sample` uses the decoded sample cache. A sample only decodes to the same frames every
+ * time it plays if it starts from the beginning and does not loop, so only those notes read or fill entries
+ */
+void AudioSynth_InitNotePcmCache(s32 noteIndex, Note* note, NoteSampleState* sampleState, Sample* sample) {
+    AudioPcmCacheNote* cacheNote;
+    AudioPcmCacheEntry* entry;
+
+    if (gAudioPcmCache.notes == NULL) {
+        return;
+    }
+
+    cacheNote = &gAudioPcmCache.notes[noteIndex];
+    cacheNote->entryIndex = 0;
+
+    if ((gAudioPcmCache.pcm == NULL) || gAudioPcmCache.isDisabled ||
+        ((sample->codec != CODEC_ADPCM) && (sample->codec != CODEC_SMALL_ADPCM)) || (sample->loop->count != 0) ||
+        (note->playbackState.startSamplePos != 0) || (sampleState->bitField1.bookOffset == 1) ||
+        (sample->medium == MEDIUM_UNK)) {
+        return;
+    }
+
+    entry = AudioHeap_SearchPcmCache(sample);
+    // The frames saved by the last fill are only in ram once the task that saved them has run
+    if ((entry != NULL) && (entry->state == AUDIO_PCM_CACHE_STATE_READY) &&
+        (entry->readyTask != gAudioCtx.totalTaskCount)) {
+        cacheNote->isHit = true;
+        gAudioPcmCacheStats.hits++;
+    } else {
+        cacheNote->isHit = false;
+        gAudioPcmCacheStats.misses++;
+        if (entry == NULL) {
+            entry = AudioHeap_AllocPcmCache(sample,
+                                            (sample->loop->loopEnd + SAMPLES_PER_FRAME - 1) / SAMPLES_PER_FRAME);
+        } else if ((entry->state == AUDIO_PCM_CACHE_STATE_FILLING) &&
+                   (entry->lastUsedTask < gAudioCtx.totalTaskCount - 1)) {
+            // Every note filling the entry stopped before the end, so start over from the first frame
+            entry->numFramesFilled = 0;
+        }
+    }
+
+    if (entry != NULL) {
+        cacheNote->entryIndex = (entry - gAudioPcmCache.entries) + 1;
+        cacheNote->serial = entry->serial;
+    }
+}
+
+/**
+ * returns the entry a note reads or fills, or NULL if it has none
+ */
+AudioPcmCacheEntry* AudioSynth_GetNotePcmCache(s32 noteIndex) {
+    AudioPcmCacheNote* cacheNote;
+    AudioPcmCacheEntry* entry;
+
+    if (gAudioPcmCache.notes == NULL) {
+        return NULL;
+    }
+
+    cacheNote = &gAudioPcmCache.notes[noteIndex];
+    if (cacheNote->entryIndex == 0) {
+        return NULL;
+    }
+
+    entry = &gAudioPcmCache.entries[cacheNote->entryIndex - 1];
+    if ((entry->state == AUDIO_PCM_CACHE_STATE_NONE) || (entry->serial != cacheNote->serial)) {
+        cacheNote->entryIndex = 0;
+        return NULL;
+    }
+
+    entry->lastUsedTask = gAudioCtx.totalTaskCount;
+    return entry;
+}
+
+/**
+ * Saves the frames a note just decoded at `dmem` to the entry it fills, if they are the next ones the entry needs.
+ * The decode writes the last frame of the previous decode first, which is saved again along with them
+ */
+Acmd* AudioSynth_FillPcmCache(Acmd* cmd, AudioPcmCacheEntry* entry, s32 dmem, s32 frameIndex, s32 numFrames) {
+    if ((entry->state != AUDIO_PCM_CACHE_STATE_FILLING) || (numFrames == 0) ||
+        (frameIndex != entry->numFramesFilled)) {
+        return cmd;
+    }
+
+    AudioSynth_SaveBuffer(cmd++, dmem, (numFrames + 1) * SAMPLES_PER_FRAME * SAMPLE_SIZE,
+                          &gAudioPcmCache.pcm[(entry->offset / SAMPLE_SIZE) + (frameIndex * SAMPLES_PER_FRAME)]);
+
+    entry->numFramesFilled += numFrames;
+    if (entry->numFramesFilled >= entry->numFrames) {
+        entry->state = AUDIO_PCM_CACHE_STATE_READY;
+        entry->readyTask = gAudioCtx.totalTaskCount;
+        gAudioPcmCacheStats.fills++;
+    }
+
+    return cmd;
+}
+
 Acmd* AudioSynth_ProcessSample(s32 noteIndex, NoteSampleState* sampleState, NoteSynthesisState* synthState, s16* aiBuf,
                                s32 numSamplesPerUpdate, Acmd* cmd, s32 updateIndex) {
     s32 pad1[2];
@@ -926,6 +1034,8 @@ Acmd* AudioSynth_ProcessSample(s32 noteIndex, NoteSampleState* sampleState, Note
     s32 finished = sampleState->bitField0.finished;
     s32 sampleDataChunkSize;
     s16 sampleDataDmemAddr;
+    AudioPcmCacheEntry* pcmCacheEntry;
+    s32 isPcmCacheHit;
 
     note = &gAudioCtx.notes[noteIndex];
     flags = A_CONTINUE;
@@ -993,6 +1103,12 @@ Acmd* AudioSynth_ProcessSample(s32 noteIndex, NoteSampleState* sampleState, Note
         sampleAddr = sample->sampleAddr;
         numSamplesToLoadFirstPart = 0;
 
+        if (flags == A_INIT) {
+            AudioSynth_InitNotePcmCache(noteIndex, note, sampleState, sample);
+        }
+        pcmCacheEntry = AudioSynth_GetNotePcmCache(noteIndex);
+        isPcmCacheHit = (pcmCacheEntry != NULL) && gAudioPcmCache.notes[noteIndex].isHit;
+
         // If the frequency requested is more than double that of the raw sample,
         // then the sample processing is split into two parts.
         for (curPart = 0; curPart < numParts; curPart++) {
@@ -1010,8 +1126,8 @@ Acmd* AudioSynth_ProcessSample(s32 noteIndex, NoteSampleState* sampleState, Note
                 numSamplesToLoadAdj = numSamplesToLoad;
             }
 
-            // Load the ADPCM codeBook
-            if ((sample->codec == CODEC_ADPCM) || (sample->codec == CODEC_SMALL_ADPCM)) {
+            // Load the ADPCM codeBook, unless the samples are already decoded
+            if (((sample->codec == CODEC_ADPCM) || (sample->codec == CODEC_SMALL_ADPCM)) && !isPcmCacheHit) {
                 if (gAudioCtx.adpcmCodeBook != sample->book->codeBook) {
                     u32 numEntries;
 
@@ -1152,7 +1268,7 @@ Acmd* AudioSynth_ProcessSample(s32 noteIndex, NoteSampleState* sampleState, Note
                 }
 
                 // Move the compressed raw sample data from ram into the rsp (DMEM)
-                if (numFramesToDecode != 0) {
+                if ((numFramesToDecode != 0) && !isPcmCacheHit) {
                     // Get the offset from the start of the sample to where the sample is currently playing from
                     frameIndex = (synthState->samplePosInt + skipInitialSamples - numFirstFrameSamplesToIgnore) /
                                  SAMPLES_PER_FRAME;
@@ -1187,7 +1303,7 @@ Acmd* AudioSynth_ProcessSample(s32 noteIndex, NoteSampleState* sampleState, Note
                     sampleDataDmemAddr = DMEM_COMPRESSED_ADPCM_DATA - sampleDataChunkSize;
                     aLoadBuffer(cmd++, samplesToLoadAddr - sampleDataChunkAlignPad, sampleDataDmemAddr,
                                 sampleDataChunkSize);
-                } else {
+                } else if (numFramesToDecode == 0) {
                     numSamplesToDecode = 0;
                     sampleDataChunkAlignPad = 0;
                 }
@@ -1210,38 +1326,54 @@ Acmd* AudioSynth_ProcessSample(s32 noteIndex, NoteSampleState* sampleState, Note
 
                 // Decompress the raw sample chunks in the rsp
                 // Goes from adpcm (compressed) sample data to pcm (uncompressed) sample data
-                switch (sample->codec) {
-                    case CODEC_ADPCM:
-                        sampleDataChunkSize = ALIGN16((numFramesToDecode * frameSize) + SAMPLES_PER_FRAME);
-                        sampleDataDmemAddr = DMEM_COMPRESSED_ADPCM_DATA - sampleDataChunkSize;
-                        aSetBuffer(cmd++, 0, sampleDataDmemAddr + sampleDataChunkAlignPad,
-                                   DMEM_UNCOMPRESSED_NOTE + dmemUncompressedAddrOffset2,
-                                   numSamplesToDecode * SAMPLE_SIZE);
-                        aADPCMdec(cmd++, flags, synthState->synthesisBuffers->adpcmState);
-                        break;
+                if (isPcmCacheHit) {
+                    // Load the same frames the decode would write, starting with the last frame of the previous one
+                    frameIndex = (synthState->samplePosInt + skipInitialSamples - numFirstFrameSamplesToIgnore) /
+                                 SAMPLES_PER_FRAME;
+                    AudioSynth_LoadBuffer(cmd++, DMEM_UNCOMPRESSED_NOTE + dmemUncompressedAddrOffset2,
+                                          (numFramesToDecode + 1) * SAMPLES_PER_FRAME * SAMPLE_SIZE,
+                                          &gAudioPcmCache.pcm[(pcmCacheEntry->offset / SAMPLE_SIZE) +
+                                                              (frameIndex * SAMPLES_PER_FRAME)]);
+                } else {
+                    switch (sample->codec) {
+                        case CODEC_ADPCM:
+                            sampleDataChunkSize = ALIGN16((numFramesToDecode * frameSize) + SAMPLES_PER_FRAME);
+                            sampleDataDmemAddr = DMEM_COMPRESSED_ADPCM_DATA - sampleDataChunkSize;
+                            aSetBuffer(cmd++, 0, sampleDataDmemAddr + sampleDataChunkAlignPad,
+                                       DMEM_UNCOMPRESSED_NOTE + dmemUncompressedAddrOffset2,
+                                       numSamplesToDecode * SAMPLE_SIZE);
+                            aADPCMdec(cmd++, flags, synthState->synthesisBuffers->adpcmState);
+                            break;
 
-                    case CODEC_SMALL_ADPCM:
-                        sampleDataChunkSize = ALIGN16((numFramesToDecode * frameSize) + SAMPLES_PER_FRAME);
-                        sampleDataDmemAddr = DMEM_COMPRESSED_ADPCM_DATA - sampleDataChunkSize;
-                        aSetBuffer(cmd++, 0, sampleDataDmemAddr + sampleDataChunkAlignPad,
-                                   DMEM_UNCOMPRESSED_NOTE + dmemUncompressedAddrOffset2,
-                                   numSamplesToDecode * SAMPLE_SIZE);
-                        aADPCMdec(cmd++, flags | A_ADPCM_SHORT, synthState->synthesisBuffers->adpcmState);
-                        break;
+                        case CODEC_SMALL_ADPCM:
+                            sampleDataChunkSize = ALIGN16((numFramesToDecode * frameSize) + SAMPLES_PER_FRAME);
+                            sampleDataDmemAddr = DMEM_COMPRESSED_ADPCM_DATA - sampleDataChunkSize;
+                            aSetBuffer(cmd++, 0, sampleDataDmemAddr + sampleDataChunkAlignPad,
+                                       DMEM_UNCOMPRESSED_NOTE + dmemUncompressedAddrOffset2,
+                                       numSamplesToDecode * SAMPLE_SIZE);
+                            aADPCMdec(cmd++, flags | A_ADPCM_SHORT, synthState->synthesisBuffers->adpcmState);
+                            break;
 
-                    case CODEC_S8:
-                        sampleDataChunkSize = ALIGN16((numFramesToDecode * frameSize) + SAMPLES_PER_FRAME);
-                        sampleDataDmemAddr = DMEM_COMPRESSED_ADPCM_DATA - sampleDataChunkSize;
-                        AudioSynth_SetBuffer(cmd++, 0, sampleDataDmemAddr + sampleDataChunkAlignPad,
-                                             DMEM_UNCOMPRESSED_NOTE + dmemUncompressedAddrOffset2,
-                                             numSamplesToDecode * SAMPLE_SIZE);
-                        AudioSynth_S8Dec(cmd++, flags, synthState->synthesisBuffers->adpcmState);
-                        break;
+                        case CODEC_S8:
+                            sampleDataChunkSize = ALIGN16((numFramesToDecode * frameSize) + SAMPLES_PER_FRAME);
+                            sampleDataDmemAddr = DMEM_COMPRESSED_ADPCM_DATA - sampleDataChunkSize;
+                            AudioSynth_SetBuffer(cmd++, 0, sampleDataDmemAddr + sampleDataChunkAlignPad,
+                                                 DMEM_UNCOMPRESSED_NOTE + dmemUncompressedAddrOffset2,
+                                                 numSamplesToDecode * SAMPLE_SIZE);
+                            AudioSynth_S8Dec(cmd++, flags, synthState->synthesisBuffers->adpcmState);
+                            break;
 
-                    case CODEC_UNK7:
-                    default:
-                        // No decompression
-                        break;
+                        case CODEC_UNK7:
+                        default:
+                            // No decompression
+                            break;
+                    }
+
+                    if (pcmCacheEntry != NULL) {
+                        cmd = AudioSynth_FillPcmCache(cmd, pcmCacheEntry,
+                                                      DMEM_UNCOMPRESSED_NOTE + dmemUncompressedAddrOffset2, frameIndex,
+                                                      numFramesToDecode);
+                    }
                 }
 
                 if (numSamplesProcessed != 0) {
@@ -14,6 +14,26 @@ void AudioThread_ProcessSeqPlayerCmd(SequencePlayer* seqPlayer, AudioCmd* cmd);
 void AudioThread_ProcessChannelCmd(SequenceChannel* channel, AudioCmd* cmd);
 s32 AudioThread_GetSamplePos(s32 seqPlayerIndex, s32 channelIndex, s32 layerIndex, s32* loopEnd, s32* samplePosInt);
 s32 AudioThread_CountAndReleaseNotes(s32 flags);
+void AudioThread_ClearCmdCoalescing(void);
+s32 AudioThread_GetEnabledSampledNotesCount(void);
+void AudioThread_BeginFrameProfile(void);
+void AudioThread_EndFrameProfile(s32 numAbiCmds);
+
+// Slot + 1 of the unpublished command last queued for each coalescible channel command, see `AudioThread_QueueCmd`
+u8 sThreadCmdCoalesceSlots[3 * SEQ_PLAYER_MAX * SEQ_NUM_CHANNELS];
+u8 sThreadCmdCoalesceKeys[3 * SEQ_PLAYER_MAX * SEQ_NUM_CHANNELS];
+s32 sThreadCmdNumCoalesceKeys;
+// Position of the next command the audio thread will process
+u8 sCurCmdRdPos;
+AudioCmdQueueStats gAudioCmdQueueStats;
+// Ring of the last frames timed by `AudioThread_UpdateImpl`, see `AudioThread_GetFrameProfile`
+AudioFrameProfile sAudioFrameProfiles[AUDIO_PROFILE_FRAME_COUNT];
+AudioFrameProfile sCurAudioFrameProfile;
+u32 sNumAudioFrameProfiles;
+OSTime sAudioFrameProfileStart;
+OSTime sAudioProfileStageStart;
+u8 sAudioProfileStages[AUDIO_PROFILE_MAX_DEPTH];
+s32 sAudioProfileDepth;
 
 AudioTask* AudioThread_Update(void) {
     return AudioThread_UpdateImpl();
@@ -47,6 +67,7 @@ AudioTask* AudioThread_UpdateImpl(void) {
         return NULL;
     }
 
+    AudioThread_BeginFrameProfile();
     osSendMesg(gAudioCtx.taskStartQueueP, gAudioCtx.totalTaskCount, OS_MESG_NOBLOCK);
     gAudioCtx.rspTaskIndex ^= 1;
     gAudioCtx.curAiBufferIndex++;
@@ -68,6 +89,7 @@ AudioTask* AudioThread_UpdateImpl(void) {
         gAudioCustomUpdateFunction();
     }
 
+    AudioThread_BeginProfileStage(AUDIO_PROFILE_STAGE_DMA_WAIT);
     dmaCount = gAudioCtx.curAudioFrameDmaCount;
     for (i = 0; i < gAudioCtx.curAudioFrameDmaCount; i++) {
         if (osRecvMesg(&gAudioCtx.curAudioFrameDmaQueue, NULL, OS_MESG_NOBLOCK) == 0) {
@@ -88,10 +110,14 @@ AudioTask* AudioThread_UpdateImpl(void) {
         }
     }
 
+    AudioThread_EndProfileStage();
+
     gAudioCtx.curAudioFrameDmaCount = 0;
+    AudioThread_BeginProfileStage(AUDIO_PROFILE_STAGE_LOADS);
     AudioLoad_DecreaseSampleDmaTtls();
     AudioLoad_ProcessLoads(gAudioCtx.resetStatus);
     AudioLoad_ProcessScriptLoads();
+    AudioThread_EndProfileStage();
 
     if (gAudioCtx.resetStatus != 0) {
         if (AudioHeap_ResetStep() == 0) {
@@ -132,6 +158,7 @@ AudioTask* AudioThread_UpdateImpl(void) {
     }
 
     j = 0;
+    AudioThread_BeginProfileStage(AUDIO_PROFILE_STAGE_CMDS);
     if (gAudioCtx.resetStatus == 0) {
         // msg = 0000RREE R = read pos, E = End Pos
         while (osRecvMesg(gAudioCtx.threadCmdProcQueueP, (OSMesg*)&msg, OS_MESG_NOBLOCK) != -1) {
@@ -144,13 +171,16 @@ AudioTask* AudioThread_UpdateImpl(void) {
             AudioThread_ScheduleProcessCmds();
         }
     }
+    AudioThread_EndProfileStage();
 
     if (gAudioSPDataPtr == (u64*)gAudioCtx.curAbiCmdBuf) {
         return -1;
     }
 
+    AudioThread_BeginProfileStage(AUDIO_PROFILE_STAGE_SYNTH);
     gAudioCtx.curAbiCmdBuf =
         AudioSynth_Update(gAudioCtx.curAbiCmdBuf, &numAbiCmds, curAiBuffer, gAudioCtx.numSamplesPerFrame[index]);
+    AudioThread_EndProfileStage();
 
     // Update audioRandom to the next random number
     gAudioCtx.audioRandom = (gAudioCtx.audioRandom + gAudioCtx.totalTaskCount) * osGetCount();
@@ -187,6 +217,7 @@ AudioTask* AudioThread_UpdateImpl(void) {
     if (gAudioCtx.numAbiCmdsMax < numAbiCmds) {
         gAudioCtx.numAbiCmdsMax = numAbiCmds;
     }
+    AudioThread_EndFrameProfile(numAbiCmds);
 
     if (gAudioCtx.audioBufferParameters.specUnk4 == 1) {
         return gAudioCtx.curTask;
@@ -343,6 +374,10 @@ void AudioThread_ProcessGlobalCmd(AudioCmd* cmd) {
             AudioHeap_SetReverbData(cmd->arg1, cmd->arg0, cmd->asInt, false);
             break;
 
+        case AUDIOCMD_OP_GLOBAL_SET_SAMPLE_PREFETCH_TICKS:
+            gSamplePrefetchTicks = cmd->asInt;
+            break;
+
         default:
             break;
     }
@@ -376,6 +411,8 @@ void AudioThread_SetFadeInTimer(s32 seqPlayerIndex, s32 fadeTimer) {
 void AudioThread_InitMesgQueuesInternal(void) {
     gAudioCtx.threadCmdWritePos = 0;
     gAudioCtx.threadCmdReadPos = 0;
+    sCurCmdRdPos = 0;
+    AudioThread_ClearCmdCoalescing();
     gAudioCtx.threadCmdQueueFinished = false;
 
     gAudioCtx.taskStartQueueP = &gAudioCtx.taskStartQueue;
@@ -388,16 +425,89 @@ void AudioThread_InitMesgQueuesInternal(void) {
     osCreateMesgQueue(gAudioCtx.audioResetQueueP, gAudioCtx.audioResetMesgs, ARRAY_COUNT(gAudioCtx.audioResetMesgs));
 }
 
+/**
+ * Volume and frequency updates to a single channel only set a field of that channel, so a later update can replace an
+ * earlier one that is still unpublished as long as no other kind of command was queued in between.
+ * returns the index of the command's entry in `sThreadCmdCoalesceSlots`, or -1 if it cannot be coalesced
+ */
+s32 AudioThread_GetCmdCoalesceKey(u32 opArgs) {
+    s32 op = (opArgs >> 24) & 0xFF;
+    s32 seqPlayerIndex = (opArgs >> 16) & 0xFF;
+    s32 channelIndex = (opArgs >> 8) & 0xFF;
+    s32 field;
+
+    switch (op) {
+        case AUDIOCMD_OP_CHANNEL_SET_VOL_SCALE:
+            field = 0;
+            break;
+
+        case AUDIOCMD_OP_CHANNEL_SET_VOL:
+            field = 1;
+            break;
+
+        case AUDIOCMD_OP_CHANNEL_SET_FREQ_SCALE:
+            field = 2;
+            break;
+
+        default:
+            return -1;
+    }
+
+    // Commands to every channel depend on `threadCmdChannelMask`, so they are never coalesced
+    if ((seqPlayerIndex >= SEQ_PLAYER_MAX) || (channelIndex >= SEQ_NUM_CHANNELS)) {
+        return -1;
+    }
+
+    return (field * SEQ_PLAYER_MAX + seqPlayerIndex) * SEQ_NUM_CHANNELS + channelIndex;
+}
+
+void AudioThread_ClearCmdCoalescing(void) {
+    while (sThreadCmdNumCoalesceKeys != 0) {
+        sThreadCmdCoalesceSlots[sThreadCmdCoalesceKeys[--sThreadCmdNumCoalesceKeys]] = 0;
+    }
+}
+
 void AudioThread_QueueCmd(u32 opArgs, void** data) {
-    AudioCmd* cmd = &gAudioCtx.threadCmdBuf[gAudioCtx.threadCmdWritePos & 0xFF];
+    AudioCmd* cmd;
+    s32 key = AudioThread_GetCmdCoalesceKey(opArgs);
+    u8 numPending;
+    u8 slot;
+
+    if (key < 0) {
+        AudioThread_ClearCmdCoalescing();
+    } else {
+        // Read once, the audio thread clears the slots when it publishes the queue after a stop command. The command
+        // it published is not processed before its next frame, so updating it here is still in time
+        slot = sThreadCmdCoalesceSlots[key];
+        if (slot != 0) {
+            gAudioCtx.threadCmdBuf[slot - 1].data = *data;
+            gAudioCmdQueueStats.coalesced++;
+            return;
+        }
+    }
+
+    if ((u8)(gAudioCtx.threadCmdWritePos + 1) == sCurCmdRdPos) {
+        // The next slot still holds a command the audio thread has not processed
+        gAudioCmdQueueStats.dropped++;
+        return;
+    }
+
+    cmd = &gAudioCtx.threadCmdBuf[gAudioCtx.threadCmdWritePos & 0xFF];
 
     cmd->opArgs = opArgs;
     cmd->data = *data;
 
+    if (key >= 0) {
+        sThreadCmdCoalesceSlots[key] = (gAudioCtx.threadCmdWritePos & 0xFF) + 1;
+        sThreadCmdCoalesceKeys[sThreadCmdNumCoalesceKeys++] = key;
+    }
+
     gAudioCtx.threadCmdWritePos++;
 
-    if (gAudioCtx.threadCmdWritePos == gAudioCtx.threadCmdReadPos) {
-        gAudioCtx.threadCmdWritePos--;
+    gAudioCmdQueueStats.queued++;
+    numPending = gAudioCtx.threadCmdWritePos - sCurCmdRdPos;
+    if (gAudioCmdQueueStats.maxPending < numPending) {
+        gAudioCmdQueueStats.maxPending = numPending;
     }
 }
 
@@ -434,8 +544,10 @@ s32 AudioThread_ScheduleProcessCmds(void) {
                      OS_MESG_NOBLOCK);
     if (ret != -1) {
         gAudioCtx.threadCmdReadPos = gAudioCtx.threadCmdWritePos;
+        AudioThread_ClearCmdCoalescing();
         ret = 0;
     } else {
+        gAudioCmdQueueStats.publishFailures++;
         return -1;
     }
 
@@ -445,6 +557,14 @@ s32 AudioThread_ScheduleProcessCmds(void) {
 void AudioThread_ResetCmdQueue(void) {
     gAudioCtx.threadCmdQueueFinished = false;
     gAudioCtx.threadCmdReadPos = gAudioCtx.threadCmdWritePos;
+    AudioThread_ClearCmdCoalescing();
+}
+
+/**
+ * returns how many more commands can be queued before the audio thread processes any
+ */
+s32 AudioThread_GetCmdQueueFreeSpace(void) {
+    return (u8)(sCurCmdRdPos - gAudioCtx.threadCmdWritePos - 1);
 }
 
 void AudioThread_ProcessCmd(AudioCmd* cmd) {
@@ -487,7 +607,6 @@ void AudioThread_ProcessCmd(AudioCmd* cmd) {
 }
 
 void AudioThread_ProcessCmds(u32 msg) {
-    static u8 sCurCmdRdPos = 0;
     AudioCmd* cmd;
     u8 endPos;
 
@@ -605,6 +724,150 @@ s8 AudioThread_GetSeqPlayerIO(s32 seqPlayerIndex, s32 ioPort) {
     return gAudioCtx.seqPlayers[seqPlayerIndex].seqScriptIO[ioPort];
 }
 
+/**
+ * Debug accessor for the sample DMA buffer lookup counters, cleared whenever the buffers are reallocated
+ */
+SampleDmaCacheStats* AudioThread_GetSampleDmaCacheStats(void) {
+    return &gSampleDmaCacheStats;
+}
+
+/**
+ * Debug accessor for the seq, font and sample bank cache counters of `tableType`, kept since boot
+ * returns NULL if `tableType` is not a `SampleBankTableType`
+ */
+AudioCacheStats* AudioThread_GetAudioCacheStats(s32 tableType) {
+    if ((tableType < SEQUENCE_TABLE) || (tableType >= ARRAY_COUNT(gAudioCacheStats))) {
+        return NULL;
+    }
+    return &gAudioCacheStats[tableType];
+}
+
+/**
+ * Debug accessor for the command queue counters, kept since boot
+ */
+AudioCmdQueueStats* AudioThread_GetCmdQueueStats(void) {
+    return &gAudioCmdQueueStats;
+}
+
+/**
+ * Debug accessor for the decoded sample cache counters, kept since boot
+ */
+AudioPcmCacheStats* AudioThread_GetPcmCacheStats(void) {
+    return &gAudioPcmCacheStats;
+}
+
+/**
+ * Debug toggle for the decoded sample cache, to compare the cost of synthesis with and without it.
+ * Only affects notes started afterwards
+ */
+void AudioThread_SetPcmCacheEnabled(s32 isEnabled) {
+    gAudioPcmCache.isDisabled = !isEnabled;
+}
+
+/**
+ * Starts timing a frame. Frames that end without building a task, such as during a reset, are not recorded
+ */
+void AudioThread_BeginFrameProfile(void) {
+    s32 i;
+
+    sCurAudioFrameProfile.frame = gAudioCtx.totalTaskCount;
+    for (i = 0; i < AUDIO_PROFILE_STAGE_MAX; i++) {
+        sCurAudioFrameProfile.stageTimes[i] = 0;
+    }
+    sCurAudioFrameProfile.dmaBytes = 0;
+    sAudioProfileDepth = 0;
+    sAudioFrameProfileStart = osGetTime();
+}
+
+void AudioThread_EndFrameProfile(s32 numAbiCmds) {
+    AudioFrameProfile* profile = &sAudioFrameProfiles[sNumAudioFrameProfiles % AUDIO_PROFILE_FRAME_COUNT];
+
+    sCurAudioFrameProfile.totalTime = osGetTime() - sAudioFrameProfileStart;
+    sCurAudioFrameProfile.numAbiCmds = numAbiCmds;
+    sCurAudioFrameProfile.numActiveNotes = AudioThread_GetEnabledNotesCount();
+    sCurAudioFrameProfile.numSampledNotes = AudioThread_GetEnabledSampledNotesCount();
+    *profile = sCurAudioFrameProfile;
+    sNumAudioFrameProfiles++;
+}
+
+/**
+ * Charges the time since the last stage change to the current stage and enters `stage`.
+ * Stages may nest, the outer stage is paused until the matching `AudioThread_EndProfileStage`
+ */
+void AudioThread_BeginProfileStage(s32 stage) {
+    OSTime time = osGetTime();
+
+    if ((sAudioProfileDepth > 0) && (sAudioProfileDepth <= AUDIO_PROFILE_MAX_DEPTH)) {
+        sCurAudioFrameProfile.stageTimes[sAudioProfileStages[sAudioProfileDepth - 1]] +=
+            time - sAudioProfileStageStart;
+    }
+    if (sAudioProfileDepth < AUDIO_PROFILE_MAX_DEPTH) {
+        sAudioProfileStages[sAudioProfileDepth] = stage;
+    }
+    sAudioProfileDepth++;
+    sAudioProfileStageStart = time;
+}
+
+void AudioThread_EndProfileStage(void) {
+    OSTime time = osGetTime();
+
+    if (sAudioProfileDepth <= 0) {
+        return;
+    }
+
+    sAudioProfileDepth--;
+    if (sAudioProfileDepth < AUDIO_PROFILE_MAX_DEPTH) {
+        sCurAudioFrameProfile.stageTimes[sAudioProfileStages[sAudioProfileDepth]] += time - sAudioProfileStageStart;
+    }
+    sAudioProfileStageStart = time;
+}
+
+void AudioThread_AddProfileDmaBytes(size_t size) {
+    sCurAudioFrameProfile.dmaBytes += size;
+}
+
+/**
+ * Debug accessor for the timings of a recent frame, 0 being the last one recorded
+ * returns NULL if fewer frames than that were recorded, or if they have left the ring
+ */
+AudioFrameProfile* AudioThread_GetFrameProfile(s32 framesAgo) {
+    if ((framesAgo < 0) || (framesAgo >= AUDIO_PROFILE_FRAME_COUNT) || ((u32)framesAgo >= sNumAudioFrameProfiles)) {
+        return NULL;
+    }
+    return &sAudioFrameProfiles[(sNumAudioFrameProfiles - 1 - framesAgo) % AUDIO_PROFILE_FRAME_COUNT];
+}
+
+/**
+ * Writes the recorded frames to `buf` as CSV with a header line, oldest first. Frames that would not fit in `bufSize`
+ * are left out. Meant for a debug overlay or a host tool, the audio thread may update the ring while it is read
+ * returns the length of the text written
+ */
+s32 AudioThread_WriteFrameProfileCsv(char* buf, s32 bufSize) {
+    AudioFrameProfile* profile;
+    s32 len;
+    s32 i;
+
+    if (bufSize < AUDIO_PROFILE_CSV_LINE_MAX) {
+        return 0;
+    }
+
+    len = sprintf(buf, "frame,total,dmaWait,loads,cmds,sequences,notes,synth,dmaBytes,abiCmds,activeNotes,"
+                       "sampledNotes\n");
+    for (i = AUDIO_PROFILE_FRAME_COUNT - 1; i >= 0; i--) {
+        profile = AudioThread_GetFrameProfile(i);
+        if ((profile == NULL) || ((bufSize - len) < AUDIO_PROFILE_CSV_LINE_MAX)) {
+            continue;
+        }
+        len += sprintf(&buf[len], "%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n", profile->frame, profile->totalTime,
+                       profile->stageTimes[AUDIO_PROFILE_STAGE_DMA_WAIT], profile->stageTimes[AUDIO_PROFILE_STAGE_LOADS],
+                       profile->stageTimes[AUDIO_PROFILE_STAGE_CMDS],
+                       profile->stageTimes[AUDIO_PROFILE_STAGE_SEQUENCES],
+                       profile->stageTimes[AUDIO_PROFILE_STAGE_NOTES], profile->stageTimes[AUDIO_PROFILE_STAGE_SYNTH],
+                       profile->dmaBytes, profile->numAbiCmds, profile->numActiveNotes, profile->numSampledNotes);
+    }
+    return len;
+}
+
 // Unused
 void AudioThread_InitExternalPool(void* addr, size_t size) {
     AudioHeap_InitPool(&gAudioCtx.externalPool, addr, size);
@@ -12,6 +12,7 @@
 #include "libc/alloca.h"
 #include "libc/stdbool.h"
 #include "color.h"
+#include "fault.h"
 #include "macros.h"
 #include "slowly.h"
 #include "stack.h"
@@ -522,27 +523,206 @@ void PreRender_AntiAliasFilterPixel(PreRender* this, s32 x, s32 y) {
     this->fbufSave[x + y * this->width] = pxOut.rgba;
 }
 
+#define PRERENDER_5B_TO_8B(v) (((v) << 3) | ((v) >> 2))
+
+/**
+ * Same as `PreRender_AntiAliasFilterPixel` for a partially covered pixel at least 2 pixels away from the left and right
+ * edges and 1 pixel away from the top and bottom edges, so its neighborhood needs no clamping.
+ *
+ * The search in `PreRender_AntiAliasFilterPixel` only samples the fully covered neighbors at odd indices of the 5x3
+ * neighborhood, as the center is never fully covered. The penultimate maximum it finds is the second largest of them
+ * if there are at least two, or the center if that is larger, and likewise for the minimum. Those are tracked in one
+ * pass over the 5-bit values, which order the same way as their 8-bit expansions.
+ *
+ * @param this             PreRender instance
+ * @param x                Center pixel x
+ * @param y                Center pixel y
+ * @param neighborOffsets  Offsets from the center pixel to the neighbors at (-1,-1), (1,-1), (-2,0), (2,0), (-1,1)
+ *                         and (1,1)
+ */
+void PreRender_AntiAliasFilterInnerPixel(PreRender* this, s32 x, s32 y, s32* neighborOffsets) {
+    u16* px = &this->fbufSave[x + y * this->width];
+    u8* cvg = &this->cvgSave[x + y * this->width];
+    s32 center[3];
+    s32 val[3];
+    s32 max[3][2]; // Largest and second largest fully covered neighbor of each channel
+    s32 min[3][2]; // Smallest and second smallest
+    s32 numFull = 0;
+    s32 pmax;
+    s32 pmin;
+    s32 temp;
+    s32 i;
+    s32 c;
+    Color_RGBA16 pxIn;
+    Color_RGBA16 pxOut;
+    u32 out[3];
+
+    pxIn.rgba = px[0];
+    center[0] = pxIn.r;
+    center[1] = pxIn.g;
+    center[2] = pxIn.b;
+
+    for (c = 0; c < 3; c++) {
+        max[c][0] = max[c][1] = -1;
+        min[c][0] = min[c][1] = 32;
+    }
+
+    for (i = 0; i < 6; i++) {
+        if ((cvg[neighborOffsets[i]] >> 5) != 7) {
+            continue;
+        }
+
+        numFull++;
+        pxIn.rgba = px[neighborOffsets[i]];
+        val[0] = pxIn.r;
+        val[1] = pxIn.g;
+        val[2] = pxIn.b;
+
+        for (c = 0; c < 3; c++) {
+            if (val[c] > max[c][0]) {
+                max[c][1] = max[c][0];
+                max[c][0] = val[c];
+            } else if (val[c] > max[c][1]) {
+                max[c][1] = val[c];
+            }
+            if (val[c] < min[c][0]) {
+                min[c][1] = min[c][0];
+                min[c][0] = val[c];
+            } else if (val[c] < min[c][1]) {
+                min[c][1] = val[c];
+            }
+        }
+    }
+
+    // OutputColor = cvg * ForeGround + (1.0 - cvg) * BackGround, as in `PreRender_AntiAliasFilterPixel`
+    temp = 7 - (cvg[0] >> 5);
+    for (c = 0; c < 3; c++) {
+        pmax = pmin = center[c];
+        if (numFull >= 2) {
+            if (max[c][1] > pmax) {
+                pmax = max[c][1];
+            }
+            if (min[c][1] < pmin) {
+                pmin = min[c][1];
+            }
+        }
+
+        pmax = PRERENDER_5B_TO_8B(pmax);
+        pmin = PRERENDER_5B_TO_8B(pmin);
+        val[c] = PRERENDER_5B_TO_8B(center[c]);
+        out[c] = val[c] + ((s32)(temp * (pmax + pmin - (val[c] * 2)) + 4) >> 3);
+    }
+
+    pxOut.r = out[0] >> 3;
+    pxOut.g = out[1] >> 3;
+    pxOut.b = out[2] >> 3;
+    pxOut.a = 1;
+    px[0] = pxOut.rgba;
+}
+
+/**
+ * Applies the Video Interface anti-aliasing filter to row `y` of `this->fbufSave`. Rows must be filtered in order, as
+ * pixels are filtered in place and later pixels see the filtered earlier ones
+ */
+void PreRender_AntiAliasFilterRow(PreRender* this, s32 y) {
+    s32 width = this->width;
+    s32 height = this->height;
+    s32 neighborOffsets[6];
+    u8* cvgRow = &this->cvgSave[y * width];
+    s32 x = 0;
+
+    neighborOffsets[0] = -1 - width;
+    neighborOffsets[1] = 1 - width;
+    neighborOffsets[2] = -2;
+    neighborOffsets[3] = 2;
+    neighborOffsets[4] = -1 + width;
+    neighborOffsets[5] = 1 + width;
+
+    while (x < width) {
+        // Skip runs of fully covered pixels four at a time, where the coverage is word aligned
+        if ((((uintptr_t)&cvgRow[x] % 4) == 0) && ((x + 4) <= width) &&
+            ((*(u32*)&cvgRow[x] & 0xE0E0E0E0) == 0xE0E0E0E0)) {
+            x += 4;
+            continue;
+        }
+
+        if ((cvgRow[x] >> 5) != 7) {
+            // If this pixel has only partial coverage, perform the Video Filter interpolation on it
+            if ((y > 0) && (y < (height - 1)) && (x >= 2) && (x < (width - 2))) {
+                PreRender_AntiAliasFilterInnerPixel(this, x, y, neighborOffsets);
+            } else {
+                PreRender_AntiAliasFilterPixel(this, x, y);
+            }
+        }
+        x++;
+    }
+}
+
 /**
  * Applies the Video Interface anti-aliasing filter to `this->fbufSave` using `this->cvgSave`
  */
 void PreRender_AntiAliasFilter(PreRender* this) {
-    s32 x;
     s32 y;
-    s32 cvg;
 
     // Apply AA filter
     for (y = 0; y < this->height; y++) {
-        for (x = 0; x < this->width; x++) {
-            cvg = this->cvgSave[x + y * this->width];
-            cvg >>= 5;
-            cvg++;
+        PreRender_AntiAliasFilterRow(this, y);
+    }
+}
 
-            if (cvg != 8) {
-                // If this pixel has only partial coverage, perform the Video Filter interpolation on it
-                PreRender_AntiAliasFilterPixel(this, x, y);
-            }
-        }
+u32 PreRender_Median3(u32 a, u32 b, u32 c) {
+    if (a > b) {
+        u32 temp = a;
+
+        a = b;
+        b = temp;
     }
+    // a <= b, so the median is b clamped to [a, c] or c clamped to [a, b]
+    if (c < b) {
+        return (c > a) ? c : a;
+    }
+    return b;
+}
+
+/**
+ * Writes column `x` of the three rows to `sorted`, in ascending order
+ */
+void PreRender_Sort5bColumn(u8** rows, s32 x, u8* sorted) {
+    u8 a = rows[0][x];
+    u8 b = rows[1][x];
+    u8 c = rows[2][x];
+    u8 temp;
+
+    if (a > b) {
+        temp = a;
+        a = b;
+        b = temp;
+    }
+    if (b > c) {
+        temp = b;
+        b = c;
+        c = temp;
+    }
+    if (a > b) {
+        temp = a;
+        a = b;
+        b = temp;
+    }
+
+    sorted[0] = a;
+    sorted[1] = b;
+    sorted[2] = c;
+}
+
+/**
+ * Selects the median value of 9 values given as three sorted groups of 3. It is the median of the largest of the low
+ * values, the median of the middle values and the smallest of the high values
+ */
+u32 PreRender_Get5bMedian9Sorted(u8* sorted0, u8* sorted1, u8* sorted2) {
+    u32 maxLow = MAX(MAX(sorted0[0], sorted1[0]), sorted2[0]);
+    u32 minHigh = MIN(MIN(sorted0[2], sorted1[2]), sorted2[2]);
+
+    return PreRender_Median3(maxLow, PreRender_Median3(sorted0[1], sorted1[1], sorted2[1]), minHigh);
 }
 
 /**
@@ -551,138 +731,143 @@ void PreRender_AntiAliasFilter(PreRender* this) {
  * all args are expected to be an array of 3 different 5-bit values
  */
 u32 PreRender_Get5bMedian9(u8* px1, u8* px2, u8* px3) {
-    u8 pxValCount[32]; // Stores the count for each of the possible 32 5-bit pixel values
-    u32 pxCount;       // Pixel count
-    s32 pxMed;         // Pixel median value
-
-    // Initialize count to 0 in groups of 4 bits
-    *(s32*)(&pxValCount[0]) = 0;
-    *(s32*)(&pxValCount[4]) = 0;
-    *(s32*)(&pxValCount[8]) = 0;
-    *(s32*)(&pxValCount[12]) = 0;
-    *(s32*)(&pxValCount[16]) = 0;
-    *(s32*)(&pxValCount[20]) = 0;
-    *(s32*)(&pxValCount[24]) = 0;
-    *(s32*)(&pxValCount[28]) = 0;
-
-    // Increment the count that contains the pixel values
-    pxValCount[px1[0]]++;
-    pxValCount[px1[1]]++;
-    pxValCount[px1[2]]++;
-
-    pxValCount[px2[0]]++;
-    pxValCount[px2[1]]++;
-    pxValCount[px2[2]]++;
-
-    pxValCount[px3[0]]++;
-    pxValCount[px3[1]]++;
-    pxValCount[px3[2]]++;
-
-    // Loop through the 32 bits until 5 values are found, then return that bit value.
-    // Note that the median of 9 is the 5th sequential value.
-    pxCount = 0;
-    pxMed = 0;
-    while (true) {
-        pxCount += pxValCount[pxMed];
-        if (pxCount >= 5) {
-            // the median is found
-            break;
-        }
-        pxMed++;
+    u8* rows[3];
+    u8 sorted[3][3];
+    s32 i;
+
+    rows[0] = px1;
+    rows[1] = px2;
+    rows[2] = px3;
+
+    // Sort the three values at each index, and select the median of the groups
+    for (i = 0; i < 3; i++) {
+        PreRender_Sort5bColumn(rows, i, sorted[i]);
     }
 
-    return pxMed;
+    return PreRender_Get5bMedian9Sorted(sorted[0], sorted[1], sorted[2]);
 }
 
-// Despite the name, this function doesn't seem like an hardware-accurate divot filter
-void PreRender_DivotFilter(PreRender* this) {
+/**
+ * Points the line buffers of `state` into `buffer`, which must hold `this->width * 10` bytes, and fills them for the
+ * first 2 rows
+ */
+void PreRender_DivotFilterInit(PreRender* this, PreRenderDivotState* state, u8* buffer) {
     u32 width = this->width;
-    u32 height = this->height;
-    u8* buffer = alloca(width * 10);
-    u8* redRow[3];
-    u8* greenRow[3];
-    u8* blueRow[3];
-    u8* cvgFull;
     Color_RGBA16 inPx;
-    Color_RGBA16 outPx;
     u32 x;
     u32 y;
-    s32 pad;
 
-    redRow[0] = &buffer[width * 0];
-    redRow[1] = &buffer[width * 1];
-    redRow[2] = &buffer[width * 2];
+    state->redRow[0] = &buffer[width * 0];
+    state->redRow[1] = &buffer[width * 1];
+    state->redRow[2] = &buffer[width * 2];
 
-    greenRow[0] = &buffer[width * 3];
-    greenRow[1] = &buffer[width * 4];
-    greenRow[2] = &buffer[width * 5];
+    state->greenRow[0] = &buffer[width * 3];
+    state->greenRow[1] = &buffer[width * 4];
+    state->greenRow[2] = &buffer[width * 5];
 
-    blueRow[0] = &buffer[width * 6];
-    blueRow[1] = &buffer[width * 7];
-    blueRow[2] = &buffer[width * 8];
+    state->blueRow[0] = &buffer[width * 6];
+    state->blueRow[1] = &buffer[width * 7];
+    state->blueRow[2] = &buffer[width * 8];
 
-    cvgFull = &buffer[width * 9];
+    state->cvgFull = &buffer[width * 9];
 
     // Fill line buffers for first 2 rows
     for (y = 0; y < 2; y++) {
         for (x = 0; x < width; x++) {
             inPx.rgba = this->fbufSave[x + y * this->width];
 
-            redRow[y][x] = inPx.r;
-            greenRow[y][x] = inPx.g;
-            blueRow[y][x] = inPx.b;
+            state->redRow[y][x] = inPx.r;
+            state->greenRow[y][x] = inPx.g;
+            state->blueRow[y][x] = inPx.b;
         }
     }
+}
 
-    // For each row in the image, except first and last
-    for (y = 1; y < height - 1; y++) {
-        // Find start of pixels and coverage for current line (bug? this should probably be fetching the NEXT line, but
-        // really the divot filter only cares about individual lines so it's already wrong)
-        u8* redRow2 = redRow[2];
-        u8* greenRow2 = greenRow[2];
-        u8* blueRow2 = blueRow[2];
-        u8* lineCvg = &this->cvgSave[width * y];
-        u16* linePx = &this->fbufSave[width * y];
-
-        // Obtain next row from current line, current line becomes the bottom row?? (weird, you would expect this to
-        // sample the NEXT line?)
-        for (x = 0; x < width; x++) {
-            inPx.rgba = linePx[x];
+/**
+ * Applies the divot filter to row `y`, which must be the row after the one last filtered with `state`, starting at 1
+ */
+void PreRender_DivotFilterRow(PreRender* this, PreRenderDivotState* state, u32 y) {
+    u32 width = this->width;
+    u8** redRow = state->redRow;
+    u8** greenRow = state->greenRow;
+    u8** blueRow = state->blueRow;
+    u8* cvgFull = state->cvgFull;
+    // Find start of pixels and coverage for current line (bug? this should probably be fetching the NEXT line, but
+    // really the divot filter only cares about individual lines so it's already wrong)
+    u8* redRow2 = redRow[2];
+    u8* greenRow2 = greenRow[2];
+    u8* blueRow2 = blueRow[2];
+    u8* lineCvg = &this->cvgSave[width * y];
+    u16* linePx = &this->fbufSave[width * y];
+    u8 sortedRed[3][3];
+    u8 sortedGreen[3][3];
+    u8 sortedBlue[3][3];
+    Color_RGBA16 inPx;
+    Color_RGBA16 outPx;
+    u32 x;
+    s32 col;
+    s32 sortedX = -1; // Last column sorted for this row
 
-            redRow2[x] = inPx.r;
-            greenRow2[x] = inPx.g;
-            blueRow2[x] = inPx.b;
+    // Obtain next row from current line, current line becomes the bottom row?? (weird, you would expect this to
+    // sample the NEXT line?)
+    for (x = 0; x < width; x++) {
+        inPx.rgba = linePx[x];
 
-            // checking for full coverage
-            cvgFull[x] = (lineCvg[x] >> 5) == 7;
-        }
+        redRow2[x] = inPx.r;
+        greenRow2[x] = inPx.g;
+        blueRow2[x] = inPx.b;
 
-        for (x = 1; x < width - 1; x++) {
-            // if the coverage of the three adjacent pixels on the current line are not all fully covered
-            if (cvgFull[x - 1] && cvgFull[x] && cvgFull[x + 1]) {
-                continue;
-            }
+        // checking for full coverage
+        cvgFull[x] = (lineCvg[x] >> 5) == 7;
+    }
 
-            // find median value in 3x3 square for each (r,g,b), replaces the pixel marked by X:
-            //  * * *
-            //  * * *
-            //  * X *
-            outPx.r = PreRender_Get5bMedian9(&redRow[0][x - 1], &redRow[1][x - 1], &redRow[2][x - 1]);
-            outPx.g = PreRender_Get5bMedian9(&greenRow[0][x - 1], &greenRow[1][x - 1], &greenRow[2][x - 1]);
-            outPx.b = PreRender_Get5bMedian9(&blueRow[0][x - 1], &blueRow[1][x - 1], &blueRow[2][x - 1]);
-            outPx.a = 1;
+    for (x = 1; x < width - 1; x++) {
+        // if the coverage of the three adjacent pixels on the current line are not all fully covered
+        if (cvgFull[x - 1] && cvgFull[x] && cvgFull[x + 1]) {
+            continue;
+        }
 
-            this->fbufSave[x + y * this->width] = outPx.rgba;
+        // Sort the columns of the 3x3 square that were not already sorted for the previous pixel. Column `col` is
+        // kept in slot `col % 3`, so the slots always hold columns x - 1 to x + 1
+        for (col = MAX((s32)x - 1, sortedX + 1); col <= (s32)x + 1; col++) {
+            PreRender_Sort5bColumn(redRow, col, sortedRed[col % 3]);
+            PreRender_Sort5bColumn(greenRow, col, sortedGreen[col % 3]);
+            PreRender_Sort5bColumn(blueRow, col, sortedBlue[col % 3]);
         }
+        sortedX = x + 1;
+
+        // find median value in 3x3 square for each (r,g,b), replaces the pixel marked by X:
+        //  * * *
+        //  * * *
+        //  * X *
+        outPx.r = PreRender_Get5bMedian9Sorted(sortedRed[0], sortedRed[1], sortedRed[2]);
+        outPx.g = PreRender_Get5bMedian9Sorted(sortedGreen[0], sortedGreen[1], sortedGreen[2]);
+        outPx.b = PreRender_Get5bMedian9Sorted(sortedBlue[0], sortedBlue[1], sortedBlue[2]);
+        outPx.a = 1;
+
+        this->fbufSave[x + y * this->width] = outPx.rgba;
+    }
+
+    // Shuffle row 1 -> 0
+    redRow[0] = redRow[1];
+    greenRow[0] = greenRow[1];
+    blueRow[0] = blueRow[1];
+    // Shuffle row 2 -> 1
+    redRow[1] = redRow[2];
+    greenRow[1] = greenRow[2];
+    blueRow[1] = blueRow[2];
+}
+
+// Despite the name, this function doesn't seem like an hardware-accurate divot filter
+void PreRender_DivotFilter(PreRender* this) {
+    PreRenderDivotState state;
+    u32 y;
+
+    PreRender_DivotFilterInit(this, &state, alloca(this->width * 10));
 
-        // Shuffle row 1 -> 0
-        redRow[0] = redRow[1];
-        greenRow[0] = greenRow[1];
-        blueRow[0] = blueRow[1];
-        // Shuffle row 2 -> 1
-        redRow[1] = redRow[2];
-        greenRow[1] = greenRow[2];
-        blueRow[1] = blueRow[2];
+    // For each row in the image, except first and last
+    for (y = 1; y < this->height - 1; y++) {
+        PreRender_DivotFilterRow(this, &state, y);
     }
 }
 
@@ -705,23 +890,106 @@ s32 sSlowlyRunning;
 StackEntry sSlowlyStackInfo;
 STACK(sSlowlyStack, 0x1000);
 
+// The budgeted filter state is shared, so only one PreRender can be filtered this way at a time
+PreRender* sFilterBudgetedPreRender; // The PreRender being filtered by `PreRender_ApplyFiltersBudgeted`, or NULL
+s32 sFilterRowsDone; // Rows filtered by `PreRender_ApplyFiltersBudgeted`, first by the AA filter then the divot filter
+u8* sFilterDivotBuffer;
+PreRenderDivotState sFilterDivotState;
+
+/**
+ * Stops budgeted filtering started by `PreRender_ApplyFiltersSlowlyInit`, freeing its line buffers
+ */
+void PreRender_ApplyFiltersBudgetedDestroy(PreRender* this) {
+    if (sFilterBudgetedPreRender == this) {
+        ListAlloc_Free(&this->alloc, sFilterDivotBuffer);
+        sFilterDivotBuffer = NULL;
+        sFilterBudgetedPreRender = NULL;
+    }
+}
+
 /**
- * Initializes `PreRender_ApplyFilters` onto a new "slowly" thread
+ * Continues `PreRender_ApplyFilters` one row at a time, until at least `budgetUs` microseconds have been spent or the
+ * filters are done. At least one row is filtered per call. The progress and the time spent are reported in
+ * R_PRERENDER_FILTER_PROGRESS and R_PRERENDER_FILTER_TIME
+ */
+void PreRender_ApplyFiltersBudgeted(PreRender* this, s32 budgetUs) {
+    s32 height = this->height;
+    s32 numDivotRows = (height > 2) ? (height - 2) : 0;
+    s32 numRows = height + numDivotRows;
+    OSTime start = osGetTime();
+    u32 elapsedUs;
+
+    do {
+        if (sFilterRowsDone < height) {
+            PreRender_AntiAliasFilterRow(this, sFilterRowsDone);
+        } else if (sFilterRowsDone < numRows) {
+            if (sFilterRowsDone == height) {
+                PreRender_DivotFilterInit(this, &sFilterDivotState, sFilterDivotBuffer);
+            }
+            PreRender_DivotFilterRow(this, &sFilterDivotState, sFilterRowsDone - height + 1);
+        }
+
+        if (sFilterRowsDone < numRows) {
+            sFilterRowsDone++;
+        }
+        elapsedUs = OS_CYCLES_TO_USEC(osGetTime() - start);
+    } while ((sFilterRowsDone < numRows) && (elapsedUs < (u32)budgetUs));
+
+    R_PRERENDER_FILTER_PROGRESS = (numRows != 0) ? ((sFilterRowsDone * 100) / numRows) : 100;
+    R_PRERENDER_FILTER_TIME = CLAMP_MAX(elapsedUs, 0x7FFF);
+
+    if (sFilterRowsDone >= numRows) {
+        PreRender_ApplyFiltersBudgetedDestroy(this);
+        this->filterState = PRERENDER_FILTER_STATE_DONE;
+    }
+}
+
+/**
+ * Initializes `PreRender_ApplyFilters` onto a new "slowly" thread, or, if R_PRERENDER_FILTER_BUDGET is set, to be
+ * applied by `PreRender_ApplyFiltersSlowlyUpdate` within that many microseconds per frame
  */
 void PreRender_ApplyFiltersSlowlyInit(PreRender* this) {
     if ((this->cvgSave != NULL) && (this->fbufSave != NULL)) {
         if (sSlowlyRunning) {
             StackCheck_Cleanup(&sSlowlyStackInfo);
             Slowly_Destroy(&sSlowlyMgr);
+            sSlowlyRunning = false;
+        }
+        PreRender_ApplyFiltersBudgetedDestroy(this);
+        if (sFilterBudgetedPreRender != NULL) {
+            // Another PreRender is still being filtered
+            Fault_AddHungupAndCrash("../PreRender.c", __LINE__);
         }
 
         this->filterState = PRERENDER_FILTER_STATE_PROCESS;
+
+        if (R_PRERENDER_FILTER_BUDGET > 0) {
+            sFilterDivotBuffer = ListAlloc_Alloc(&this->alloc, this->width * 10);
+            if (sFilterDivotBuffer != NULL) {
+                sFilterRowsDone = 0;
+                R_PRERENDER_FILTER_PROGRESS = 0;
+                R_PRERENDER_FILTER_TIME = 0;
+                sFilterBudgetedPreRender = this;
+                return;
+            }
+        }
+
         StackCheck_Init(&sSlowlyStackInfo, sSlowlyStack, STACK_TOP(sSlowlyStack), 0, 0x100, "slowly");
         Slowly_Init(&sSlowlyMgr, STACK_TOP(sSlowlyStack), (void*)PreRender_ApplyFilters, this, NULL);
         sSlowlyRunning = true;
     }
 }
 
+/**
+ * Filters the next rows of budgeted filtering started by `PreRender_ApplyFiltersSlowlyInit`. Called once per frame
+ * until `this->filterState` is PRERENDER_FILTER_STATE_DONE, does nothing when the filters run on the "slowly" thread
+ */
+void PreRender_ApplyFiltersSlowlyUpdate(PreRender* this) {
+    if (sFilterBudgetedPreRender == this) {
+        PreRender_ApplyFiltersBudgeted(this, R_PRERENDER_FILTER_BUDGET);
+    }
+}
+
 /**
  * Destroys the "slowly" thread
  */
@@ -731,6 +999,7 @@ void PreRender_ApplyFiltersSlowlyDestroy(PreRender* this) {
         Slowly_Destroy(&sSlowlyMgr);
         sSlowlyRunning = false;
     }
+    PreRender_ApplyFiltersBudgetedDestroy(this);
 }
 
 // Unused, likely since `PreRender_ApplyFilters` already handles NULL checks
@@ -9,6 +9,10 @@ FaultClient sGraphFaultClient;
 GfxMasterList* gGfxMasterDL;
 CfbInfo sGraphCfbInfos[3];
 OSTime sGraphTaskStartTime;
+GraphDispUsage sGraphDispUsages[GRAPH_DISP_USAGE_COUNT];
+u32 sNumGraphDispUsages;
+GraphDispStats sGraphDispStats;
+s32 sGraphDispRebalance;
 
 #include "variables.h"
 #include "macros.h"
@@ -34,12 +38,167 @@ void Graph_FaultClient(void) {
     osViSetSpecialFeatures(OS_VI_DITHER_FILTER_ON | OS_VI_GAMMA_OFF);
 }
 
+// Number of Gfx in `GfxPool.dispBuffer` given to the opa, xlu and overlay buffers, see `Graph_RebalanceDisps`
+s32 sGraphDispSizes[GRAPH_DISP_OVERLAY + 1] = {
+    ARRAY_COUNT(gGfxPools[0].polyOpaBuffer),
+    ARRAY_COUNT(gGfxPools[0].polyXluBuffer),
+    ARRAY_COUNT(gGfxPools[0].overlayBuffer),
+};
+
+// An arena is reported as close to full once less than 1 / (1 << GRAPH_DISP_WARN_SHIFT) of it is left
+#define GRAPH_DISP_WARN_SHIFT 3
+// Granularity of the xlu and overlay buffer sizes when rebalanced, in Gfx
+#define GRAPH_DISP_REBALANCE_ALIGN 0x40
+
 void Graph_InitTHGA(TwoHeadGfxArena* arena, Gfx* buffer, s32 size) {
     THGA_Init(arena, buffer, size);
 }
 
+/**
+ * Debug accessor for the display list arena usage of a recent frame, 0 being the last one recorded
+ * returns NULL if fewer frames than that were recorded, or if they have left the ring
+ */
+GraphDispUsage* Graph_GetDispUsage(s32 framesAgo) {
+    if ((framesAgo < 0) || (framesAgo >= GRAPH_DISP_USAGE_COUNT) || ((u32)framesAgo >= sNumGraphDispUsages)) {
+        return NULL;
+    }
+    return &sGraphDispUsages[(sNumGraphDispUsages - 1 - framesAgo) % GRAPH_DISP_USAGE_COUNT];
+}
+
+/**
+ * Debug accessor for the display list arena counters, kept since boot
+ */
+GraphDispStats* Graph_GetDispStats(void) {
+    return &sGraphDispStats;
+}
+
+/**
+ * Debug toggle to let `Graph_RebalanceDisps` move the split between the opa, xlu and overlay buffers.
+ * Disabling it restores the original split. Either takes effect from the next frame
+ */
+void Graph_SetDispRebalance(s32 isEnabled) {
+    sGraphDispRebalance = isEnabled;
+
+    if (!isEnabled) {
+        sGraphDispSizes[GRAPH_DISP_OPA] = ARRAY_COUNT(gGfxPools[0].polyOpaBuffer);
+        sGraphDispSizes[GRAPH_DISP_XLU] = ARRAY_COUNT(gGfxPools[0].polyXluBuffer);
+        sGraphDispSizes[GRAPH_DISP_OVERLAY] = ARRAY_COUNT(gGfxPools[0].overlayBuffer);
+    }
+}
+
+/**
+ * Records how much of each display list arena the frame used, once all of its display lists are closed.
+ * Warns when an arena gets close to full, and when the frame is about to be dropped because one overflowed
+ */
+void Graph_RecordDispUsage(GraphicsContext* gfxCtx) {
+    GraphDispUsage* usage = &sGraphDispUsages[sNumGraphDispUsages % GRAPH_DISP_USAGE_COUNT];
+    GraphDispUsage* prevUsage = Graph_GetDispUsage(0);
+    u8 prevWarnMask = (prevUsage != NULL) ? prevUsage->warnMask : 0;
+    TwoHeadGfxArena* arenas[GRAPH_DISP_MAX];
+    s32 poolIdx = gfxCtx->gfxPoolIdx % 2;
+    s32 i;
+
+    arenas[GRAPH_DISP_OPA] = &gfxCtx->polyOpa;
+    arenas[GRAPH_DISP_XLU] = &gfxCtx->polyXlu;
+    arenas[GRAPH_DISP_OVERLAY] = &gfxCtx->overlay;
+    arenas[GRAPH_DISP_WORK] = &gfxCtx->work;
+    arenas[GRAPH_DISP_DEBUG] = &gfxCtx->debug;
+
+    usage->frame = sNumGraphDispUsages;
+    usage->poolIdx = poolIdx;
+    usage->warnMask = 0;
+    usage->crashMask = 0;
+
+    for (i = 0; i < GRAPH_DISP_MAX; i++) {
+        usage->size[i] = arenas[i]->size;
+        usage->used[i] = arenas[i]->size - THGA_GetRemaining(arenas[i]);
+
+        if (usage->used[i] > sGraphDispStats.highWater[poolIdx][i]) {
+            sGraphDispStats.highWater[poolIdx][i] = usage->used[i];
+        }
+        if (usage->used[i] > usage->size[i] - (usage->size[i] >> GRAPH_DISP_WARN_SHIFT)) {
+            usage->warnMask |= 1 << i;
+        }
+        if (THGA_IsCrash(arenas[i])) {
+            usage->crashMask |= 1 << i;
+        }
+    }
+
+    sNumGraphDispUsages++;
+
+    if (usage->warnMask & ~prevWarnMask) {
+        sGraphDispStats.warnings++;
+        osSyncPrintf("graph.c: display list buffers close to full (opa %d/%d xlu %d/%d overlay %d/%d)\n",
+                     usage->used[GRAPH_DISP_OPA], usage->size[GRAPH_DISP_OPA], usage->used[GRAPH_DISP_XLU],
+                     usage->size[GRAPH_DISP_XLU], usage->used[GRAPH_DISP_OVERLAY], usage->size[GRAPH_DISP_OVERLAY]);
+    }
+    if (usage->crashMask != 0) {
+        sGraphDispStats.droppedFrames++;
+        osSyncPrintf("graph.c: display list buffers overflowed, dropping the frame (mask %x)\n", usage->crashMask);
+    }
+}
+
+/**
+ * Moves the split between the opa, xlu and overlay buffers when enabled with `Graph_SetDispRebalance`. Each buffer
+ * gets the most it used over the recorded frames, and the rest of the space is shared out in proportion to that.
+ * Only done after a frame where one of them got close to full, so the split stays put while they all have room
+ */
+void Graph_RebalanceDisps(void) {
+    GraphDispUsage* usage = Graph_GetDispUsage(0);
+    s32 need[GRAPH_DISP_OVERLAY + 1];
+    s32 total = ARRAY_COUNT(gGfxPools[0].dispBuffer);
+    s32 sum = 0;
+    s32 spare;
+    s32 xluSize;
+    s32 overlaySize;
+    s32 i;
+    s32 j;
+
+    if (!sGraphDispRebalance || (usage == NULL) ||
+        !(usage->warnMask & ((1 << GRAPH_DISP_OPA) | (1 << GRAPH_DISP_XLU) | (1 << GRAPH_DISP_OVERLAY)))) {
+        return;
+    }
+
+    for (i = 0; i <= GRAPH_DISP_OVERLAY; i++) {
+        need[i] = 0;
+        for (j = 0; (usage = Graph_GetDispUsage(j)) != NULL; j++) {
+            need[i] = MAX(need[i], (s32)((usage->used[i] + sizeof(Gfx) - 1) / sizeof(Gfx)));
+        }
+        sum += need[i];
+    }
+
+    if (sum >= total) {
+        // No split fits all of them
+        return;
+    }
+
+    spare = total - sum;
+    xluSize = need[GRAPH_DISP_XLU] + (spare * need[GRAPH_DISP_XLU]) / sum;
+    xluSize = MAX(xluSize, ARRAY_COUNT(gGfxPools[0].polyXluBuffer) / 4);
+    xluSize = (xluSize + GRAPH_DISP_REBALANCE_ALIGN - 1) & ~(GRAPH_DISP_REBALANCE_ALIGN - 1);
+    overlaySize = need[GRAPH_DISP_OVERLAY] + (spare * need[GRAPH_DISP_OVERLAY]) / sum;
+    overlaySize = MAX(overlaySize, ARRAY_COUNT(gGfxPools[0].overlayBuffer) / 4);
+    overlaySize = (overlaySize + GRAPH_DISP_REBALANCE_ALIGN - 1) & ~(GRAPH_DISP_REBALANCE_ALIGN - 1);
+
+    if ((total - xluSize - overlaySize) < need[GRAPH_DISP_OPA]) {
+        return;
+    }
+
+    if ((xluSize != sGraphDispSizes[GRAPH_DISP_XLU]) || (overlaySize != sGraphDispSizes[GRAPH_DISP_OVERLAY])) {
+        sGraphDispSizes[GRAPH_DISP_OPA] = total - xluSize - overlaySize;
+        sGraphDispSizes[GRAPH_DISP_XLU] = xluSize;
+        sGraphDispSizes[GRAPH_DISP_OVERLAY] = overlaySize;
+        sGraphDispStats.rebalances++;
+        osSyncPrintf("graph.c: display list buffers rebalanced (opa %d xlu %d overlay %d)\n",
+                     sGraphDispSizes[GRAPH_DISP_OPA], xluSize, overlaySize);
+    }
+}
+
 void Graph_SetNextGfxPool(GraphicsContext* gfxCtx) {
     GfxPool* pool = &gGfxPools[gfxCtx->gfxPoolIdx % 2];
+    Gfx* polyXluBuffer;
+    Gfx* overlayBuffer;
+    Gfx* polyOpaBuffer;
 
     gGfxMasterDL = &pool->master;
     gSegments[0x0E] = gGfxMasterDL;
@@ -47,26 +206,34 @@ void Graph_SetNextGfxPool(GraphicsContext* gfxCtx) {
     pool->headMagic = GFXPOOL_HEAD_MAGIC;
     pool->tailMagic = GFXPOOL_TAIL_MAGIC;
 
-    Graph_InitTHGA(&gfxCtx->polyOpa, pool->polyOpaBuffer, sizeof(pool->polyOpaBuffer));
-    Graph_InitTHGA(&gfxCtx->polyXlu, pool->polyXluBuffer, sizeof(pool->polyXluBuffer));
-    Graph_InitTHGA(&gfxCtx->overlay, pool->overlayBuffer, sizeof(pool->overlayBuffer));
+    // Without rebalancing these are the `polyXluBuffer`, `overlayBuffer` and `polyOpaBuffer` of the pool
+    Graph_RebalanceDisps();
+    polyXluBuffer = pool->dispBuffer;
+    overlayBuffer = &polyXluBuffer[sGraphDispSizes[GRAPH_DISP_XLU]];
+    polyOpaBuffer = &overlayBuffer[sGraphDispSizes[GRAPH_DISP_OVERLAY]];
+
+    Graph_InitTHGA(&gfxCtx->polyOpa, polyOpaBuffer, sGraphDispSizes[GRAPH_DISP_OPA] * sizeof(Gfx));
+    Graph_InitTHGA(&gfxCtx->polyXlu, polyXluBuffer, sGraphDispSizes[GRAPH_DISP_XLU] * sizeof(Gfx));
+    Graph_InitTHGA(&gfxCtx->overlay, overlayBuffer, sGraphDispSizes[GRAPH_DISP_OVERLAY] * sizeof(Gfx));
     Graph_InitTHGA(&gfxCtx->work, pool->workBuffer, sizeof(pool->workBuffer));
     Graph_InitTHGA(&gfxCtx->debug, pool->debugBuffer, sizeof(pool->debugBuffer));
 
-    gfxCtx->polyOpaBuffer = pool->polyOpaBuffer;
-    gfxCtx->polyXluBuffer = pool->polyXluBuffer;
-    gfxCtx->overlayBuffer = pool->overlayBuffer;
+    gfxCtx->polyOpaBuffer = polyOpaBuffer;
+    gfxCtx->polyXluBuffer = polyXluBuffer;
+    gfxCtx->overlayBuffer = overlayBuffer;
     gfxCtx->workBuffer = pool->workBuffer;
     gfxCtx->debugBuffer = pool->debugBuffer;
 
+    Gfx_ResetSetupDLCache();
+
     gfxCtx->curFrameBuffer = SysCfb_GetFramebuffer(gfxCtx->framebufferIndex % 2);
     gSegments[0x0F] = gfxCtx->curFrameBuffer;
 
     gfxCtx->zbuffer = SysCfb_GetZBuffer();
 
-    gSPBranchList(&gGfxMasterDL->disps[0], pool->polyOpaBuffer);
-    gSPBranchList(&gGfxMasterDL->disps[1], pool->polyXluBuffer);
-    gSPBranchList(&gGfxMasterDL->disps[2], pool->overlayBuffer);
+    gSPBranchList(&gGfxMasterDL->disps[0], polyOpaBuffer);
+    gSPBranchList(&gGfxMasterDL->disps[1], polyXluBuffer);
+    gSPBranchList(&gGfxMasterDL->disps[2], overlayBuffer);
     gSPBranchList(&gGfxMasterDL->disps[3], pool->workBuffer);
     gSPEndDisplayList(&gGfxMasterDL->disps[4]);
     gSPBranchList(&gGfxMasterDL->debugDisp[0], pool->debugBuffer);
@@ -285,6 +452,8 @@ void Graph_ExecuteAndDraw(GraphicsContext* gfxCtx, GameState* gameState) {
         }
     }
 
+    Graph_RecordDispUsage(gfxCtx);
+
     if (THGA_IsCrash(&gfxCtx->polyOpa)) {
         problem = true;
     }
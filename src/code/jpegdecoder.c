@@ -131,23 +131,30 @@ s32 JpegDecoder_ParseNextSymbol(JpegHuffmanTable* hTable, s16* outCoeff, s8* out
     u8 sym;
     u16 codeOff = 0;
     u16 buff = JpegDecoder_ReadBits(16);
+    u8 prefix = buff >> (16 - JPEG_HUFFMAN_LOOKAHEAD_BITS);
 
-    for (codeIdx = 0; codeIdx < ARRAY_COUNT(hTable->codesB); codeIdx++) {
-        if (hTable->codesB[codeIdx] == 0xFFFF) {
-            continue;
+    if ((hTable->lookup != NULL) && (hTable->lookup->lengths[prefix] != 0)) {
+        // Short codes are fully determined by the first bits, so decode them with a single table read
+        codeIdx = hTable->lookup->lengths[prefix] - 1;
+        sym = hTable->lookup->symbols[prefix];
+    } else {
+        for (codeIdx = 0; codeIdx < ARRAY_COUNT(hTable->codesB); codeIdx++) {
+            if (hTable->codesB[codeIdx] == 0xFFFF) {
+                continue;
+            }
+
+            codeOff = buff >> (15 - codeIdx);
+            if (codeOff <= hTable->codesB[codeIdx]) {
+                break;
+            }
         }
 
-        codeOff = buff >> (15 - codeIdx);
-        if (codeOff <= hTable->codesB[codeIdx]) {
-            break;
+        if (codeIdx >= ARRAY_COUNT(hTable->codesB)) {
+            return true;
         }
-    }
 
-    if (codeIdx >= ARRAY_COUNT(hTable->codesB)) {
-        return true;
+        sym = hTable->symbols[hTable->codeOffs[codeIdx] + codeOff - hTable->codesA[codeIdx]];
     }
-
-    sym = hTable->symbols[hTable->codeOffs[codeIdx] + codeOff - hTable->codesA[codeIdx]];
     *outZeroCount = sym >> 4;
     sym &= 0xF;
 
@@ -113,11 +113,42 @@ u32 JpegUtils_ProcessHuffmanTable(u8* dht, JpegHuffmanTable* ht, u8* codesLength
 
         dht += 16;
         ht[idx].symbols = dht;
+        ht[idx].lookup = NULL;
         dht += codeCount;
     }
     return false;
 }
 
+/**
+ * Fills `lookup` with the symbol and code length for every JPEG_HUFFMAN_LOOKAHEAD_BITS bit prefix of the stream,
+ * found with the same search as `JpegDecoder_ParseNextSymbol`, and attaches it to `ht`
+ */
+void JpegUtils_SetHuffmanLookup(JpegHuffmanTable* ht, JpegHuffmanLookup* lookup) {
+    s32 prefix;
+    s32 codeIdx;
+    u16 codeOff;
+
+    for (prefix = 0; prefix < ARRAY_COUNT(lookup->lengths); prefix++) {
+        lookup->lengths[prefix] = 0;
+        lookup->symbols[prefix] = 0;
+
+        for (codeIdx = 0; codeIdx < JPEG_HUFFMAN_LOOKAHEAD_BITS; codeIdx++) {
+            if (ht->codesB[codeIdx] == 0xFFFF) {
+                continue;
+            }
+
+            codeOff = prefix >> (JPEG_HUFFMAN_LOOKAHEAD_BITS - 1 - codeIdx);
+            if (codeOff <= ht->codesB[codeIdx]) {
+                lookup->lengths[prefix] = codeIdx + 1;
+                lookup->symbols[prefix] = ht->symbols[ht->codeOffs[codeIdx] + codeOff - ht->codesA[codeIdx]];
+                break;
+            }
+        }
+    }
+
+    ht->lookup = lookup;
+}
+
 void JpegUtils_SetHuffmanTableOld(u8* data, JpegHuffmanTableOld* ht, u8* codesLengths, u16* codes, s16 count, u8 isAc) {
     s16 idx;
     u8 a;
@@ -39,6 +39,9 @@ Mtx sActorHiliteMtx;
 
 Actor* D_801ED920; // 2 funcs. 1 out of z_actor
 
+ActorHotTable sActorHotTable;
+ActorDrawSort sActorDrawSort;
+
 #define ACTOR_AUDIO_FLAG_SFX_ACTOR_POS (1 << 0)
 #define ACTOR_AUDIO_FLAG_SFX_CENTERED_1 (1 << 1)
 #define ACTOR_AUDIO_FLAG_SFX_CENTERED_2 (1 << 2)
@@ -2393,6 +2396,7 @@ void Actor_InitContext(PlayState* play, ActorContext* actorCtx, ActorEntry* acto
 
     bzero(actorCtx, sizeof(ActorContext));
     ActorOverlayTable_Init();
+    ActorGrid_Init();
     Matrix_MtxFCopy(&play->billboardMtxF, &gIdentityMtxF);
     Matrix_MtxFCopy(&play->viewProjectionMtxF, &gIdentityMtxF);
 
@@ -2597,6 +2601,7 @@ void Actor_UpdateAll(PlayState* play, ActorContext* actorCtx) {
     }
 
     Actor_SpawnSetupActors(play, actorCtx);
+    ActorGrid_Build(actorCtx);
 
     if (actorCtx->unk2 != 0) {
         actorCtx->unk2--;
@@ -2643,6 +2648,7 @@ void Actor_UpdateAll(PlayState* play, ActorContext* actorCtx) {
                     actor->category = i;
                     Actor_RemoveFromCategory(play, actorCtx, actor);
                     Actor_AddToCategory(actorCtx, actor, cat);
+                    ActorGrid_Insert(actor);
                     actor = next;
                 }
             }
@@ -2675,16 +2681,13 @@ void Actor_UpdateAll(PlayState* play, ActorContext* actorCtx) {
 
 void Actor_Draw(PlayState* play, Actor* actor) {
     Lights* light;
+    s32 enablePosLights =
+        (actor->flags & ACTOR_FLAG_10000000) && (play->roomCtx.curRoom.enablePosLights || (MREG(93) != 0));
 
     OPEN_DISPS(play->state.gfxCtx);
 
-    light = LightContext_NewLights(&play->lightCtx, play->state.gfxCtx);
-    if ((actor->flags & ACTOR_FLAG_10000000) && (play->roomCtx.curRoom.enablePosLights || (MREG(93) != 0))) {
-        light->enablePosLights = true;
-    }
-
-    Lights_BindAll(light, play->lightCtx.listHead,
-                   (actor->flags & (ACTOR_FLAG_10000000 | ACTOR_FLAG_400000)) ? NULL : &actor->world.pos, play);
+    light = LightContext_NewBoundLights(
+        play, (actor->flags & (ACTOR_FLAG_10000000 | ACTOR_FLAG_400000)) ? NULL : &actor->world.pos, enablePosLights);
     Lights_Draw(light, play->state.gfxCtx);
 
     if (actor->flags & ACTOR_FLAG_IGNORE_QUAKE) {
@@ -2923,6 +2926,191 @@ s32 func_800BA2D8(PlayState* play, Actor* actor) {
     return func_800BA2FC(play, actor, &actor->projectedPos, actor->projectedW);
 }
 
+/**
+ * Copies the fields used by `ActorHotTable_ProjectAndCull` out of every loaded actor, in actor list order
+ */
+void ActorHotTable_Sync(ActorHotTable* table, ActorContext* actorCtx) {
+    Actor* actor;
+    s32 i;
+    s32 n = 0;
+
+    for (i = 0; i < ARRAY_COUNT(actorCtx->actorLists); i++) {
+        for (actor = actorCtx->actorLists[i].first; (actor != NULL) && (n < ACTOR_HOT_TABLE_MAX);
+             actor = actor->next) {
+            table->actors[n] = actor;
+            table->posX[n] = actor->world.pos.x;
+            table->posY[n] = actor->world.pos.y;
+            table->posZ[n] = actor->world.pos.z;
+            table->uncullZoneForward[n] = actor->uncullZoneForward;
+            table->uncullZoneScale[n] = actor->uncullZoneScale;
+            table->uncullZoneDownward[n] = actor->uncullZoneDownward;
+            n++;
+        }
+    }
+    table->count = n;
+}
+
+/**
+ * Batched equivalent of calling `SkinMatrix_Vec3fMtxFMultXYZW` and `func_800BA2D8` on every actor in `table`.
+ * The arithmetic is kept in the same order as those functions so the results are identical
+ */
+void ActorHotTable_ProjectAndCull(ActorHotTable* table, PlayState* play) {
+    f32 fovScaleY = play->projectionMtxFDiagonal.y * 0.57735026f; // 1 / sqrt(3)
+    f32 y;
+    f32 z;
+    f32 w;
+    f32 uncullScale;
+    f32 uncullScaleX;
+    f32 uncullScaleY;
+    f32 uncullDownward;
+    s32 useFovScale = (play->view.fovy != 60.0f);
+    s32 i;
+
+    CullBatch_Project(&play->viewProjectionMtxF, table->posX, table->posY, table->posZ, table->count,
+                      table->projectedX, table->projectedY, table->projectedZ, table->projectedW);
+
+    for (i = 0; i < table->count; i++) {
+        uncullScale = table->uncullZoneScale[i];
+        z = table->projectedZ[i];
+        table->isInView[i] = false;
+
+        if ((-uncullScale < z) && (z < (table->uncullZoneForward[i] + uncullScale))) {
+            w = CLAMP_MIN(table->projectedW[i], 1.0f);
+
+            if (useFovScale) {
+                uncullScaleX = uncullScale * play->projectionMtxFDiagonal.x * 0.76980036f; // sqrt(16/27)
+                uncullScaleY = uncullScale * fovScaleY;
+                uncullDownward = fovScaleY * table->uncullZoneDownward[i];
+            } else {
+                uncullScaleY = uncullScaleX = uncullScale;
+                uncullDownward = table->uncullZoneDownward[i];
+            }
+
+            y = table->projectedY[i];
+            if (((fabsf(table->projectedX[i]) - uncullScaleX) < w) && (-w < (y + uncullDownward)) &&
+                ((y - uncullScaleY) < w)) {
+                table->isInView[i] = true;
+            }
+        }
+    }
+}
+
+/**
+ * Enables recording the opaque commands of each actor drawn by `Actor_DrawAll` and calling them sorted by object and
+ * render-mode preset. Off by default, as actors whose opaque drawing depends on the actors drawn before them would
+ * change appearance
+ */
+void ActorDrawSort_SetEnabled(s32 isEnabled) {
+    sActorDrawSort.isEnabled = isEnabled;
+}
+
+/**
+ * Debug accessor for the packets and state change counters of the last `Actor_DrawAll` pass
+ */
+ActorDrawSort* ActorDrawSort_Get(void) {
+    return &sActorDrawSort;
+}
+
+/**
+ * Looks for a call to one of `gSetupDLs` in the first commands from `gfx` to `end`, without following calls
+ * returns the preset index, or ACTOR_DRAW_SORT_SETUPDL_NONE if there is none
+ */
+s32 ActorDrawSort_GetSetupDL(Gfx* gfx, Gfx* end) {
+    uintptr_t offset;
+    s32 i;
+
+    for (i = 0; (i < ACTOR_DRAW_SORT_SCAN_MAX) && (gfx < end); i++, gfx++) {
+        if ((gfx->words.w0 >> 24) == G_DL) {
+            offset = gfx->words.w1 - (uintptr_t)gSetupDLs;
+            if ((offset < sizeof(gSetupDLs)) && ((offset % sizeof(gSetupDLs[0])) == 0)) {
+                return offset / sizeof(gSetupDLs[0]);
+            }
+        }
+    }
+    return ACTOR_DRAW_SORT_SETUPDL_NONE;
+}
+
+/**
+ * Reserves the command that will branch over the packets, which are written after it as they are recorded
+ */
+void ActorDrawSort_Begin(ActorDrawSort* sort, PlayState* play) {
+    OPEN_DISPS(play->state.gfxCtx);
+
+    sort->count = 0;
+    sort->head = POLY_OPA_DISP;
+    POLY_OPA_DISP = &sort->head[1];
+
+    CLOSE_DISPS(play->state.gfxCtx);
+}
+
+/**
+ * Draws `actor` with `Actor_Draw`, recording its opaque commands as a packet. Translucent commands are written in
+ * place, so their order is unchanged
+ */
+void ActorDrawSort_Draw(ActorDrawSort* sort, PlayState* play, Actor* actor) {
+    Gfx* packet;
+
+    if (sort->count >= ACTOR_DRAW_SORT_MAX) {
+        // Unreachable as long as ACTOR_DRAW_SORT_MAX exceeds the u8 `totalLoadedActors`
+        return;
+    }
+
+    OPEN_DISPS(play->state.gfxCtx);
+
+    packet = POLY_OPA_DISP;
+    Actor_Draw(play, actor);
+    gSPEndDisplayList(POLY_OPA_DISP++);
+
+    sort->packets[sort->count] = packet;
+    sort->keys[sort->count] =
+        ((actor->objBankIndex & 0xFF) << 8) | ActorDrawSort_GetSetupDL(packet, POLY_OPA_DISP);
+    sort->count++;
+
+    CLOSE_DISPS(play->state.gfxCtx);
+}
+
+s32 ActorDrawSort_CountStateChanges(ActorDrawSort* sort, s32 isSorted) {
+    s32 changes = 0;
+    s32 prevKey;
+    s32 key;
+    s32 i;
+
+    for (i = 0; i < sort->count; i++) {
+        key = sort->keys[isSorted ? sort->order[i] : i];
+        if (i != 0) {
+            if ((key >> 8) != (prevKey >> 8)) {
+                changes++;
+            }
+            if ((key & 0xFF) != (prevKey & 0xFF)) {
+                changes++;
+            }
+        }
+        prevKey = key;
+    }
+    return changes;
+}
+
+/**
+ * Sorts the recorded packets, appends a call to each of them in that order, and points the reserved command at those
+ * calls. Packets with the same key keep actor list order
+ */
+void ActorDrawSort_End(ActorDrawSort* sort, PlayState* play) {
+    s32 i;
+
+    OPEN_DISPS(play->state.gfxCtx);
+
+    CullBatch_SortByDepth(sort->keys, sort->count, sort->order);
+    sort->stateChanges[0] = ActorDrawSort_CountStateChanges(sort, false);
+    sort->stateChanges[1] = ActorDrawSort_CountStateChanges(sort, true);
+
+    gSPBranchList(sort->head, POLY_OPA_DISP);
+    for (i = 0; i < sort->count; i++) {
+        gSPDisplayList(POLY_OPA_DISP++, sort->packets[sort->order[i]]);
+    }
+
+    CLOSE_DISPS(play->state.gfxCtx);
+}
+
 s32 func_800BA2FC(PlayState* play, Actor* actor, Vec3f* projectedPos, f32 projectedW) {
     if ((-actor->uncullZoneScale < projectedPos->z) &&
         (projectedPos->z < (actor->uncullZoneForward + actor->uncullZoneScale))) {
@@ -2961,6 +3149,8 @@ void Actor_DrawAll(PlayState* play, ActorContext* actorCtx) {
     Actor* actor;
     s32 actorFlags;
     s32 i;
+    s32 hotIndex;
+    s32 isSorted = sActorDrawSort.isEnabled;
 
     if (play->unk_18844) {
         actorFlags = ACTOR_FLAG_200000;
@@ -2971,22 +3161,55 @@ void Actor_DrawAll(PlayState* play, ActorContext* actorCtx) {
     OPEN_DISPS(play->state.gfxCtx);
 
     Actor_ResetLensActors(play);
+    LightGrid_Build(&play->lightCtx);
+
+    ActorHotTable_Sync(&sActorHotTable, actorCtx);
+    ActorHotTable_ProjectAndCull(&sActorHotTable, play);
+    hotIndex = 0;
 
     sp58 = POLY_XLU_DISP;
     POLY_XLU_DISP = &sp58[1];
 
+    if (isSorted) {
+        ActorDrawSort_Begin(&sActorDrawSort, play);
+    }
+
     for (i = 0, actorEntry = actorCtx->actorLists; i < ARRAY_COUNT(actorCtx->actorLists); i++, actorEntry++) {
         actor = actorEntry->first;
 
         while (actor != NULL) {
-            SkinMatrix_Vec3fMtxFMultXYZW(&play->viewProjectionMtxF, &actor->world.pos, &actor->projectedPos,
-                                         &actor->projectedW);
+            s32 isInView;
+
+            // Drawing earlier actors can spawn actors or move them (e.g. held actors in player's limb callbacks),
+            // in which case the batched result is stale and the actor is projected on its own
+            if ((hotIndex < sActorHotTable.count) && (sActorHotTable.actors[hotIndex] == actor) &&
+                (sActorHotTable.posX[hotIndex] == actor->world.pos.x) &&
+                (sActorHotTable.posY[hotIndex] == actor->world.pos.y) &&
+                (sActorHotTable.posZ[hotIndex] == actor->world.pos.z)) {
+                actor->projectedPos.x = sActorHotTable.projectedX[hotIndex];
+                actor->projectedPos.y = sActorHotTable.projectedY[hotIndex];
+                actor->projectedPos.z = sActorHotTable.projectedZ[hotIndex];
+                actor->projectedW = sActorHotTable.projectedW[hotIndex];
+                isInView = sActorHotTable.isInView[hotIndex];
+                hotIndex++;
+            } else {
+                if ((hotIndex < sActorHotTable.count) && (sActorHotTable.actors[hotIndex] == actor)) {
+                    hotIndex++;
+                }
+                SkinMatrix_Vec3fMtxFMultXYZW(&play->viewProjectionMtxF, &actor->world.pos, &actor->projectedPos,
+                                             &actor->projectedW);
+                isInView = -1;
+            }
 
             if (actor->audioFlags & ACTOR_AUDIO_FLAG_ALL) {
                 Actor_UpdateFlaggedAudio(actor);
             }
 
-            if (func_800BA2D8(play, actor)) {
+            if (isInView < 0) {
+                isInView = func_800BA2D8(play, actor);
+            }
+
+            if (isInView) {
                 actor->flags |= ACTOR_FLAG_40;
             } else {
                 actor->flags &= ~ACTOR_FLAG_40;
@@ -2999,6 +3222,8 @@ void Actor_DrawAll(PlayState* play, ActorContext* actorCtx) {
                      (play->actorCtx.lensMaskSize == LENS_MASK_ACTIVE_SIZE) ||
                      (actor->room != play->roomCtx.curRoom.num))) {
                     if (Actor_AddToLensActors(play, actor)) {}
+                } else if (isSorted) {
+                    ActorDrawSort_Draw(&sActorDrawSort, play, actor);
                 } else {
                     Actor_Draw(play, actor);
                 }
@@ -3008,6 +3233,10 @@ void Actor_DrawAll(PlayState* play, ActorContext* actorCtx) {
         }
     }
 
+    if (isSorted) {
+        ActorDrawSort_End(&sActorDrawSort, play);
+    }
+
     Effect_DrawAll(play->state.gfxCtx);
     EffectSS_DrawAllParticles(play);
     EffFootmark_Draw(play);
@@ -3194,6 +3423,7 @@ Actor* Actor_RemoveFromCategory(PlayState* play, ActorContext* actorCtx, Actor*
 
     actorCtx->totalLoadedActors--;
     actorCtx->actorLists[actorToRemove->category].length--;
+    ActorGrid_Remove(actorToRemove);
 
     if (actorToRemove->prev != NULL) {
         actorToRemove->prev->next = actorToRemove->next;
@@ -3370,6 +3600,9 @@ Actor* Actor_SpawnAsChildAndCutscene(ActorContext* actorCtx, PlayState* play, s1
         gSegments[6] = sp20;
     }
 
+    // Inserted after `Actor_Init` has set the actor's position
+    ActorGrid_Insert(actor);
+
     return actor;
 }
 
@@ -0,0 +1,322 @@
+/**
+ * @file z_actor_grid.c
+ *
+ * Spatial index for actor proximity queries.
+ *
+ * The grid hashes every loaded actor into one of ACTOR_GRID_BUCKET_COUNT buckets per category, by the xz cell its
+ * position falls in. It is rebuilt at the start of every `Actor_UpdateAll` pass, and kept valid for the rest of the
+ * frame by inserting spawned actors and removing deleted ones as the actor lists change.
+ *
+ * Positions are only sampled when the grid is built, so queries are widened by ACTOR_GRID_MOVE_MARGIN and every
+ * candidate is then tested against its current position. An actor that moved further than the margin since the grid
+ * was built can be missed, which is why existing linear scans are migrated to these functions one at a time.
+ * Queries covering too many cells, or made before the first build, walk the actor list like the functions they
+ * replace.
+ */
+#include "global.h"
+
+ActorGrid sActorGrid;
+
+void ActorGrid_Init(void) {
+    s32 i;
+    s32 j;
+
+    for (i = 0; i < ACTORCAT_MAX; i++) {
+        for (j = 0; j < ACTOR_GRID_BUCKET_COUNT; j++) {
+            sActorGrid.heads[i][j] = ACTOR_GRID_ENTRY_NONE;
+        }
+        sActorGrid.nextOrder[i] = 0;
+    }
+
+    for (i = 0; i < ACTOR_GRID_ACTOR_BUCKET_COUNT; i++) {
+        sActorGrid.actorHeads[i] = ACTOR_GRID_ENTRY_NONE;
+    }
+
+    for (i = 0; i < ACTOR_GRID_ENTRY_MAX; i++) {
+        sActorGrid.entries[i].actor = NULL;
+        sActorGrid.entries[i].next = i + 1;
+    }
+    sActorGrid.entries[ACTOR_GRID_ENTRY_MAX - 1].next = ACTOR_GRID_ENTRY_NONE;
+    sActorGrid.freeHead = 0;
+    sActorGrid.isBuilt = false;
+}
+
+s32 ActorGrid_GetCell(f32 coord) {
+    return (s32)coord >> ACTOR_GRID_CELL_SHIFT;
+}
+
+s32 ActorGrid_GetBucket(s32 cellX, s32 cellZ) {
+    return ((cellX * 73856093) ^ (cellZ * 19349663)) & (ACTOR_GRID_BUCKET_COUNT - 1);
+}
+
+s32 ActorGrid_GetActorBucket(Actor* actor) {
+    // Actor instances are allocated 16-byte aligned
+    return ((uintptr_t)actor >> 4) & (ACTOR_GRID_ACTOR_BUCKET_COUNT - 1);
+}
+
+/**
+ * Adds `actor` to its category's bucket for its current position, without checking if it is already present
+ */
+void ActorGrid_AddEntry(Actor* actor) {
+    ActorGridEntry* entry;
+    u16* head;
+    u16* actorHead;
+    u16 index = sActorGrid.freeHead;
+
+    if (index == ACTOR_GRID_ENTRY_NONE) {
+        // Unreachable as long as ACTOR_GRID_ENTRY_MAX exceeds the u8 `totalLoadedActors`
+        return;
+    }
+
+    entry = &sActorGrid.entries[index];
+    sActorGrid.freeHead = entry->next;
+
+    entry->actor = actor;
+    entry->order = sActorGrid.nextOrder[actor->category]++;
+
+    entry->bucket = actor->category * ACTOR_GRID_BUCKET_COUNT +
+                    ActorGrid_GetBucket(ActorGrid_GetCell(actor->world.pos.x), ActorGrid_GetCell(actor->world.pos.z));
+
+    head = &sActorGrid.heads[0][entry->bucket];
+    entry->next = *head;
+    *head = index;
+
+    actorHead = &sActorGrid.actorHeads[ActorGrid_GetActorBucket(actor)];
+    entry->actorNext = *actorHead;
+    *actorHead = index;
+}
+
+/**
+ * Rebuilds the grid from the actor lists. Called once per `Actor_UpdateAll` pass
+ */
+void ActorGrid_Build(ActorContext* actorCtx) {
+    Actor* actor;
+    s32 i;
+
+    ActorGrid_Init();
+
+    for (i = 0; i < ACTORCAT_MAX; i++) {
+        for (actor = actorCtx->actorLists[i].first; actor != NULL; actor = actor->next) {
+            ActorGrid_AddEntry(actor);
+        }
+    }
+
+    sActorGrid.isBuilt = true;
+}
+
+/**
+ * Called when `actor` is appended to its category's list
+ */
+void ActorGrid_Insert(Actor* actor) {
+    if (sActorGrid.isBuilt) {
+        ActorGrid_AddEntry(actor);
+    }
+}
+
+/**
+ * Called when `actor` is unlinked from its category's list, so the grid never holds freed actors
+ */
+void ActorGrid_Remove(Actor* actor) {
+    ActorGridEntry* entry;
+    u16* link;
+    u16 index;
+
+    if (!sActorGrid.isBuilt) {
+        return;
+    }
+
+    for (link = &sActorGrid.actorHeads[ActorGrid_GetActorBucket(actor)];; link = &entry->actorNext) {
+        if (*link == ACTOR_GRID_ENTRY_NONE) {
+            // Only reachable if the actor was not added because the entries ran out
+            return;
+        }
+        entry = &sActorGrid.entries[*link];
+        if (entry->actor == actor) {
+            break;
+        }
+    }
+    index = *link;
+    *link = entry->actorNext;
+
+    // The actor may have moved since it was bucketed, or been moved to another category with `func_800BC154`,
+    // so unlink it from the bucket it was added to rather than the one for its current position and category
+    for (link = &sActorGrid.heads[0][entry->bucket]; *link != index; link = &sActorGrid.entries[*link].next) {}
+    *link = entry->next;
+
+    entry->actor = NULL;
+    entry->next = sActorGrid.freeHead;
+    sActorGrid.freeHead = index;
+}
+
+/**
+ * Lists the buckets that may hold actors within `distance` of `pos`, without duplicates
+ * returns the number of buckets, or -1 if the area is too large and the caller should walk the actor list instead
+ */
+s32 ActorGrid_GetBuckets(Vec3f* pos, f32 distance, u8* buckets) {
+    f32 range = distance + ACTOR_GRID_MOVE_MARGIN;
+    s32 minX = ActorGrid_GetCell(pos->x - range);
+    s32 maxX = ActorGrid_GetCell(pos->x + range);
+    s32 minZ = ActorGrid_GetCell(pos->z - range);
+    s32 maxZ = ActorGrid_GetCell(pos->z + range);
+    u32 usedMask[ACTOR_GRID_BUCKET_COUNT / 32];
+    s32 count = 0;
+    s32 bucket;
+    s32 x;
+    s32 z;
+
+    if (!sActorGrid.isBuilt || ((maxX - minX + 1) * (maxZ - minZ + 1) > ACTOR_GRID_BUCKET_COUNT / 2)) {
+        return -1;
+    }
+
+    for (x = 0; x < ARRAY_COUNT(usedMask); x++) {
+        usedMask[x] = 0;
+    }
+
+    for (z = minZ; z <= maxZ; z++) {
+        for (x = minX; x <= maxX; x++) {
+            bucket = ActorGrid_GetBucket(x, z);
+            if (!(usedMask[bucket >> 5] & (1 << (bucket & 0x1F)))) {
+                usedMask[bucket >> 5] |= 1 << (bucket & 0x1F);
+                buckets[count++] = bucket;
+            }
+        }
+    }
+    return count;
+}
+
+s32 ActorGrid_IsMatch(Actor* actor, Actor* exclude, s16 actorId) {
+    return (actor != exclude) && ((actorId == -1) || (actorId == actor->id));
+}
+
+/**
+ * Finds the first actor of a specified Id and category within a given range from `inActor`, in actor list order.
+ * Returns the same actor as `Actor_FindNearby`, see the file comment for the one difference
+ */
+Actor* ActorGrid_FindFirst(PlayState* play, Actor* inActor, s16 actorId, u8 actorCategory, f32 distance) {
+    u8 buckets[ACTOR_GRID_BUCKET_COUNT / 2];
+    s32 bucketCount;
+    s32 i;
+    u16 index;
+    ActorGridEntry* entry;
+    ActorGridEntry* first = NULL;
+    f32 distSqMax = SQ(distance);
+
+    if (distance < 0.0f) {
+        return NULL;
+    }
+
+    bucketCount = ActorGrid_GetBuckets(&inActor->world.pos, distance, buckets);
+    if (bucketCount < 0) {
+        return Actor_FindNearby(play, inActor, actorId, actorCategory, distance);
+    }
+
+    for (i = 0; i < bucketCount; i++) {
+        for (index = sActorGrid.heads[actorCategory][buckets[i]]; index != ACTOR_GRID_ENTRY_NONE;
+             index = entry->next) {
+            entry = &sActorGrid.entries[index];
+
+            if (((first == NULL) || (entry->order < first->order)) &&
+                ActorGrid_IsMatch(entry->actor, inActor, actorId) &&
+                (Math3D_Vec3fDistSq(&inActor->world.pos, &entry->actor->world.pos) <= distSqMax)) {
+                first = entry;
+            }
+        }
+    }
+
+    return (first != NULL) ? first->actor : NULL;
+}
+
+/**
+ * Finds the closest actor of a specified Id and category within `distance` of `pos`, ignoring `exclude`.
+ * If the Id provided is -1, any actor of the category matches
+ */
+Actor* ActorGrid_FindNearest(PlayState* play, Vec3f* pos, Actor* exclude, s16 actorId, u8 actorCategory,
+                             f32 distance) {
+    u8 buckets[ACTOR_GRID_BUCKET_COUNT / 2];
+    s32 bucketCount;
+    s32 i;
+    u16 index;
+    Actor* actor;
+    Actor* nearest = NULL;
+    f32 nearestDistSq = SQ(distance);
+    f32 distSq;
+
+    if (distance < 0.0f) {
+        return NULL;
+    }
+
+    bucketCount = ActorGrid_GetBuckets(pos, distance, buckets);
+    if (bucketCount < 0) {
+        for (actor = play->actorCtx.actorLists[actorCategory].first; actor != NULL; actor = actor->next) {
+            if (ActorGrid_IsMatch(actor, exclude, actorId)) {
+                distSq = Math3D_Vec3fDistSq(pos, &actor->world.pos);
+                if ((distSq < nearestDistSq) || ((nearest == NULL) && (distSq == nearestDistSq))) {
+                    nearestDistSq = distSq;
+                    nearest = actor;
+                }
+            }
+        }
+        return nearest;
+    }
+
+    for (i = 0; i < bucketCount; i++) {
+        for (index = sActorGrid.heads[actorCategory][buckets[i]]; index != ACTOR_GRID_ENTRY_NONE;
+             index = sActorGrid.entries[index].next) {
+            actor = sActorGrid.entries[index].actor;
+
+            if (ActorGrid_IsMatch(actor, exclude, actorId)) {
+                distSq = Math3D_Vec3fDistSq(pos, &actor->world.pos);
+                if ((distSq < nearestDistSq) || ((nearest == NULL) && (distSq == nearestDistSq))) {
+                    nearestDistSq = distSq;
+                    nearest = actor;
+                }
+            }
+        }
+    }
+    return nearest;
+}
+
+/**
+ * Fills `outActors` with up to `maxActors` actors of a specified Id and category within `distance` of `pos`,
+ * ignoring `exclude`. The order of the results is unspecified
+ * returns the number of actors written
+ */
+s32 ActorGrid_FindAll(PlayState* play, Vec3f* pos, Actor* exclude, s16 actorId, u8 actorCategory, f32 distance,
+                      Actor** outActors, s32 maxActors) {
+    u8 buckets[ACTOR_GRID_BUCKET_COUNT / 2];
+    s32 bucketCount;
+    s32 count = 0;
+    s32 i;
+    u16 index;
+    Actor* actor;
+    f32 distSqMax = SQ(distance);
+
+    if (distance < 0.0f) {
+        return 0;
+    }
+
+    bucketCount = ActorGrid_GetBuckets(pos, distance, buckets);
+    if (bucketCount < 0) {
+        for (actor = play->actorCtx.actorLists[actorCategory].first; (actor != NULL) && (count < maxActors);
+             actor = actor->next) {
+            if (ActorGrid_IsMatch(actor, exclude, actorId) &&
+                (Math3D_Vec3fDistSq(pos, &actor->world.pos) <= distSqMax)) {
+                outActors[count++] = actor;
+            }
+        }
+        return count;
+    }
+
+    for (i = 0; i < bucketCount; i++) {
+        for (index = sActorGrid.heads[actorCategory][buckets[i]];
+             (index != ACTOR_GRID_ENTRY_NONE) && (count < maxActors); index = sActorGrid.entries[index].next) {
+            actor = sActorGrid.entries[index].actor;
+
+            if (ActorGrid_IsMatch(actor, exclude, actorId) &&
+                (Math3D_Vec3fDistSq(pos, &actor->world.pos) <= distSqMax)) {
+                outActors[count++] = actor;
+            }
+        }
+    }
+    return count;
+}
@@ -78,6 +78,13 @@ BgSpecialSceneMaxObjects sCustomDynapolyMem[] = {
     { SCENE_21MITURINMAE, 1000, 600, 512 },
 };
 
+// Scenes that test lines against a StaticBvh instead of walking the StaticLookup subdivisions, terminated by -1.
+// R_BGCHECK_STATIC_BVH overrides this list, to compare gStaticLookupStats for a scene with and without a BVH
+s16 sSceneBvhList[] = {
+    SCENE_00KEIKOKU,
+    -1,
+};
+
 // TODO: All these bss variables are localized to one function and can
 // likely be made into in-function static bss variables in the future
 
@@ -92,6 +99,9 @@ char D_801EDAA8[80];
 char D_801EDAF8[80];
 Vec3f D_801EDB48[3]; // polyVerts
 
+StaticBvh sStaticBvh;
+StaticLookupStats gStaticLookupStats;
+
 void BgCheck_GetStaticLookupIndicesFromPos(CollisionContext* colCtx, Vec3f* pos, Vec3i* sector);
 f32 BgCheck_RaycastFloorDyna(DynaRaycast* dynaRaycast);
 s32 BgCheck_SphVsDynaWall(CollisionContext* colCtx, u16 xpFlags, f32* outX, f32* outZ, Vec3f* pos, f32 radius,
@@ -968,6 +978,9 @@ s32 BgCheck_CheckLineAgainstSSList(StaticLineTest* arg0) {
         polyId = curNode->polyId;
         test.poly = &polyList[polyId];
         checkedPoly = &arg0->colCtx->polyNodes.polyCheckTbl[polyId];
+        if (R_BGCHECK_STATS) {
+            gStaticLookupStats.polysTested++;
+        }
 
         if ((*checkedPoly == true) ||
             ((arg0->xpFlags2 != 0) && !COLPOLY_VIA_FLAG_TEST(test.poly->flags_vIA, arg0->xpFlags2)) ||
@@ -1038,6 +1051,142 @@ s32 BgCheck_CheckLineInSubdivision(StaticLineTest* arg0) {
     return result;
 }
 
+/**
+ * Tests if line `posA` to `posB` intersects with a static poly in the leaf `node` of sStaticBvh
+ * Polys appear in exactly one leaf, so unlike the SSList test this does not need the polyCheckTbl
+ * returns true if such a poly exists, else false
+ */
+s32 BgCheck_CheckLineAgainstStaticBvhLeaf(StaticLineTest* checkLine, StaticBvhNode* node) {
+    CollisionPoly* polyList = checkLine->colCtx->colHeader->polyList;
+    s16* polyId = &sStaticBvh.polyIds[node->index];
+    s16* polyIdEnd = polyId + node->count;
+    s32 result = false;
+    Vec3f polyIntersect;
+    BgLineVsPolyTest test;
+    f32 distSq;
+    f32 minY;
+    u32 polyType;
+
+    test.vtxList = checkLine->colCtx->colHeader->vtxList;
+    test.posA = checkLine->posA;
+    test.posB = checkLine->posB;
+    test.planeIntersect = &polyIntersect;
+    test.checkOneFace = (checkLine->bccFlags & BGCHECK_CHECK_ONE_FACE) != 0;
+    test.checkDist = checkLine->checkDist;
+
+    for (; polyId < polyIdEnd; polyId++) {
+        test.poly = &polyList[*polyId];
+        if (R_BGCHECK_STATS) {
+            gStaticLookupStats.polysTested++;
+        }
+
+        // Same classification as StaticLookup_AddPoly
+        if (test.poly->normal.y > COLPOLY_SNORMAL(0.5f)) {
+            polyType = BGCHECK_CHECK_FLOOR;
+        } else if (test.poly->normal.y < COLPOLY_SNORMAL(-0.8f)) {
+            polyType = BGCHECK_CHECK_CEILING;
+        } else {
+            polyType = BGCHECK_CHECK_WALL;
+        }
+
+        if (!(checkLine->bccFlags & polyType) ||
+            ((checkLine->xpFlags2 != 0) && !COLPOLY_VIA_FLAG_TEST(test.poly->flags_vIA, checkLine->xpFlags2)) ||
+            COLPOLY_VIA_FLAG_TEST(test.poly->flags_vIA, checkLine->xpFlags1) ||
+            (COLPOLY_VIA_FLAG_TEST(test.poly->flags_vIB, 4) &&
+             (((checkLine->actor != NULL) && (checkLine->actor->category != ACTORCAT_PLAYER)) ||
+              ((checkLine->actor == NULL) && (checkLine->xpFlags1 != COLPOLY_IGNORE_CAMERA))))) {
+            continue;
+        }
+
+        minY = CollisionPoly_GetMinY(test.poly, test.vtxList);
+        if ((test.posA->y < minY) && (test.posB->y < minY)) {
+            continue;
+        }
+
+        if (CollisionPoly_LineVsPoly(&test)) {
+            distSq = Math3D_Vec3fDistSq(test.posA, test.planeIntersect);
+            if (distSq < checkLine->outDistSq) {
+                checkLine->outDistSq = distSq;
+                *checkLine->outPos = *test.planeIntersect;
+                *checkLine->posB = *test.planeIntersect;
+                *checkLine->outPoly = test.poly;
+                result = true;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * Returns the squared distance from `pos` to the center of `node`'s bounds
+ */
+f32 StaticBvhNode_CenterDistSq(StaticBvhNode* node, Vec3f* pos) {
+    f32 dx = (node->min.x + node->max.x) * 0.5f - pos->x;
+    f32 dy = (node->min.y + node->max.y) * 0.5f - pos->y;
+    f32 dz = (node->min.z + node->max.z) * 0.5f - pos->z;
+
+    return SQ(dx) + SQ(dy) + SQ(dz);
+}
+
+/**
+ * Tests if line `posA` to `posB` intersects with a static poly, using sStaticBvh
+ * Children are visited nearest first, so that `posB` is shortened early and prunes the remaining nodes.
+ * The stack never overflows, as `BgCheck_InitStaticBvh` does not build trees deeper than it holds
+ * returns true if such a poly exists, else false
+ * `outPoly` returns the pointer of the poly intersected
+ * `posB` and `outPos` returns the point of intersection with `outPoly`
+ * `outDistSq` returns the squared distance from `posA` to the point of intersect
+ */
+s32 BgCheck_CheckLineInStaticBvh(StaticLineTest* checkLine) {
+    u16 stack[BGCHECK_BVH_STACK_MAX];
+    s32 stackCount = 0;
+    s32 result = false;
+    StaticBvhNode* node;
+    StaticBvhNode* nearChild;
+    StaticBvhNode* farChild;
+    Vec3f nodeMin;
+    Vec3f nodeMax;
+    f32 margin = checkLine->checkDist + 1.0f;
+    s32 isCounted = R_BGCHECK_STATS;
+
+    stack[stackCount++] = 0;
+
+    while (stackCount > 0) {
+        node = &sStaticBvh.nodes[stack[--stackCount]];
+        if (isCounted) {
+            gStaticLookupStats.cellsVisited++;
+        }
+
+        nodeMin.x = node->min.x - margin;
+        nodeMin.y = node->min.y - margin;
+        nodeMin.z = node->min.z - margin;
+        nodeMax.x = node->max.x + margin;
+        nodeMax.y = node->max.y + margin;
+        nodeMax.z = node->max.z + margin;
+        if (!Math3D_LineVsCube(&nodeMin, &nodeMax, checkLine->posA, checkLine->posB)) {
+            continue;
+        }
+
+        if (node->count != 0) {
+            if (BgCheck_CheckLineAgainstStaticBvhLeaf(checkLine, node)) {
+                result = true;
+            }
+            continue;
+        }
+
+        nearChild = node + 1;
+        farChild = &sStaticBvh.nodes[node->index];
+        if (StaticBvhNode_CenterDistSq(farChild, checkLine->posA) <
+            StaticBvhNode_CenterDistSq(nearChild, checkLine->posA)) {
+            nearChild = farChild;
+            farChild = node + 1;
+        }
+        stack[stackCount++] = farChild - sStaticBvh.nodes;
+        stack[stackCount++] = nearChild - sStaticBvh.nodes;
+    }
+    return result;
+}
+
 /**
  * Get first static poly intersecting sphere `center` `radius` from list `node`
  * returns true if any poly intersects the sphere, else returns false
@@ -1469,6 +1618,190 @@ u32 BgCheck_InitStaticLookup(CollisionContext* colCtx, PlayState* play, StaticLo
     return colCtx->polyNodes.count * sizeof(SSNode);
 }
 
+/**
+ * Returns whether the current scene tests lines against a StaticBvh
+ */
+s32 BgCheck_UseStaticBvh(PlayState* play) {
+    s16* sceneId;
+
+    if (R_BGCHECK_STATIC_BVH != 0) {
+        return R_BGCHECK_STATIC_BVH > 0;
+    }
+
+    for (sceneId = sSceneBvhList; *sceneId != -1; sceneId++) {
+        if (play->sceneId == *sceneId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns three times the centroid of `poly` along `axis` (0 = x, 1 = y, 2 = z)
+ */
+s32 CollisionPoly_GetCentroidSum(CollisionPoly* poly, Vec3s* vtxList, s32 axis) {
+    return (&vtxList[COLPOLY_VTX_INDEX(poly->flags_vIA)].x)[axis] +
+           (&vtxList[COLPOLY_VTX_INDEX(poly->flags_vIB)].x)[axis] + (&vtxList[poly->vIC].x)[axis];
+}
+
+/**
+ * Partially sorts `polyIds` so that the poly at index `nth` has the median centroid along `axis`,
+ * with no poly before it having a larger centroid and no poly after it having a smaller one
+ */
+void BgCheck_SelectStaticBvhPolys(s16* polyIds, s32 count, s32 nth, CollisionPoly* polyList, Vec3s* vtxList,
+                                  s32 axis) {
+    s32 lo = 0;
+    s32 hi = count - 1;
+    s32 i;
+    s32 j;
+    s32 pivot;
+    s16 temp;
+
+    while (lo < hi) {
+        pivot = CollisionPoly_GetCentroidSum(&polyList[polyIds[(lo + hi) / 2]], vtxList, axis);
+        i = lo;
+        j = hi;
+        while (i <= j) {
+            while (CollisionPoly_GetCentroidSum(&polyList[polyIds[i]], vtxList, axis) < pivot) {
+                i++;
+            }
+            while (CollisionPoly_GetCentroidSum(&polyList[polyIds[j]], vtxList, axis) > pivot) {
+                j--;
+            }
+            if (i <= j) {
+                temp = polyIds[i];
+                polyIds[i] = polyIds[j];
+                polyIds[j] = temp;
+                i++;
+                j--;
+            }
+        }
+        if (nth <= j) {
+            hi = j;
+        } else if (nth >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+}
+
+/**
+ * Returns the number of nodes `BgCheck_BuildStaticBvhNode` creates for a subtree over `count` polys
+ */
+s32 BgCheck_CountStaticBvhNodes(s32 count) {
+    if (count <= BGCHECK_BVH_LEAF_MAX) {
+        return 1;
+    }
+    return 1 + BgCheck_CountStaticBvhNodes(count / 2) + BgCheck_CountStaticBvhNodes(count - (count / 2));
+}
+
+/**
+ * Returns the depth of the deepest leaf `BgCheck_BuildStaticBvhNode` creates for a subtree over `count` polys
+ */
+s32 BgCheck_GetStaticBvhDepth(s32 count) {
+    if (count <= BGCHECK_BVH_LEAF_MAX) {
+        return 0;
+    }
+    // The second half is never smaller than the first
+    return 1 + BgCheck_GetStaticBvhDepth(count - (count / 2));
+}
+
+/**
+ * Builds the sStaticBvh subtree over `count` polys starting at `polyIds[start]`
+ * Polys are split at the median centroid of the longest axis, so the tree depth is log2(numPolygons)
+ * returns the index of the subtree's root node
+ */
+s32 BgCheck_BuildStaticBvhNode(CollisionPoly* polyList, Vec3s* vtxList, s32 start, s32 count) {
+    s32 nodeIndex = sStaticBvh.nodeCount++;
+    StaticBvhNode* node = &sStaticBvh.nodes[nodeIndex];
+    s16* polyId;
+    Vec3s* vtx;
+    s32 i;
+    s32 axis;
+    s32 half;
+
+    node->min.x = node->min.y = node->min.z = SHT_MAX;
+    node->max.x = node->max.y = node->max.z = -SHT_MAX;
+
+    for (polyId = &sStaticBvh.polyIds[start]; polyId < &sStaticBvh.polyIds[start + count]; polyId++) {
+        for (i = 0; i < 3; i++) {
+            vtx = &vtxList[COLPOLY_VTX_INDEX(polyList[*polyId].vtxData[i])];
+            node->min.x = CLAMP_MAX(node->min.x, vtx->x);
+            node->min.y = CLAMP_MAX(node->min.y, vtx->y);
+            node->min.z = CLAMP_MAX(node->min.z, vtx->z);
+            node->max.x = CLAMP_MIN(node->max.x, vtx->x);
+            node->max.y = CLAMP_MIN(node->max.y, vtx->y);
+            node->max.z = CLAMP_MIN(node->max.z, vtx->z);
+        }
+    }
+
+    if (count <= BGCHECK_BVH_LEAF_MAX) {
+        node->index = start;
+        node->count = count;
+        return nodeIndex;
+    }
+
+    axis = 0;
+    if ((node->max.y - node->min.y) > (node->max.x - node->min.x)) {
+        axis = 1;
+    }
+    if ((node->max.z - node->min.z) > ((&node->max.x)[axis] - (&node->min.x)[axis])) {
+        axis = 2;
+    }
+
+    half = count / 2;
+    BgCheck_SelectStaticBvhPolys(&sStaticBvh.polyIds[start], count, half, polyList, vtxList, axis);
+
+    node->count = 0;
+    BgCheck_BuildStaticBvhNode(polyList, vtxList, start, half);
+    node->index = BgCheck_BuildStaticBvhNode(polyList, vtxList, start + half, count - half);
+    return nodeIndex;
+}
+
+/**
+ * Initialize sStaticBvh over the scene's static collision
+ * The StaticLookup table is still built, as every other query type uses it
+ * returns size of the structure, in bytes, or 0 if there was not enough memory and the scene falls back to
+ * the StaticLookup table
+ */
+u32 BgCheck_InitStaticBvh(CollisionContext* colCtx, PlayState* play) {
+    s32 numPolygons = colCtx->colHeader->numPolygons;
+    s32 numNodes;
+    OSTime startTime = osGetTime();
+    s32 i;
+
+    sStaticBvh.nodes = NULL;
+    sStaticBvh.nodeCount = 0;
+    if (numPolygons == 0) {
+        return 0;
+    }
+
+    // Traversal pops one node and pushes two per level, so it needs one stack entry more than the depth
+    if (BgCheck_GetStaticBvhDepth(numPolygons) + 1 > BGCHECK_BVH_STACK_MAX) {
+        return 0;
+    }
+
+    // The tree shape only depends on the poly count, so exactly the nodes the build creates are allocated.
+    // Both allocations are aligned to 16, and THA_AllocTailAlign16 does not check for overflow
+    numNodes = BgCheck_CountStaticBvhNodes(numPolygons);
+    if (THA_GetRemaining(&play->state.heap) <
+        (s32)(ALIGN16(numPolygons * sizeof(s16)) + ALIGN16(numNodes * sizeof(StaticBvhNode)) + 0x10)) {
+        return 0;
+    }
+
+    sStaticBvh.polyIds = THA_AllocTailAlign16(&play->state.heap, numPolygons * sizeof(s16));
+    sStaticBvh.nodes = THA_AllocTailAlign16(&play->state.heap, numNodes * sizeof(StaticBvhNode));
+
+    for (i = 0; i < numPolygons; i++) {
+        sStaticBvh.polyIds[i] = i;
+    }
+    BgCheck_BuildStaticBvhNode(colCtx->colHeader->polyList, colCtx->colHeader->vtxList, 0, numPolygons);
+
+    gStaticLookupStats.bvhBuildTime = osGetTime() - startTime;
+    return numPolygons * sizeof(s16) + sStaticBvh.nodeCount * sizeof(StaticBvhNode);
+}
+
 /**
  * Returns whether the current scene should reserve less memory for it's collision lookup
  */
@@ -1534,6 +1867,7 @@ void BgCheck_Allocate(CollisionContext* colCtx, PlayState* play, CollisionHeader
     u32 lookupTblMemSize;
     SSNodeList* nodeList;
     s32 customNodeListMax;
+    OSTime startTime;
 
     customNodeListMax = -1;
     colCtx->colHeader = colHeader;
@@ -1615,7 +1949,15 @@ void BgCheck_Allocate(CollisionContext* colCtx, PlayState* play, CollisionHeader
     SSNodeList_Init(&colCtx->polyNodes);
     SSNodeList_Alloc(play, &colCtx->polyNodes, tblMax, colCtx->colHeader->numPolygons);
 
+    bzero(&gStaticLookupStats, sizeof(StaticLookupStats));
+    startTime = osGetTime();
     lookupTblMemSize = BgCheck_InitStaticLookup(colCtx, play, colCtx->lookupTbl);
+    gStaticLookupStats.gridBuildTime = osGetTime() - startTime;
+
+    sStaticBvh.nodes = NULL;
+    if (BgCheck_UseStaticBvh(play)) {
+        BgCheck_InitStaticBvh(colCtx, play);
+    }
 
     DynaPoly_Init(play, &colCtx->dyna);
     DynaPoly_Alloc(play, &colCtx->dyna);
@@ -2177,13 +2519,17 @@ s32 BgCheck_CheckLineImpl(CollisionContext* colCtx, u16 xpFlags1, u16 xpFlags2,
     s32 temp_lo;
     StaticLookup* lookup;
     s32 j;
+    s32 isCounted = R_BGCHECK_STATS;
+    OSTime startTime = isCounted ? osGetTime() : 0;
 
     lookupTbl = colCtx->lookupTbl;
     posBTemp = *posB;
 
     *outBgId = BGCHECK_SCENE;
 
-    BgCheck_ResetPolyCheckTbl(&colCtx->polyNodes, colCtx->colHeader->numPolygons);
+    if (sStaticBvh.nodes == NULL) {
+        BgCheck_ResetPolyCheckTbl(&colCtx->polyNodes, colCtx->colHeader->numPolygons);
+    }
     BgCheck_GetStaticLookupIndicesFromPos(colCtx, posA, (Vec3i*)&subdivMin);
     BgCheck_GetStaticLookupIndicesFromPos(colCtx, &posBTemp, (Vec3i*)&subdivMax);
     *posResult = *posB;
@@ -2202,7 +2548,14 @@ s32 BgCheck_CheckLineImpl(CollisionContext* colCtx, u16 xpFlags1, u16 xpFlags2,
     checkLine.actor = actor;
     result = false;
 
-    if ((subdivMin[0] != subdivMax[0]) || (subdivMin[1] != subdivMax[1]) || (subdivMin[2] != subdivMax[2])) {
+    if (isCounted) {
+        gStaticLookupStats.lineTestCount++;
+    }
+
+    if (((subdivMin[0] != subdivMax[0]) || (subdivMin[1] != subdivMax[1]) || (subdivMin[2] != subdivMax[2])) &&
+        (sStaticBvh.nodes != NULL)) {
+        result = BgCheck_CheckLineInStaticBvh(&checkLine);
+    } else if ((subdivMin[0] != subdivMax[0]) || (subdivMin[1] != subdivMax[1]) || (subdivMin[2] != subdivMax[2])) {
         for (i = 0; i < 3; i++) {
             if (subdivMax[i] < subdivMin[i]) {
                 j = subdivMax[i];
@@ -2232,6 +2585,9 @@ s32 BgCheck_CheckLineImpl(CollisionContext* colCtx, u16 xpFlags1, u16 xpFlags2,
                 for (k = subdivMin[0]; k < subdivMax[0] + 1; k++) {
                     if (Math3D_LineVsCube(&sectorMin, &sectorMax, posA, &posBTemp)) {
                         checkLine.lookup = lookup;
+                        if (isCounted) {
+                            gStaticLookupStats.cellsVisited++;
+                        }
 
                         if (BgCheck_CheckLineInSubdivision(&checkLine)) {
                             result = true;
@@ -2250,14 +2606,26 @@ s32 BgCheck_CheckLineImpl(CollisionContext* colCtx, u16 xpFlags1, u16 xpFlags2,
             sectorMax.z += colCtx->subdivLength.z;
         }
     } else if (BgCheck_PosInStaticBoundingBox(colCtx, posA) == false) {
+        if (isCounted) {
+            gStaticLookupStats.lineTestTime += osGetTime() - startTime;
+        }
         return false;
+    } else if (sStaticBvh.nodes != NULL) {
+        result = BgCheck_CheckLineInStaticBvh(&checkLine);
     } else {
         checkLine.lookup = BgCheck_GetNearestStaticLookup(colCtx, lookupTbl, posA);
+        if (isCounted) {
+            gStaticLookupStats.cellsVisited++;
+        }
         result = BgCheck_CheckLineInSubdivision(&checkLine);
         if (result) {
             checkLine.outDistSq = Math3D_Vec3fDistSq(posResult, posA);
         }
     }
+    if (isCounted) {
+        gStaticLookupStats.lineTestTime += osGetTime() - startTime;
+    }
+
     if ((bccFlags & BGCHECK_CHECK_DYNA) &&
         BgCheck_CheckLineAgainstDyna(colCtx, xpFlags1, posA, &posBTemp, posResult, outPoly, &checkLine.outDistSq,
                                      outBgId, actor, checkDist, bccFlags)) {
@@ -0,0 +1,129 @@
+/**
+ * @file z_cull_batch.c
+ *
+ * Shared stage for culling and depth sorting many bounding spheres at once.
+ *
+ * Callers gather sphere centers into separate x/y/z arrays, project them all with `CullBatch_Project`, test the
+ * results, and order the survivors by depth with `CullBatch_SortByDepth`. Projection is done one output component
+ * at a time over the whole batch so each matrix row is loaded once, and it produces the same values as
+ * `SkinMatrix_Vec3fMtxFMultXYZW`. The sort is a stable radix sort, so it gives the same order as an insertion sort
+ * that places each entry after the ones of equal depth, in linear time.
+ */
+#include "global.h"
+
+u32 sCullBatchKeys[2][CULL_BATCH_MAX];
+u16 sCullBatchOrder[CULL_BATCH_MAX];
+
+/**
+ * Multiplies every [ x[i], y[i], z[i], 1 ] by `mf` and writes the components to the output arrays.
+ * Any output array may be NULL if that component is not needed
+ */
+void CullBatch_Project(MtxF* mf, f32* x, f32* y, f32* z, s32 count, f32* outX, f32* outY, f32* outZ, f32* outW) {
+    s32 i;
+
+    if (outX != NULL) {
+        for (i = 0; i < count; i++) {
+            outX[i] = mf->xw + ((x[i] * mf->xx) + (y[i] * mf->xy) + (z[i] * mf->xz));
+        }
+    }
+    if (outY != NULL) {
+        for (i = 0; i < count; i++) {
+            outY[i] = mf->yw + ((x[i] * mf->yx) + (y[i] * mf->yy) + (z[i] * mf->yz));
+        }
+    }
+    if (outZ != NULL) {
+        for (i = 0; i < count; i++) {
+            outZ[i] = mf->zw + ((x[i] * mf->zx) + (y[i] * mf->zy) + (z[i] * mf->zz));
+        }
+    }
+    if (outW != NULL) {
+        for (i = 0; i < count; i++) {
+            outW[i] = mf->ww + ((x[i] * mf->wx) + (y[i] * mf->wy) + (z[i] * mf->wz));
+        }
+    }
+}
+
+/**
+ * Maps a float to an unsigned key with the same ordering. Both zeroes map to the same key, as they compare equal
+ */
+u32 CullBatch_GetSortKey(f32 depth) {
+    union {
+        f32 f;
+        u32 i;
+    } bits;
+
+    if (depth == 0.0f) {
+        return 0x80000000;
+    }
+
+    bits.f = depth;
+    if (bits.i & 0x80000000) {
+        return ~bits.i;
+    }
+    return bits.i | 0x80000000;
+}
+
+/**
+ * Fills `order` with the indices 0 to `count` - 1 of `depths`, sorted by ascending depth. Entries of equal depth keep
+ * their relative order. `count` must not exceed CULL_BATCH_MAX
+ */
+void CullBatch_SortByDepth(f32* depths, s32 count, u16* order) {
+    u32* keys = sCullBatchKeys[0];
+    u32* sortedKeys = sCullBatchKeys[1];
+    u16* src = order;
+    u16* dest = sCullBatchOrder;
+    u16* swapOrder;
+    u32* swapKeys;
+    u16 offsets[0x100];
+    u32 allBits;
+    u32 anyBits;
+    s32 shift;
+    s32 digit;
+    s32 i;
+
+    allBits = 0xFFFFFFFF;
+    anyBits = 0;
+    for (i = 0; i < count; i++) {
+        keys[i] = CullBatch_GetSortKey(depths[i]);
+        allBits &= keys[i];
+        anyBits |= keys[i];
+        order[i] = i;
+    }
+
+    for (shift = 0; shift < 32; shift += 8) {
+        // Skip digits shared by every key, sorting on them would not change the order
+        if (((allBits ^ anyBits) >> shift) & 0xFF) {
+            for (digit = 0; digit < ARRAY_COUNT(offsets); digit++) {
+                offsets[digit] = 0;
+            }
+            for (i = 0; i < count; i++) {
+                offsets[(keys[i] >> shift) & 0xFF]++;
+            }
+            for (i = 0, digit = 0; digit < ARRAY_COUNT(offsets); digit++) {
+                u16 digitCount = offsets[digit];
+
+                offsets[digit] = i;
+                i += digitCount;
+            }
+            for (i = 0; i < count; i++) {
+                u16 pos = offsets[(keys[i] >> shift) & 0xFF]++;
+
+                sortedKeys[pos] = keys[i];
+                dest[pos] = src[i];
+            }
+
+            swapKeys = keys;
+            keys = sortedKeys;
+            sortedKeys = swapKeys;
+            swapOrder = src;
+            src = dest;
+            dest = swapOrder;
+        }
+    }
+
+    if (src != order) {
+        for (i = 0; i < count; i++) {
+            order[i] = src[i];
+        }
+    }
+}
@@ -3,15 +3,34 @@
 
 EffectSsInfo sEffectSsInfo = { NULL, 0, 0 };
 
+EffectSsSlots sEffectSsSlots;
+EffectSsStats gEffectSsStats;
+
 void EffectSS_Init(PlayState* play, s32 numEntries) {
     u32 i;
     EffectSs* effectsSs;
     EffectSsOverlay* overlay;
+    s32 maskWords = (numEntries + 31) >> 5;
 
     sEffectSsInfo.data_table = (EffectSs*)THA_AllocTailAlign16(&play->state.heap, numEntries * sizeof(EffectSs));
     sEffectSsInfo.searchIndex = 0;
     sEffectSsInfo.size = numEntries;
 
+    sEffectSsSlots.maskWords = maskWords;
+    sEffectSsSlots.freeMask =
+        THA_AllocTailAlign16(&play->state.heap, (EFFECT_SS_BUCKET_COUNT + 2) * maskWords * sizeof(u32));
+    sEffectSsSlots.bucketMasks = &sEffectSsSlots.freeMask[maskWords];
+    sEffectSsSlots.candidateMask = &sEffectSsSlots.bucketMasks[EFFECT_SS_BUCKET_COUNT * maskWords];
+    sEffectSsSlots.keys = THA_AllocTailAlign16(&play->state.heap, numEntries * sizeof(u16));
+    bzero(sEffectSsSlots.freeMask, (EFFECT_SS_BUCKET_COUNT + 2) * maskWords * sizeof(u32));
+
+    // Start with every entry marked occupied at the lowest key, so the resets below move them all to the free mask
+    for (i = 0; i < (u32)numEntries; i++) {
+        sEffectSsSlots.keys[i] = 0;
+        sEffectSsSlots.bucketMasks[i >> 5] |= 1 << (i & 0x1F);
+    }
+    bzero(&gEffectSsStats, sizeof(EffectSsStats));
+
     for (effectsSs = &sEffectSsInfo.data_table[0]; effectsSs < &sEffectSsInfo.data_table[sEffectSsInfo.size];
          effectsSs++) {
         EffectSS_ResetEntry(effectsSs);
@@ -33,6 +52,7 @@ void EffectSS_Clear(PlayState* play) {
     sEffectSsInfo.data_table = NULL;
     sEffectSsInfo.searchIndex = 0;
     sEffectSsInfo.size = 0;
+    sEffectSsSlots.freeMask = NULL;
 
     //! @bug: Effects left in the table are not properly deleted, as data_table was just set to NULL and size to 0
     for (effectsSs = &sEffectSsInfo.data_table[0]; effectsSs < &sEffectSsInfo.data_table[sEffectSsInfo.size];
@@ -88,62 +108,145 @@ void EffectSS_ResetEntry(EffectSs* particle) {
     for (i = 0; i < ARRAY_COUNT(particle->regs); i++) {
         particle->regs[i] = 0;
     }
+
+    EffectSS_SyncSlot(particle);
 }
 
-s32 EffectSS_FindFreeSpace(s32 priority, s32* tableEntry) {
-    s32 foundFree;
-    s32 i;
+/**
+ * Updates the masks of `sEffectSsSlots` for the entry's current life, priority and flags.
+ * Must be called after anything that may change them; entries outside the table are ignored
+ */
+void EffectSS_SyncSlot(EffectSs* effectSs) {
+    s32 index;
+    s32 word;
+    u32 bit;
+    u16 key;
+    u16 prevKey;
 
-    if (sEffectSsInfo.searchIndex >= sEffectSsInfo.size) {
-        sEffectSsInfo.searchIndex = 0;
+    if ((sEffectSsSlots.freeMask == NULL) || (effectSs < &sEffectSsInfo.data_table[0]) ||
+        (effectSs >= &sEffectSsInfo.data_table[sEffectSsInfo.size])) {
+        return;
     }
 
-    // Search for a unused entry
-    i = sEffectSsInfo.searchIndex;
-    foundFree = false;
-    while (true) {
-        if (sEffectSsInfo.data_table[i].life == -1) {
-            foundFree = true;
-            break;
-        }
+    index = effectSs - sEffectSsInfo.data_table;
+    key = (effectSs->life == -1) ? EFFECT_SS_KEY_FREE : ((effectSs->priority << 1) | !(effectSs->flags & 1));
+    prevKey = sEffectSsSlots.keys[index];
 
-        i++;
+    if (key == prevKey) {
+        return;
+    }
+
+    word = index >> 5;
+    bit = 1 << (index & 0x1F);
+
+    if (prevKey == EFFECT_SS_KEY_FREE) {
+        sEffectSsSlots.freeMask[word] &= ~bit;
+    } else {
+        sEffectSsSlots.bucketMasks[(prevKey >> 5) * sEffectSsSlots.maskWords + word] &= ~bit;
+    }
 
-        if (i >= sEffectSsInfo.size) {
-            i = 0; // Loop around the whole table
+    if (key == EFFECT_SS_KEY_FREE) {
+        sEffectSsSlots.freeMask[word] |= bit;
+    } else {
+        sEffectSsSlots.bucketMasks[(key >> 5) * sEffectSsSlots.maskWords + word] |= bit;
+    }
+
+    sEffectSsSlots.keys[index] = key;
+}
+
+static u8 sLowestBitIndex[] = {
+    0,  1,  28, 2,  29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4,  8,
+    31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6,  11, 5,  10, 9,
+};
+
+/**
+ * Finds the first set bit of `mask` at or after `start`, looping around to the start of the table
+ * returns the entry index, or -1 if no bit is set
+ */
+s32 EffectSS_FindFirstInMask(u32* mask, s32 start) {
+    s32 word = start >> 5;
+    u32 bits = mask[word] & ~((1 << (start & 0x1F)) - 1);
+    s32 i;
+
+    // The extra iteration rechecks the start word, for the bits before `start`
+    for (i = 0; i <= sEffectSsSlots.maskWords; i++) {
+        gEffectSsStats.wordsScanned++;
+
+        if (bits != 0) {
+            return (word << 5) + sLowestBitIndex[((bits & -bits) * 0x077CB531) >> 27];
         }
 
-        // After a full loop, break out
-        if (i == sEffectSsInfo.searchIndex) {
-            break;
+        word++;
+        if (word >= sEffectSsSlots.maskWords) {
+            word = 0;
         }
+        bits = mask[word];
+    }
+
+    return -1;
+}
+
+/**
+ * Finds a table entry for a new effect of the given priority, the first free entry from `searchIndex` onwards or,
+ * if all are in use, the first that can be replaced.
+ * returns true if there is no suitable entry
+ */
+s32 EffectSS_FindFreeSpace(s32 priority, s32* tableEntry) {
+    s32 i;
+    s32 word;
+    s32 bucket;
+    s32 minKey;
+    s32 minBucket;
+    u32 bits;
+    u32 partial;
+    u32* bucketMasks = sEffectSsSlots.bucketMasks;
+
+    if (sEffectSsInfo.searchIndex >= sEffectSsInfo.size) {
+        sEffectSsInfo.searchIndex = 0;
     }
 
-    if (foundFree == true) {
+    // Search for a unused entry
+    i = EffectSS_FindFirstInMask(sEffectSsSlots.freeMask, sEffectSsInfo.searchIndex);
+    if (i >= 0) {
         *tableEntry = i;
         return false;
     }
 
     // If all slots are in use, search for a slot with a lower priority
-    // Note that a lower priority is representend by a higher value
-    i = sEffectSsInfo.searchIndex;
-    while (true) {
-        // Equal priority should only be considered "lower" if flag 0 is set
-        if ((priority <= sEffectSsInfo.data_table[i].priority) &&
-            !((priority == sEffectSsInfo.data_table[i].priority) && (sEffectSsInfo.data_table[i].flags & 1))) {
-            break;
+    // Note that a lower priority is representend by a higher value, and that equal priority should only be considered
+    // "lower" if flag 0 is not set. Both are folded into the eviction key
+    minKey = CLAMP_MIN((priority << 1) | 1, 0);
+    minBucket = minKey >> 5;
+
+    if (minBucket >= EFFECT_SS_BUCKET_COUNT) {
+        gEffectSsStats.failCount++;
+        return true;
+    }
+
+    for (word = 0; word < sEffectSsSlots.maskWords; word++) {
+        bits = 0;
+        for (bucket = minBucket + 1; bucket < EFFECT_SS_BUCKET_COUNT; bucket++) {
+            bits |= bucketMasks[bucket * sEffectSsSlots.maskWords + word];
         }
 
-        i++;
+        // Entries in the lowest bucket may have a key just below the minimum
+        partial = bucketMasks[minBucket * sEffectSsSlots.maskWords + word];
+        while (partial != 0) {
+            u32 bit = partial & -partial;
 
-        if (i >= sEffectSsInfo.size) {
-            i = 0; // Loop around the whole table
+            if (sEffectSsSlots.keys[(word << 5) + sLowestBitIndex[(bit * 0x077CB531) >> 27]] >= minKey) {
+                bits |= bit;
+            }
+            partial &= ~bit;
         }
 
-        // After a full loop, return 1 to indicate that we failed to find a suitable slot
-        if (i == sEffectSsInfo.searchIndex) {
-            return true;
-        }
+        sEffectSsSlots.candidateMask[word] = bits;
+    }
+
+    i = EffectSS_FindFirstInMask(sEffectSsSlots.candidateMask, sEffectSsInfo.searchIndex);
+    if (i < 0) {
+        gEffectSsStats.failCount++;
+        return true;
     }
 
     *tableEntry = i;
@@ -155,8 +258,12 @@ void EffectSS_Copy(PlayState* play, EffectSs* effectsSs) {
 
     if (FrameAdvance_IsEnabled(&play->state) != true) {
         if (EffectSS_FindFreeSpace(effectsSs->priority, &index) == 0) {
+            if (sEffectSsSlots.keys[index] != EFFECT_SS_KEY_FREE) {
+                gEffectSsStats.evictCount++;
+            }
             sEffectSsInfo.searchIndex = index + 1;
             sEffectSsInfo.data_table[index] = *effectsSs;
+            EffectSS_SyncSlot(&sEffectSsInfo.data_table[index]);
         }
     }
 }
@@ -197,6 +304,10 @@ void EffectSs_Spawn(PlayState* play, s32 type, s32 priority, void* initData) {
     }
 
     if (initInfo->init != NULL) {
+        if (sEffectSsSlots.keys[index] != EFFECT_SS_KEY_FREE) {
+            gEffectSsStats.evictCount++;
+        }
+
         // Delete the previous effect in the slot, in case the slot wasn't free
         EffectSS_Delete(&sEffectSsInfo.data_table[index]);
 
@@ -205,7 +316,10 @@ void EffectSs_Spawn(PlayState* play, s32 type, s32 priority, void* initData) {
 
         if (initInfo->init(play, index, &sEffectSsInfo.data_table[index], initData) == 0) {
             EffectSS_ResetEntry(&sEffectSsInfo.data_table[index]);
+        } else {
+            gEffectSsStats.spawnCount++;
         }
+        EffectSS_SyncSlot(&sEffectSsInfo.data_table[index]);
     }
 }
 
@@ -222,9 +336,17 @@ void EffectSS_UpdateParticle(PlayState* play, s32 index) {
         particle->pos.z += particle->velocity.z;
 
         particle->update(play, index, particle);
+        EffectSS_SyncSlot(particle);
     }
 }
 
+/**
+ * Starts a new gEffectSsStats window. Called at the start of every frame, before anything can spawn effects
+ */
+void EffectSS_ClearStats(void) {
+    bzero(&gEffectSsStats, sizeof(EffectSsStats));
+}
+
 void EffectSS_UpdateAllParticles(PlayState* play) {
     s32 i;
 
@@ -248,6 +370,7 @@ void EffectSS_DrawParticle(PlayState* play, s32 index) {
 
     if (entry->draw != NULL) {
         entry->draw(play, index, entry);
+        EffectSS_SyncSlot(entry);
     }
 }
 
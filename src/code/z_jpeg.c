@@ -16,9 +16,23 @@
 #define MARKER_COM 0xFE
 #define MARKER_EOI 0xD9
 
+#define JPEG_IDCT_CONST_BITS 13
+#define JPEG_IDCT_PASS1_BITS 2
+#define JPEG_DESCALE(x, n) (((x) + (1 << ((n)-1))) >> (n))
+
 extern u64 njpgdspMainTextStart[];
 extern u64 njpgdspMainDataStart[];
 
+// Natural (row-major) position of each coefficient, in the zigzag order the decoder and quantization tables use
+u8 sJpegZigZagToNatural[8 * 8] = {
+    0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,  12, 19, 26, 33, 40, 48,
+    41, 34, 27, 20, 13, 6,  7,  14, 21, 28, 35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23,
+    30, 37, 44, 51, 58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+};
+
+JpegHuffmanLookup sJpegHuffmanLookups[4];
+s32 sJpegDecodeOnCpu = false;
+
 /**
  * Configures and schedules a JPEG decoder task and waits for it to finish.
  */
@@ -70,6 +84,236 @@ void Jpeg_ScheduleDecoderTask(JpegContext* jpegCtx) {
     osRecvMesg(&jpegCtx->mq, NULL, OS_MESG_BLOCK);
 }
 
+/**
+ * Selects whether `Jpeg_Decode` runs the IDCT and color conversion on the CPU instead of scheduling the njpgdsp
+ * microcode. The output is close to, but not bit-identical with, the microcode's. Only images with 16x16 MCUs (mode 2)
+ * are decoded on the CPU, mode 0 images still use the microcode.
+ */
+void Jpeg_SetDecodeOnCpu(s32 onCpu) {
+    sJpegDecodeOnCpu = onCpu;
+}
+
+/**
+ * Dequantizes and inverse transforms an 8x8 block of zigzag ordered coefficients into 8-bit samples.
+ *
+ * This is the accurate integer IDCT from the IJG reference decoder: columns are transformed first with
+ * JPEG_IDCT_PASS1_BITS extra bits of precision, then rows, and the result is level shifted and clamped.
+ */
+void Jpeg_InverseDctBlock(u16* coeffs, JpegQuantizationTable* qTable, u8* out, s32 outStride) {
+    s32 block[8 * 8];
+    s32* ptr;
+    s32 tmp0;
+    s32 tmp1;
+    s32 tmp2;
+    s32 tmp3;
+    s32 tmp10;
+    s32 tmp11;
+    s32 tmp12;
+    s32 tmp13;
+    s32 z1;
+    s32 z2;
+    s32 z3;
+    s32 z4;
+    s32 z5;
+    s32 i;
+    s32 j;
+
+    for (i = 0; i < ARRAY_COUNT(block); i++) {
+        block[i] = 0;
+    }
+    for (i = 0; i < ARRAY_COUNT(block); i++) {
+        block[sJpegZigZagToNatural[i]] = (s16)coeffs[i] * qTable->table[i];
+    }
+
+    // Columns
+    for (i = 0; i < 8; i++) {
+        ptr = &block[i];
+
+        if ((ptr[8 * 1] | ptr[8 * 2] | ptr[8 * 3] | ptr[8 * 4] | ptr[8 * 5] | ptr[8 * 6] | ptr[8 * 7]) == 0) {
+            // Only the DC term, very common after quantization
+            tmp0 = ptr[0] << JPEG_IDCT_PASS1_BITS;
+            for (j = 0; j < 8; j++) {
+                ptr[8 * j] = tmp0;
+            }
+            continue;
+        }
+
+        z2 = ptr[8 * 2];
+        z3 = ptr[8 * 6];
+        z1 = (z2 + z3) * 4433;
+        tmp2 = z1 + z3 * -15137;
+        tmp3 = z1 + z2 * 6270;
+
+        tmp0 = (ptr[8 * 0] + ptr[8 * 4]) << JPEG_IDCT_CONST_BITS;
+        tmp1 = (ptr[8 * 0] - ptr[8 * 4]) << JPEG_IDCT_CONST_BITS;
+
+        tmp10 = tmp0 + tmp3;
+        tmp13 = tmp0 - tmp3;
+        tmp11 = tmp1 + tmp2;
+        tmp12 = tmp1 - tmp2;
+
+        tmp0 = ptr[8 * 7];
+        tmp1 = ptr[8 * 5];
+        tmp2 = ptr[8 * 3];
+        tmp3 = ptr[8 * 1];
+
+        z1 = tmp0 + tmp3;
+        z2 = tmp1 + tmp2;
+        z3 = tmp0 + tmp2;
+        z4 = tmp1 + tmp3;
+        z5 = (z3 + z4) * 9633;
+
+        tmp0 *= 2446;
+        tmp1 *= 16819;
+        tmp2 *= 25172;
+        tmp3 *= 12299;
+        z1 *= -7373;
+        z2 *= -20995;
+        z3 = z3 * -16069 + z5;
+        z4 = z4 * -3196 + z5;
+
+        tmp0 += z1 + z3;
+        tmp1 += z2 + z4;
+        tmp2 += z2 + z3;
+        tmp3 += z1 + z4;
+
+        ptr[8 * 0] = JPEG_DESCALE(tmp10 + tmp3, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 7] = JPEG_DESCALE(tmp10 - tmp3, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 1] = JPEG_DESCALE(tmp11 + tmp2, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 6] = JPEG_DESCALE(tmp11 - tmp2, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 2] = JPEG_DESCALE(tmp12 + tmp1, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 5] = JPEG_DESCALE(tmp12 - tmp1, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 3] = JPEG_DESCALE(tmp13 + tmp0, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 4] = JPEG_DESCALE(tmp13 - tmp0, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+    }
+
+    // Rows
+    for (i = 0; i < 8; i++) {
+        ptr = &block[8 * i];
+
+        if ((ptr[1] | ptr[2] | ptr[3] | ptr[4] | ptr[5] | ptr[6] | ptr[7]) == 0) {
+            tmp0 = JPEG_DESCALE(ptr[0], JPEG_IDCT_PASS1_BITS + 3) + 128;
+            tmp0 = CLAMP(tmp0, 0, 255);
+            for (j = 0; j < 8; j++) {
+                out[j] = tmp0;
+            }
+            out += outStride;
+            continue;
+        }
+
+        z2 = ptr[2];
+        z3 = ptr[6];
+        z1 = (z2 + z3) * 4433;
+        tmp2 = z1 + z3 * -15137;
+        tmp3 = z1 + z2 * 6270;
+
+        tmp0 = (ptr[0] + ptr[4]) << JPEG_IDCT_CONST_BITS;
+        tmp1 = (ptr[0] - ptr[4]) << JPEG_IDCT_CONST_BITS;
+
+        tmp10 = tmp0 + tmp3;
+        tmp13 = tmp0 - tmp3;
+        tmp11 = tmp1 + tmp2;
+        tmp12 = tmp1 - tmp2;
+
+        tmp0 = ptr[7];
+        tmp1 = ptr[5];
+        tmp2 = ptr[3];
+        tmp3 = ptr[1];
+
+        z1 = tmp0 + tmp3;
+        z2 = tmp1 + tmp2;
+        z3 = tmp0 + tmp2;
+        z4 = tmp1 + tmp3;
+        z5 = (z3 + z4) * 9633;
+
+        tmp0 *= 2446;
+        tmp1 *= 16819;
+        tmp2 *= 25172;
+        tmp3 *= 12299;
+        z1 *= -7373;
+        z2 *= -20995;
+        z3 = z3 * -16069 + z5;
+        z4 = z4 * -3196 + z5;
+
+        tmp0 += z1 + z3;
+        tmp1 += z2 + z4;
+        tmp2 += z2 + z3;
+        tmp3 += z1 + z4;
+
+        ptr[0] = tmp10 + tmp3;
+        ptr[7] = tmp10 - tmp3;
+        ptr[1] = tmp11 + tmp2;
+        ptr[6] = tmp11 - tmp2;
+        ptr[2] = tmp12 + tmp1;
+        ptr[5] = tmp12 - tmp1;
+        ptr[3] = tmp13 + tmp0;
+        ptr[4] = tmp13 - tmp0;
+
+        for (j = 0; j < 8; j++) {
+            tmp0 = JPEG_DESCALE(ptr[j], JPEG_IDCT_CONST_BITS + JPEG_IDCT_PASS1_BITS + 3) + 128;
+            out[j] = CLAMP(tmp0, 0, 255);
+        }
+        out += outStride;
+    }
+}
+
+/**
+ * Decodes one mode 2 MCU of coefficients, as laid out by `JpegDecoder_Decode`, into 16x16 RGBA16 pixels written over
+ * `mcu`. Chroma is upsampled by repetition.
+ */
+void Jpeg_DecodeMcuOnCpu(u16* mcu, JpegWork* workBuf) {
+    u8 lum[16 * 16];
+    u8 cb[8 * 8];
+    u8 cr[8 * 8];
+    s32 i;
+    s32 x;
+    s32 y;
+    s32 lumVal;
+    s32 cbVal;
+    s32 crVal;
+    s32 r;
+    s32 g;
+    s32 b;
+
+    for (i = 0; i < 4; i++) {
+        Jpeg_InverseDctBlock(&mcu[i * 8 * 8], &workBuf->qTableY, &lum[(i >> 1) * 8 * 16 + (i & 1) * 8], 16);
+    }
+    Jpeg_InverseDctBlock(&mcu[4 * 8 * 8], &workBuf->qTableU, cb, 8);
+    Jpeg_InverseDctBlock(&mcu[5 * 8 * 8], &workBuf->qTableV, cr, 8);
+
+    for (y = 0; y < 16; y++) {
+        for (x = 0; x < 16; x++) {
+            lumVal = lum[y * 16 + x];
+            i = (y >> 1) * 8 + (x >> 1);
+            cbVal = cb[i] - 128;
+            crVal = cr[i] - 128;
+
+            // JFIF conversion in 16-bit fixed point
+            r = lumVal + ((91881 * crVal + (1 << 15)) >> 16);
+            g = lumVal + ((-22554 * cbVal - 46802 * crVal + (1 << 15)) >> 16);
+            b = lumVal + ((116130 * cbVal + (1 << 15)) >> 16);
+            r = CLAMP(r, 0, 255);
+            g = CLAMP(g, 0, 255);
+            b = CLAMP(b, 0, 255);
+
+            mcu[y * 16 + x] = ((r >> 3) << 11) | ((g >> 3) << 6) | ((b >> 3) << 1) | 1;
+        }
+    }
+}
+
+/**
+ * CPU replacement for `Jpeg_ScheduleDecoderTask` for mode 2 images, decoding the 4 MCUs in the work buffer in place.
+ */
+void Jpeg_DecodeOnCpu(JpegContext* jpegCtx) {
+    JpegWork* workBuf = jpegCtx->workBuf;
+    s32 i;
+
+    // Mode 2 MCUs are 6 blocks, so each fills one entry of `data`, and its pixels overwrite its own coefficients
+    for (i = 0; i < ARRAY_COUNT(workBuf->data); i++) {
+        Jpeg_DecodeMcuOnCpu(workBuf->data[i], workBuf);
+    }
+}
+
 /**
  * Copies a 16x16 block of decoded image data to the Z-buffer.
  */
@@ -276,6 +520,10 @@ s32 Jpeg_Decode(void* data, void* zbuffer, void* work, u32 workSize) {
             return -1;
     }
 
+    for (i = 0; i < ARRAY_COUNT(hTables); i++) {
+        JpegUtils_SetHuffmanLookup(&hTables[i], &sJpegHuffmanLookups[i]);
+    }
+
     decoder.imageData = jpegCtx.imageData;
     decoder.mode = jpegCtx.mode;
     decoder.unk_05 = 2;
@@ -289,7 +537,11 @@ s32 Jpeg_Decode(void* data, void* zbuffer, void* work, u32 workSize) {
     x = y = 0;
     for (i = 0; i < 300; i += 4) {
         if (!JpegDecoder_Decode(&decoder, (u16*)workBuff->data, 4, (i != 0), &state)) {
-            Jpeg_ScheduleDecoderTask(&jpegCtx);
+            if (sJpegDecodeOnCpu && (jpegCtx.mode == 2)) {
+                Jpeg_DecodeOnCpu(&jpegCtx);
+            } else {
+                Jpeg_ScheduleDecoderTask(&jpegCtx);
+            }
 
             for (j = 0; j < 4; j++) {
                 Jpeg_CopyToZbuffer(workBuff->data[j], zbuffer, x, y);
@@ -3,6 +3,7 @@
 #include "objects/gameplay_keep/gameplay_keep.h"
 
 LightsBuffer sLightsBuffer;
+LightGrid sLightGrid;
 
 void Lights_PointSetInfo(LightInfo* info, s16 x, s16 y, s16 z, u8 r, u8 g, u8 b, s16 radius, s32 type) {
     info->type = type;
@@ -217,6 +218,104 @@ void Lights_BindAll(Lights* lights, LightNode* listHead, Vec3f* refPos, PlayStat
     }
 }
 
+s32 LightGrid_GetCell(f32 coord) {
+    return (s32)coord >> LIGHT_GRID_CELL_SHIFT;
+}
+
+s32 LightGrid_GetBucket(s32 cellX, s32 cellZ) {
+    return ((cellX * 73856093) ^ (cellZ * 19349663)) & (LIGHT_GRID_BUCKET_COUNT - 1);
+}
+
+/**
+ * Buckets the lights of `lightCtx` by the xz cells they can reach, and starts a new frame of Lights group reuse.
+ * Called at the start of `Actor_DrawAll`.
+ *
+ * Inserting or removing a light discards the grid until the next build. Light positions and radii are only sampled
+ * here, so a light that moved further than LIGHT_GRID_MOVE_MARGIN or grew since can be missed by
+ * `LightGrid_BindAll`
+ */
+void LightGrid_Build(LightContext* lightCtx) {
+    LightNode* node;
+    LightPoint* params;
+    f32 range;
+    s32 minX;
+    s32 maxX;
+    s32 minZ;
+    s32 maxZ;
+    s32 x;
+    s32 z;
+    s32 i;
+
+    for (i = 0; i < LIGHT_GRID_BUCKET_COUNT; i++) {
+        sLightGrid.bucketMasks[i] = 0;
+    }
+    sLightGrid.globalMask = 0;
+    sLightGrid.count = 0;
+
+    for (node = lightCtx->listHead; (node != NULL) && (sLightGrid.count < LIGHTS_BUFFER_SIZE); node = node->next) {
+        i = sLightGrid.count++;
+        sLightGrid.nodes[i] = node;
+
+        if (node->info->type == LIGHT_DIRECTIONAL) {
+            sLightGrid.globalMask |= 1U << i;
+            continue;
+        }
+
+        params = &node->info->params.point;
+        range = params->radius + LIGHT_GRID_MOVE_MARGIN;
+        minX = LightGrid_GetCell(params->x - range);
+        maxX = LightGrid_GetCell(params->x + range);
+        minZ = LightGrid_GetCell(params->z - range);
+        maxZ = LightGrid_GetCell(params->z + range);
+
+        if ((maxX - minX + 1) * (maxZ - minZ + 1) > LIGHT_GRID_BUCKET_COUNT / 2) {
+            sLightGrid.globalMask |= 1U << i;
+            continue;
+        }
+
+        for (z = minZ; z <= maxZ; z++) {
+            for (x = minX; x <= maxX; x++) {
+                sLightGrid.bucketMasks[LightGrid_GetBucket(x, z)] |= 1U << i;
+            }
+        }
+    }
+
+    sLightGrid.prevLights = NULL;
+    sLightGrid.numGroups = 0;
+    sLightGrid.numReused = 0;
+    sLightGrid.isBuilt = true;
+}
+
+/**
+ * Equivalent to `Lights_BindAll` with a reference position, but only visits the lights that may reach the cell of
+ * `refPos`, in list order
+ */
+void LightGrid_BindAll(Lights* lights, Vec3f* refPos) {
+    u32 mask = sLightGrid.globalMask | sLightGrid.bucketMasks[LightGrid_GetBucket(LightGrid_GetCell(refPos->x),
+                                                                                  LightGrid_GetCell(refPos->z))];
+    LightInfo* info;
+    s32 i;
+
+    for (i = 0; mask != 0; i++, mask >>= 1) {
+        if (mask & 1) {
+            info = sLightGrid.nodes[i]->info;
+
+            if (info->type == LIGHT_DIRECTIONAL) {
+                Lights_BindDirectional(lights, &info->params, NULL);
+            } else {
+                Lights_BindPointWithReference(lights, &info->params, refPos);
+            }
+        }
+    }
+}
+
+/**
+ * Debug accessor for the light grid and the Lights group reuse counters of the current frame
+ */
+LightGrid* LightGrid_Get(void) {
+    return &sLightGrid;
+}
+
 LightNode* Lights_FindBufSlot(void) {
     LightNode* ret;
 
@@ -277,6 +376,43 @@ Lights* LightContext_NewLights(LightContext* lightCtx, GraphicsContext* gfxCtx)
     return Lights_New(gfxCtx, lightCtx->ambient.r, lightCtx->ambient.g, lightCtx->ambient.b);
 }
 
+/**
+ * Equivalent to `LightContext_NewLights` followed by `Lights_BindAll` on the light list, with `enablePosLights` set
+ * on the new group. Uses the light grid when it is built, and returns the group of the previous call again if the new
+ * one would be identical
+ */
+Lights* LightContext_NewBoundLights(PlayState* play, Vec3f* refPos, s32 enablePosLights) {
+    LightContext* lightCtx = &play->lightCtx;
+    Lights lights;
+    Lights* newLights;
+    s32 size;
+
+    // Cleared so that bytes the bind functions do not write compare equal
+    bzero(&lights, sizeof(Lights));
+    lights.l.a.l.col[0] = lights.l.a.l.colc[0] = lightCtx->ambient.r;
+    lights.l.a.l.col[1] = lights.l.a.l.colc[1] = lightCtx->ambient.g;
+    lights.l.a.l.col[2] = lights.l.a.l.colc[2] = lightCtx->ambient.b;
+    lights.enablePosLights = enablePosLights;
+
+    if (sLightGrid.isBuilt && (refPos != NULL)) {
+        LightGrid_BindAll(&lights, refPos);
+    } else {
+        Lights_BindAll(&lights, lightCtx->listHead, refPos, play);
+    }
+
+    sLightGrid.numGroups++;
+    size = (u8*)&lights.l.l[lights.numLights] - (u8*)&lights;
+    if ((sLightGrid.prevLights != NULL) && (bcmp(sLightGrid.prevLights, &lights, size) == 0)) {
+        sLightGrid.numReused++;
+        return sLightGrid.prevLights;
+    }
+
+    newLights = GRAPH_ALLOC(play->state.gfxCtx, sizeof(Lights));
+    *newLights = lights;
+    sLightGrid.prevLights = newLights;
+    return newLights;
+}
+
 void LightContext_InitList(PlayState* play, LightContext* lightCtx) {
     lightCtx->listHead = NULL;
 }
@@ -299,6 +435,7 @@ LightNode* LightContext_InsertLight(PlayState* play, LightContext* lightCtx, Lig
 
     light = Lights_FindBufSlot();
     if (light != NULL) {
+        sLightGrid.isBuilt = false;
         light->info = info;
         light->prev = NULL;
         light->next = lightCtx->listHead;
@@ -315,6 +452,8 @@ LightNode* LightContext_InsertLight(PlayState* play, LightContext* lightCtx, Lig
 
 void LightContext_RemoveLight(PlayState* play, LightContext* lightCtx, LightNode* light) {
     if (light != NULL) {
+        sLightGrid.isBuilt = false;
+
         if (light->prev != NULL) {
             light->prev->next = light->next;
         } else {
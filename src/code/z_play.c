@@ -1060,6 +1060,8 @@ void Play_UpdateMain(PlayState* this);
 #endif
 
 void Play_Update(PlayState* this) {
+    EffectSS_ClearStats();
+
     if (!sBombersNotebookOpen) {
         if (this->pauseCtx.bombersNotebookOpen) {
             sBombersNotebookOpen = true;
@@ -1267,6 +1269,8 @@ void Play_DrawMain(PlayState* this) {
             if (R_PAUSE_BG_PRERENDER_STATE == PAUSE_BG_PRERENDER_READY) {
                 Gfx* sp8C = POLY_OPA_DISP;
 
+                PreRender_ApplyFiltersSlowlyUpdate(&this->pauseBgPreRender);
+
                 if (this->pauseBgPreRender.filterState == PRERENDER_FILTER_STATE_DONE) {
                     PreRender_RestoreFramebuffer(&this->pauseBgPreRender, &sp8C);
                 } else {
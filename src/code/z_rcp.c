@@ -891,6 +891,87 @@ Gfx* Gfx_SetFog2(Gfx* gfx, s32 r, s32 g, s32 b, s32 a, s32 n, s32 f) {
     return Gfx_SetFog(gfx, r, g, b, a, n, f);
 }
 
+/**
+ * Presets appended by the GraphicsContext variants below since the last `Graph_SetNextGfxPool`. Calling the same
+ * preset again while only commands that leave its render state alone were appended after it would reload the same
+ * state, so the call is not emitted again
+ */
+Gfx* sSetupDLEnds[GRAPH_DISP_OVERLAY + 1];
+u32 sSetupDLSavedCmds;
+u32 sSetupDLSavedCmdsLastFrame;
+
+// Most commands looked through for the last preset, enough for the lights and segments `Actor_Draw` emits
+#define SETUPDL_MAX_LOOKBACK 24
+
+/**
+ * Called when the display list arenas are reset, as any recorded end would point into a previous frame
+ */
+void Gfx_ResetSetupDLCache(void) {
+    s32 i;
+
+    sSetupDLSavedCmdsLastFrame = sSetupDLSavedCmds;
+    sSetupDLSavedCmds = 0;
+    for (i = 0; i < ARRAY_COUNT(sSetupDLEnds); i++) {
+        sSetupDLEnds[i] = NULL;
+    }
+}
+
+/**
+ * Returns whether the commands in [`start`, `end`) leave the render state set by the presets alone. Presets only set
+ * other modes, combiners, geometry modes and texture scales, so segments and other moved words, lights and matrices
+ * are let through. Anything else, including calls and branches to other display lists, is not
+ */
+s32 Gfx_KeepsSetupDLState(Gfx* start, Gfx* end) {
+    Gfx* gfx;
+
+    if ((end < start) || ((end - start) > SETUPDL_MAX_LOOKBACK)) {
+        return false;
+    }
+
+    for (gfx = start; gfx < end; gfx++) {
+        switch (_SHIFTR(gfx->words.w0, 24, 8)) {
+            case G_MOVEWORD:
+            case G_MOVEMEM:
+            case G_MTX:
+                break;
+
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Appends a call to the `i`th preset to the display list `disp` at `*gfxp`, unless that call is the last preset
+ * appended there and nothing appended since changes the state it sets
+ */
+void Gfx_AppendSetupDL(Gfx** gfxp, s32 disp, u32 i) {
+    Gfx* gfx = *gfxp;
+    Gfx* prevEnd = sSetupDLEnds[disp];
+    Gfx cmd;
+
+    gSPDisplayList(&cmd, gSetupDLs[i]);
+
+    if ((prevEnd != NULL) && (prevEnd[-1].words.w0 == cmd.words.w0) && (prevEnd[-1].words.w1 == cmd.words.w1) &&
+        Gfx_KeepsSetupDLState(prevEnd, gfx)) {
+        // The display list call plus the commands of the preset itself
+        sSetupDLSavedCmds += 1 + ARRAY_COUNT(gSetupDLs[i]);
+        return;
+    }
+
+    *gfx++ = cmd;
+    sSetupDLEnds[disp] = gfx;
+    *gfxp = gfx;
+}
+
+/**
+ * Debug accessor for the number of RSP commands skipped by `Gfx_AppendSetupDL` during the last complete frame
+ */
+u32 Gfx_GetSetupDLSavedCmds(void) {
+    return sSetupDLSavedCmdsLastFrame;
+}
+
 Gfx* Gfx_SetupDLImpl(Gfx* gfx, u32 i) {
     s32 dListIndex = i * ARRAY_COUNT(gSetupDLs[i]);
 
@@ -926,7 +1007,7 @@ Gfx* Gfx_SetupDL52_NoCD(Gfx* gfx) {
 void Gfx_SetupDL58_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_58]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_58);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -934,7 +1015,7 @@ void Gfx_SetupDL58_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL57_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_57]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_57);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -942,7 +1023,7 @@ void Gfx_SetupDL57_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL50_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_50]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_50);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -950,7 +1031,7 @@ void Gfx_SetupDL50_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL51_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_51]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_51);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -958,7 +1039,7 @@ void Gfx_SetupDL51_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL52_Xlu(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_52]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_52);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -966,7 +1047,7 @@ void Gfx_SetupDL52_Xlu(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL53_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_53]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_53);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -974,7 +1055,7 @@ void Gfx_SetupDL53_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL54_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_54]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_54);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -982,7 +1063,7 @@ void Gfx_SetupDL54_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL55_Xlu(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_55]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_55);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -995,7 +1076,7 @@ Gfx* Gfx_SetupDL26(Gfx* gfx) {
 void Gfx_SetupDL26_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    POLY_OPA_DISP = Gfx_SetupDL26(POLY_OPA_DISP);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_26);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1008,7 +1089,7 @@ Gfx* Gfx_SetupDL23(Gfx* gfx) {
 void Gfx_SetupDL23_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    POLY_OPA_DISP = Gfx_SetupDL23(POLY_OPA_DISP);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_23);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1016,7 +1097,7 @@ void Gfx_SetupDL23_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL25_Xlu2(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_25]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_25);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1028,7 +1109,7 @@ void func_8012C268(GameState* gameState) {
 void Gfx_SetupDL25_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_25]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_25);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1041,7 +1122,7 @@ Gfx* Gfx_SetupDL71(Gfx* gfx) {
 void Gfx_SetupDL25_Xlu(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_25]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_25);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1054,7 +1135,7 @@ Gfx* Gfx_SetupDL72(Gfx* gfx) {
 void Gfx_SetupDL31_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_31]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_31);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1062,7 +1143,7 @@ void Gfx_SetupDL31_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL32_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_32]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_32);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1070,7 +1151,7 @@ void Gfx_SetupDL32_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL33_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_33]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_33);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1088,7 +1169,7 @@ Gfx* Gfx_SetupDL34(Gfx* gfx) {
 void Gfx_SetupDL34_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    POLY_OPA_DISP = Gfx_SetupDL34(POLY_OPA_DISP);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_34);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1096,7 +1177,7 @@ void Gfx_SetupDL34_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL35_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_35]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_35);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1104,7 +1185,7 @@ void Gfx_SetupDL35_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL44_Xlu(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_44]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_44);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1112,7 +1193,7 @@ void Gfx_SetupDL44_Xlu(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL36_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_36]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_36);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1125,7 +1206,7 @@ Gfx* Gfx_SetupDL28(Gfx* gfx) {
 void Gfx_SetupDL28_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_28]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_28);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1133,7 +1214,7 @@ void Gfx_SetupDL28_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL43_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_43]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_43);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1141,7 +1222,7 @@ void Gfx_SetupDL43_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL45_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_45]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_45);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1149,7 +1230,7 @@ void Gfx_SetupDL45_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL46_Overlay(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(OVERLAY_DISP++, gSetupDLs[SETUPDL_46]);
+    Gfx_AppendSetupDL(&OVERLAY_DISP, GRAPH_DISP_OVERLAY, SETUPDL_46);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1157,7 +1238,7 @@ void Gfx_SetupDL46_Overlay(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL38_Xlu(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_38]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_38);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1165,7 +1246,7 @@ void Gfx_SetupDL38_Xlu(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL4_Xlu(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_4]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_4);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1173,7 +1254,7 @@ void Gfx_SetupDL4_Xlu(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL37_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_37]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_37);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1181,7 +1262,7 @@ void Gfx_SetupDL37_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL2_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_2]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_2);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1194,7 +1275,7 @@ Gfx* Gfx_SetupDL39(Gfx* gfx) {
 void Gfx_SetupDL39_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    POLY_OPA_DISP = Gfx_SetupDL39(POLY_OPA_DISP);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_39);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1202,7 +1283,7 @@ void Gfx_SetupDL39_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL39_Overlay(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    OVERLAY_DISP = Gfx_SetupDL39(OVERLAY_DISP);
+    Gfx_AppendSetupDL(&OVERLAY_DISP, GRAPH_DISP_OVERLAY, SETUPDL_39);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1217,7 +1298,7 @@ void Gfx_SetupDL39_Ptr(Gfx** gfxp) {
 void Gfx_SetupDL40_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_40]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_40);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1225,7 +1306,7 @@ void Gfx_SetupDL40_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL41_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_41]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_41);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1233,7 +1314,7 @@ void Gfx_SetupDL41_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL47_Xlu(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_47]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_47);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1280,7 +1361,7 @@ Gfx* Gfx_SetupDL20_NoCD(Gfx* gfx) {
 void Gfx_SetupDL42_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_42]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_42);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1288,7 +1369,7 @@ void Gfx_SetupDL42_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL42_Overlay(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(OVERLAY_DISP++, gSetupDLs[SETUPDL_42]);
+    Gfx_AppendSetupDL(&OVERLAY_DISP, GRAPH_DISP_OVERLAY, SETUPDL_42);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1296,7 +1377,7 @@ void Gfx_SetupDL42_Overlay(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL48_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_48]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_48);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1304,7 +1385,7 @@ void Gfx_SetupDL48_Opa(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL49_Xlu(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_49]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_49);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1312,7 +1393,7 @@ void Gfx_SetupDL49_Xlu(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL27_Xlu(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_27]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_27);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1320,7 +1401,7 @@ void Gfx_SetupDL27_Xlu(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL60_XluNoCD(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_60]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_60);
     gDPSetColorDither(POLY_XLU_DISP++, G_CD_DISABLE);
 
     CLOSE_DISPS(gfxCtx);
@@ -1329,7 +1410,7 @@ void Gfx_SetupDL60_XluNoCD(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL61_Xlu(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_XLU_DISP++, gSetupDLs[SETUPDL_61]);
+    Gfx_AppendSetupDL(&POLY_XLU_DISP, GRAPH_DISP_XLU, SETUPDL_61);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1337,7 +1418,7 @@ void Gfx_SetupDL61_Xlu(GraphicsContext* gfxCtx) {
 void Gfx_SetupDL56_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_56]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_56);
 
     CLOSE_DISPS(gfxCtx);
 }
@@ -1352,7 +1433,7 @@ void Gfx_SetupDL56_Ptr(Gfx** gfxp) {
 void Gfx_SetupDL59_Opa(GraphicsContext* gfxCtx) {
     OPEN_DISPS(gfxCtx);
 
-    gSPDisplayList(POLY_OPA_DISP++, gSetupDLs[SETUPDL_59]);
+    Gfx_AppendSetupDL(&POLY_OPA_DISP, GRAPH_DISP_OPA, SETUPDL_59);
 
     CLOSE_DISPS(gfxCtx);
 }
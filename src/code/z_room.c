@@ -63,6 +63,12 @@ typedef struct RoomShapeCullableEntryLinked {
 
 #define ROOM_SHAPE_CULLABLE_MAX_ENTRIES 128
 
+f32 sRoomCullPosX[ROOM_SHAPE_CULLABLE_MAX_ENTRIES];
+f32 sRoomCullPosY[ROOM_SHAPE_CULLABLE_MAX_ENTRIES];
+f32 sRoomCullPosZ[ROOM_SHAPE_CULLABLE_MAX_ENTRIES];
+f32 sRoomCullProjectedZ[ROOM_SHAPE_CULLABLE_MAX_ENTRIES];
+f32 sRoomCullNearZ[ROOM_SHAPE_CULLABLE_MAX_ENTRIES];
+
 void Room_DrawCullable(PlayState* play, Room* room, u32 flags) {
     RoomShapeCullable* roomShape;
     RoomShapeCullableEntry* roomShapeCullableEntry;
@@ -74,8 +80,6 @@ void Room_DrawCullable(PlayState* play, Room* room, u32 flags) {
     RoomShapeCullableEntryLinked* insert;
     f32 entryBoundsNearZ;
     s32 i;
-    Vec3f pos;
-    Vec3f projectedPos;
     RoomShapeCullableEntry* roomShapeCullableEntries;
 
     OPEN_DISPS(play->state.gfxCtx);
@@ -152,25 +156,31 @@ void Room_DrawCullable(PlayState* play, Room* room, u32 flags) {
         f32 var_fa1 = 1.0f / play->projectionMtxFDiagonal.z;
         f32 var_fv1;
         s32 var_a1;
+        f32 projectedZ;
+        s32 count = 0;
+        u16 order[ROOM_SHAPE_CULLABLE_MAX_ENTRIES];
 
-        // Pick and sort entries by depth
+        // Project all the entry positions at once, to get the depth they are at.
         for (i = 0; i < roomShape->numEntries; i++, roomShapeCullableEntry++) {
+            sRoomCullPosX[i] = roomShapeCullableEntry->boundsSphereCenter.x;
+            sRoomCullPosY[i] = roomShapeCullableEntry->boundsSphereCenter.y;
+            sRoomCullPosZ[i] = roomShapeCullableEntry->boundsSphereCenter.z;
+        }
+        CullBatch_Project(&play->viewProjectionMtxF, sRoomCullPosX, sRoomCullPosY, sRoomCullPosZ, roomShape->numEntries,
+                          NULL, NULL, sRoomCullProjectedZ, NULL);
 
-            // Project the entry position, to get the depth it is at.
-            pos.x = roomShapeCullableEntry->boundsSphereCenter.x;
-            pos.y = roomShapeCullableEntry->boundsSphereCenter.y;
-            pos.z = roomShapeCullableEntry->boundsSphereCenter.z;
-            SkinMatrix_Vec3fMtxFMultXYZ(&play->viewProjectionMtxF, &pos, &projectedPos);
-
-            projectedPos.z *= var_fa1;
+        // Pick entries
+        roomShapeCullableEntry = roomShapeCullableEntries;
+        for (i = 0; i < roomShape->numEntries; i++, roomShapeCullableEntry++) {
+            projectedZ = sRoomCullProjectedZ[i] * var_fa1;
 
             var_fv1 = ABS_ALT(roomShapeCullableEntry->boundsSphereRadius);
 
             // If the entry bounding sphere isn't fully before the rendered depth range
-            if (-var_fv1 < projectedPos.z) {
+            if (-var_fv1 < projectedZ) {
 
                 // Compute the depth of the nearest point in the entry's bounding sphere
-                entryBoundsNearZ = projectedPos.z - var_fv1;
+                entryBoundsNearZ = projectedZ - var_fv1;
 
                 // If the entry bounding sphere isn't fully beyond the rendered depth range
                 if (entryBoundsNearZ < play->lightCtx.zFar) {
@@ -183,43 +193,27 @@ void Room_DrawCullable(PlayState* play, Room* room, u32 flags) {
                     } else {
                         insert->boundsNearZ = entryBoundsNearZ;
                     }
-
-                    // Insert into the linked list, ordered by ascending depth of the nearest point in the bounding
-                    // sphere
-                    iter = head;
-                    if (iter == NULL) {
-                        head = tail = insert;
-                        insert->prev = insert->next = NULL;
-                    } else {
-                        do {
-                            if (insert->boundsNearZ < iter->boundsNearZ) {
-                                break;
-                            }
-                            iter = iter->next;
-                        } while (iter != NULL);
-
-                        if (iter == NULL) {
-                            insert->prev = tail;
-                            insert->next = NULL;
-                            tail->next = insert;
-                            tail = insert;
-                        } else {
-                            insert->prev = iter->prev;
-                            if (insert->prev == NULL) {
-                                head = insert;
-                            } else {
-                                insert->prev->next = insert;
-                            }
-                            iter->prev = insert;
-                            insert->next = iter;
-                        }
-                    }
+                    sRoomCullNearZ[count++] = insert->boundsNearZ;
 
                     insert++;
                 }
             }
         }
 
+        // Link the picked entries, ordered by ascending depth of the nearest point in the bounding sphere
+        CullBatch_SortByDepth(sRoomCullNearZ, count, order);
+        for (i = 0; i < count; i++) {
+            iter = &linkedEntriesBuffer[order[i]];
+            iter->prev = tail;
+            iter->next = NULL;
+            if (tail == NULL) {
+                head = iter;
+            } else {
+                tail->next = iter;
+            }
+            tail = iter;
+        }
+
         //! FAKE: Similar trick used in OoT
         R_ROOM_CULL_NUM_ENTRIES = roomShape->numEntries & 0xFFFF & 0xFFFF & 0xFFFF;
 
@@ -28,6 +28,31 @@ static AnimationEntryCallback sAnimationLoadDone[] = {
 s32 sAnimQueueFlags;
 s32 sDisableAnimQueueFlags;
 
+/**
+ * Steps the preorder walk over the limb tree that the limb draw functions use in place of recursion. Called after
+ * `limb`, at `limbIndex`, has been drawn with its matrix pushed: descends into its children if it has any, otherwise
+ * pops matrices back up to the next sibling, in the same order the recursive draw did. `parents` holds the limbs
+ * whose children are being drawn, and can be as deep as LIMB_DONE. All limb types start with the fields read here
+ * returns the next limb index to draw, or LIMB_DONE once the limb the walk started from and its siblings are drawn
+ */
+s32 SkelAnime_GetNextLimb(void** skeleton, s32 limbIndex, StandardLimb* limb, u8* parents, s32* depth) {
+    if (limb->child != LIMB_DONE) {
+        parents[(*depth)++] = limbIndex;
+        return limb->child;
+    }
+
+    while (true) {
+        Matrix_Pop();
+        if (limb->sibling != LIMB_DONE) {
+            return limb->sibling;
+        }
+        if (*depth == 0) {
+            return LIMB_DONE;
+        }
+        limb = Lib_SegmentedToVirtual(skeleton[parents[--(*depth)]]);
+    }
+}
+
 /*
  * Draws the limb at `limbIndex` with a level of detail display lists index by `dListIndex`
  */
@@ -37,44 +62,40 @@ void SkelAnime_DrawLimbLod(PlayState* play, s32 limbIndex, void** skeleton, Vec3
     Gfx* dList;
     Vec3f pos;
     Vec3s rot;
+    u8 parents[LIMB_DONE];
+    s32 depth = 0;
 
     OPEN_DISPS(play->state.gfxCtx);
 
-    Matrix_Push();
-    limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
-    limbIndex++;
-    rot = jointTable[limbIndex];
+    do {
+        Matrix_Push();
+        limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
+        limbIndex++;
+        rot = jointTable[limbIndex];
 
-    pos.x = limb->jointPos.x;
-    pos.y = limb->jointPos.y;
-    pos.z = limb->jointPos.z;
+        pos.x = limb->jointPos.x;
+        pos.y = limb->jointPos.y;
+        pos.z = limb->jointPos.z;
 
-    dList = limb->dLists[lod];
-    if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &dList, &pos, &rot, actor)) {
-        Matrix_TranslateRotateZYX(&pos, &rot);
-        if (dList != NULL) {
-            Gfx* polyTemp = POLY_OPA_DISP;
+        dList = limb->dLists[lod];
+        if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &dList, &pos, &rot, actor)) {
+            Matrix_TranslateRotateZYX(&pos, &rot);
+            if (dList != NULL) {
+                Gfx* polyTemp = POLY_OPA_DISP;
 
-            gSPMatrix(&polyTemp[0], Matrix_NewMtx(play->state.gfxCtx), G_MTX_LOAD);
+                gSPMatrix(&polyTemp[0], Matrix_NewMtx(play->state.gfxCtx), G_MTX_LOAD);
 
-            gSPDisplayList(&polyTemp[1], dList);
-            POLY_OPA_DISP = &polyTemp[2];
+                gSPDisplayList(&polyTemp[1], dList);
+                POLY_OPA_DISP = &polyTemp[2];
+            }
         }
-    }
-
-    if (postLimbDraw != NULL) {
-        postLimbDraw(play, limbIndex, &dList, &rot, actor);
-    }
 
-    if (limb->child != LIMB_DONE) {
-        SkelAnime_DrawLimbLod(play, limb->child, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor, lod);
-    }
+        if (postLimbDraw != NULL) {
+            postLimbDraw(play, limbIndex, &dList, &rot, actor);
+        }
 
-    Matrix_Pop();
-
-    if (limb->sibling != LIMB_DONE) {
-        SkelAnime_DrawLimbLod(play, limb->sibling, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor, lod);
-    }
+        limbIndex = SkelAnime_GetNextLimb(skeleton, limbIndex - 1, (StandardLimb*)limb, parents, &depth);
+    } while (limbIndex != LIMB_DONE);
 
     CLOSE_DISPS(play->state.gfxCtx);
 }
@@ -145,50 +166,44 @@ void SkelAnime_DrawFlexLimbLod(PlayState* play, s32 limbIndex, void** skeleton,
     Gfx* limbDList;
     Vec3f pos;
     Vec3s rot;
+    u8 parents[LIMB_DONE];
+    s32 depth = 0;
 
     OPEN_DISPS(play->state.gfxCtx);
 
-    Matrix_Push();
+    do {
+        Matrix_Push();
 
-    limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
-    limbIndex++;
+        limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
+        limbIndex++;
 
-    rot = jointTable[limbIndex];
+        rot = jointTable[limbIndex];
 
-    pos.x = limb->jointPos.x;
-    pos.y = limb->jointPos.y;
-    pos.z = limb->jointPos.z;
+        pos.x = limb->jointPos.x;
+        pos.y = limb->jointPos.y;
+        pos.z = limb->jointPos.z;
 
-    newDList = limbDList = limb->dLists[lod];
+        newDList = limbDList = limb->dLists[lod];
 
-    if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &newDList, &pos, &rot, actor)) {
-        Matrix_TranslateRotateZYX(&pos, &rot);
-        if (newDList != NULL) {
-            Matrix_ToMtx(*mtx);
-            gSPMatrix(POLY_OPA_DISP++, *mtx, G_MTX_LOAD);
-            gSPDisplayList(POLY_OPA_DISP++, newDList);
-            (*mtx)++;
-        } else if (limbDList != NULL) {
-            Matrix_ToMtx(*mtx);
-            (*mtx)++;
+        if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &newDList, &pos, &rot, actor)) {
+            Matrix_TranslateRotateZYX(&pos, &rot);
+            if (newDList != NULL) {
+                Matrix_ToMtx(*mtx);
+                gSPMatrix(POLY_OPA_DISP++, *mtx, G_MTX_LOAD);
+                gSPDisplayList(POLY_OPA_DISP++, newDList);
+                (*mtx)++;
+            } else if (limbDList != NULL) {
+                Matrix_ToMtx(*mtx);
+                (*mtx)++;
+            }
         }
-    }
-
-    if (postLimbDraw != NULL) {
-        postLimbDraw(play, limbIndex, &newDList, &limbDList, &rot, actor);
-    }
 
-    if (limb->child != LIMB_DONE) {
-        SkelAnime_DrawFlexLimbLod(play, limb->child, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor, lod,
-                                  mtx);
-    }
-
-    Matrix_Pop();
+        if (postLimbDraw != NULL) {
+            postLimbDraw(play, limbIndex, &newDList, &limbDList, &rot, actor);
+        }
 
-    if (limb->sibling != LIMB_DONE) {
-        SkelAnime_DrawFlexLimbLod(play, limb->sibling, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor, lod,
-                                  mtx);
-    }
+        limbIndex = SkelAnime_GetNextLimb(skeleton, limbIndex - 1, (StandardLimb*)limb, parents, &depth);
+    } while (limbIndex != LIMB_DONE);
 
     CLOSE_DISPS(play->state.gfxCtx);
 }
@@ -265,43 +280,39 @@ void SkelAnime_DrawLimbOpa(PlayState* play, s32 limbIndex, void** skeleton, Vec3
     Gfx* dList;
     Vec3f pos;
     Vec3s rot;
+    u8 parents[LIMB_DONE];
+    s32 depth = 0;
 
     OPEN_DISPS(play->state.gfxCtx);
 
-    Matrix_Push();
-
-    limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
-    limbIndex++;
-    rot = jointTable[limbIndex];
-    pos.x = limb->jointPos.x;
-    pos.y = limb->jointPos.y;
-    pos.z = limb->jointPos.z;
-    dList = limb->dList;
-
-    if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &dList, &pos, &rot, actor)) {
-        Matrix_TranslateRotateZYX(&pos, &rot);
-        if (dList != NULL) {
-            Gfx* polyTemp = POLY_OPA_DISP;
+    do {
+        Matrix_Push();
 
-            gSPMatrix(&polyTemp[0], Matrix_NewMtx(play->state.gfxCtx), G_MTX_LOAD);
-            gSPDisplayList(&polyTemp[1], dList);
-            POLY_OPA_DISP = &polyTemp[2];
+        limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
+        limbIndex++;
+        rot = jointTable[limbIndex];
+        pos.x = limb->jointPos.x;
+        pos.y = limb->jointPos.y;
+        pos.z = limb->jointPos.z;
+        dList = limb->dList;
+
+        if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &dList, &pos, &rot, actor)) {
+            Matrix_TranslateRotateZYX(&pos, &rot);
+            if (dList != NULL) {
+                Gfx* polyTemp = POLY_OPA_DISP;
+
+                gSPMatrix(&polyTemp[0], Matrix_NewMtx(play->state.gfxCtx), G_MTX_LOAD);
+                gSPDisplayList(&polyTemp[1], dList);
+                POLY_OPA_DISP = &polyTemp[2];
+            }
         }
-    }
 
-    if (postLimbDraw != NULL) {
-        postLimbDraw(play, limbIndex, &dList, &rot, actor);
-    }
-
-    if (limb->child != LIMB_DONE) {
-        SkelAnime_DrawLimbOpa(play, limb->child, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor);
-    }
+        if (postLimbDraw != NULL) {
+            postLimbDraw(play, limbIndex, &dList, &rot, actor);
+        }
 
-    Matrix_Pop();
-
-    if (limb->sibling != LIMB_DONE) {
-        SkelAnime_DrawLimbOpa(play, limb->sibling, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor);
-    }
+        limbIndex = SkelAnime_GetNextLimb(skeleton, limbIndex - 1, limb, parents, &depth);
+    } while (limbIndex != LIMB_DONE);
 
     CLOSE_DISPS(play->state.gfxCtx);
 }
@@ -365,49 +376,43 @@ void SkelAnime_DrawFlexLimbOpa(PlayState* play, s32 limbIndex, void** skeleton,
     Gfx* limbDList;
     Vec3f pos;
     Vec3s rot;
+    u8 parents[LIMB_DONE];
+    s32 depth = 0;
 
     OPEN_DISPS(play->state.gfxCtx);
 
-    Matrix_Push();
-
-    limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
-    limbIndex++;
-    rot = jointTable[limbIndex];
-
-    pos.x = limb->jointPos.x;
-    pos.y = limb->jointPos.y;
-    pos.z = limb->jointPos.z;
-
-    newDList = limbDList = limb->dList;
+    do {
+        Matrix_Push();
 
-    if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &newDList, &pos, &rot, actor)) {
-        Matrix_TranslateRotateZYX(&pos, &rot);
-        if (newDList != NULL) {
-            Matrix_ToMtx(*limbMatricies);
-            gSPMatrix(POLY_OPA_DISP++, *limbMatricies, G_MTX_LOAD);
-            gSPDisplayList(POLY_OPA_DISP++, newDList);
-            (*limbMatricies)++;
-        } else if (limbDList != NULL) {
-            Matrix_ToMtx(*limbMatricies);
-            (*limbMatricies)++;
+        limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
+        limbIndex++;
+        rot = jointTable[limbIndex];
+
+        pos.x = limb->jointPos.x;
+        pos.y = limb->jointPos.y;
+        pos.z = limb->jointPos.z;
+
+        newDList = limbDList = limb->dList;
+
+        if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &newDList, &pos, &rot, actor)) {
+            Matrix_TranslateRotateZYX(&pos, &rot);
+            if (newDList != NULL) {
+                Matrix_ToMtx(*limbMatricies);
+                gSPMatrix(POLY_OPA_DISP++, *limbMatricies, G_MTX_LOAD);
+                gSPDisplayList(POLY_OPA_DISP++, newDList);
+                (*limbMatricies)++;
+            } else if (limbDList != NULL) {
+                Matrix_ToMtx(*limbMatricies);
+                (*limbMatricies)++;
+            }
         }
-    }
 
-    if (postLimbDraw != NULL) {
-        postLimbDraw(play, limbIndex, &limbDList, &rot, actor);
-    }
-
-    if (limb->child != LIMB_DONE) {
-        SkelAnime_DrawFlexLimbOpa(play, limb->child, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor,
-                                  limbMatricies);
-    }
+        if (postLimbDraw != NULL) {
+            postLimbDraw(play, limbIndex, &limbDList, &rot, actor);
+        }
 
-    Matrix_Pop();
-
-    if (limb->sibling != LIMB_DONE) {
-        SkelAnime_DrawFlexLimbOpa(play, limb->sibling, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor,
-                                  limbMatricies);
-    }
+        limbIndex = SkelAnime_GetNextLimb(skeleton, limbIndex - 1, limb, parents, &depth);
+    } while (limbIndex != LIMB_DONE);
 
     CLOSE_DISPS(play->state.gfxCtx);
 }
@@ -485,58 +490,52 @@ void SkelAnime_DrawTransformFlexLimbOpa(PlayState* play, s32 limbIndex, void** s
     Gfx* limbDList;
     Vec3f pos;
     Vec3s rot;
+    u8 parents[LIMB_DONE];
+    s32 depth = 0;
 
     OPEN_DISPS(play->state.gfxCtx);
 
-    Matrix_Push();
+    do {
+        Matrix_Push();
 
-    limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
-    limbIndex++;
+        limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
+        limbIndex++;
 
-    rot = jointTable[limbIndex];
-    pos.x = limb->jointPos.x;
-    pos.y = limb->jointPos.y;
-    pos.z = limb->jointPos.z;
+        rot = jointTable[limbIndex];
+        pos.x = limb->jointPos.x;
+        pos.y = limb->jointPos.y;
+        pos.z = limb->jointPos.z;
 
-    newDList = limbDList = limb->dList;
+        newDList = limbDList = limb->dList;
 
-    if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &newDList, &pos, &rot, actor)) {
-        Matrix_TranslateRotateZYX(&pos, &rot);
-        Matrix_Push();
+        if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &newDList, &pos, &rot, actor)) {
+            Matrix_TranslateRotateZYX(&pos, &rot);
+            Matrix_Push();
 
-        transformLimbDraw(play, limbIndex, actor);
+            transformLimbDraw(play, limbIndex, actor);
 
-        if (newDList != NULL) {
-            Gfx* polyTemp = POLY_OPA_DISP;
+            if (newDList != NULL) {
+                Gfx* polyTemp = POLY_OPA_DISP;
 
-            gSPMatrix(&polyTemp[0], Matrix_ToMtx(*mtx), G_MTX_LOAD);
-            gSPDisplayList(&polyTemp[1], newDList);
-            POLY_OPA_DISP = &polyTemp[2];
-            (*mtx)++;
-        } else {
-            if (limbDList != NULL) {
-                Matrix_ToMtx(*mtx);
+                gSPMatrix(&polyTemp[0], Matrix_ToMtx(*mtx), G_MTX_LOAD);
+                gSPDisplayList(&polyTemp[1], newDList);
+                POLY_OPA_DISP = &polyTemp[2];
                 (*mtx)++;
+            } else {
+                if (limbDList != NULL) {
+                    Matrix_ToMtx(*mtx);
+                    (*mtx)++;
+                }
             }
+            Matrix_Pop();
         }
-        Matrix_Pop();
-    }
 
-    if (postLimbDraw != NULL) {
-        postLimbDraw(play, limbIndex, &limbDList, &rot, actor);
-    }
-
-    if (limb->child != LIMB_DONE) {
-        SkelAnime_DrawTransformFlexLimbOpa(play, limb->child, skeleton, jointTable, overrideLimbDraw, postLimbDraw,
-                                           transformLimbDraw, actor, mtx);
-    }
-
-    Matrix_Pop();
+        if (postLimbDraw != NULL) {
+            postLimbDraw(play, limbIndex, &limbDList, &rot, actor);
+        }
 
-    if (limb->sibling != LIMB_DONE) {
-        SkelAnime_DrawTransformFlexLimbOpa(play, limb->sibling, skeleton, jointTable, overrideLimbDraw, postLimbDraw,
-                                           transformLimbDraw, actor, mtx);
-    }
+        limbIndex = SkelAnime_GetNextLimb(skeleton, limbIndex - 1, limb, parents, &depth);
+    } while (limbIndex != LIMB_DONE);
 
     CLOSE_DISPS(play->state.gfxCtx);
 }
@@ -663,41 +662,37 @@ Gfx* SkelAnime_DrawLimb(PlayState* play, s32 limbIndex, void** skeleton, Vec3s*
     Gfx* dList;
     Vec3f pos;
     Vec3s rot;
+    u8 parents[LIMB_DONE];
+    s32 depth = 0;
 
-    Matrix_Push();
+    do {
+        Matrix_Push();
 
-    limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
-    limbIndex++;
+        limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
+        limbIndex++;
 
-    rot = jointTable[limbIndex];
-    pos.x = limb->jointPos.x;
-    pos.y = limb->jointPos.y;
-    pos.z = limb->jointPos.z;
+        rot = jointTable[limbIndex];
+        pos.x = limb->jointPos.x;
+        pos.y = limb->jointPos.y;
+        pos.z = limb->jointPos.z;
 
-    dList = limb->dList;
+        dList = limb->dList;
 
-    if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &dList, &pos, &rot, actor, &gfx)) {
-        Matrix_TranslateRotateZYX(&pos, &rot);
-        if (dList != NULL) {
-            gSPMatrix(&gfx[0], Matrix_NewMtx(play->state.gfxCtx), G_MTX_LOAD);
-            gSPDisplayList(&gfx[1], dList);
-            gfx = &gfx[2];
+        if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &dList, &pos, &rot, actor, &gfx)) {
+            Matrix_TranslateRotateZYX(&pos, &rot);
+            if (dList != NULL) {
+                gSPMatrix(&gfx[0], Matrix_NewMtx(play->state.gfxCtx), G_MTX_LOAD);
+                gSPDisplayList(&gfx[1], dList);
+                gfx = &gfx[2];
+            }
         }
-    }
 
-    if (postLimbDraw != NULL) {
-        postLimbDraw(play, limbIndex, &dList, &rot, actor, &gfx);
-    }
-
-    if (limb->child != LIMB_DONE) {
-        gfx = SkelAnime_DrawLimb(play, limb->child, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor, gfx);
-    }
-
-    Matrix_Pop();
+        if (postLimbDraw != NULL) {
+            postLimbDraw(play, limbIndex, &dList, &rot, actor, &gfx);
+        }
 
-    if (limb->sibling != LIMB_DONE) {
-        gfx = SkelAnime_DrawLimb(play, limb->sibling, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor, gfx);
-    }
+        limbIndex = SkelAnime_GetNextLimb(skeleton, limbIndex - 1, limb, parents, &depth);
+    } while (limbIndex != LIMB_DONE);
 
     return gfx;
 }
@@ -764,49 +759,43 @@ Gfx* SkelAnime_DrawFlexLimb(PlayState* play, s32 limbIndex, void** skeleton, Vec
     Gfx* limbDList;
     Vec3f pos;
     Vec3s rot;
+    u8 parents[LIMB_DONE];
+    s32 depth = 0;
 
-    Matrix_Push();
+    do {
+        Matrix_Push();
 
-    limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
-    limbIndex++;
-    rot = jointTable[limbIndex];
+        limb = Lib_SegmentedToVirtual(skeleton[limbIndex]);
+        limbIndex++;
+        rot = jointTable[limbIndex];
 
-    pos.x = limb->jointPos.x;
-    pos.y = limb->jointPos.y;
-    pos.z = limb->jointPos.z;
+        pos.x = limb->jointPos.x;
+        pos.y = limb->jointPos.y;
+        pos.z = limb->jointPos.z;
 
-    newDList = limbDList = limb->dList;
+        newDList = limbDList = limb->dList;
 
-    if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &newDList, &pos, &rot, actor, &gfx)) {
-        Matrix_TranslateRotateZYX(&pos, &rot);
-        if (newDList != NULL) {
-            gSPMatrix(&gfx[0], Matrix_ToMtx(*mtx), G_MTX_LOAD);
-            gSPDisplayList(&gfx[1], newDList);
-            gfx = &gfx[2];
-            (*mtx)++;
-        } else {
-            if (limbDList != NULL) {
-                Matrix_ToMtx(*mtx);
+        if ((overrideLimbDraw == NULL) || !overrideLimbDraw(play, limbIndex, &newDList, &pos, &rot, actor, &gfx)) {
+            Matrix_TranslateRotateZYX(&pos, &rot);
+            if (newDList != NULL) {
+                gSPMatrix(&gfx[0], Matrix_ToMtx(*mtx), G_MTX_LOAD);
+                gSPDisplayList(&gfx[1], newDList);
+                gfx = &gfx[2];
                 (*mtx)++;
+            } else {
+                if (limbDList != NULL) {
+                    Matrix_ToMtx(*mtx);
+                    (*mtx)++;
+                }
             }
         }
-    }
 
-    if (postLimbDraw != NULL) {
-        postLimbDraw(play, limbIndex, &limbDList, &rot, actor, &gfx);
-    }
-
-    if (limb->child != LIMB_DONE) {
-        gfx = SkelAnime_DrawFlexLimb(play, limb->child, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor,
-                                     mtx, gfx);
-    }
-
-    Matrix_Pop();
+        if (postLimbDraw != NULL) {
+            postLimbDraw(play, limbIndex, &limbDList, &rot, actor, &gfx);
+        }
 
-    if (limb->sibling != LIMB_DONE) {
-        gfx = SkelAnime_DrawFlexLimb(play, limb->sibling, skeleton, jointTable, overrideLimbDraw, postLimbDraw, actor,
-                                     mtx, gfx);
-    }
+        limbIndex = SkelAnime_GetNextLimb(skeleton, limbIndex - 1, limb, parents, &depth);
+    } while (limbIndex != LIMB_DONE);
 
     return gfx;
 }
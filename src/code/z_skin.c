@@ -7,42 +7,46 @@ MtxF gSkinLimbMatrices[60];
 
 static s32 sBssPad;
 
+/**
+ * Sets the vertices of a limb modification to `pos`, and their normals to the skin normals rotated by `mtx`.
+ * The rotation is read into locals once for the whole modification rather than per vertex, and the translation of
+ * `mtx` is ignored without writing to it. Gives the same vertices as transforming each normal with
+ * `SkinMatrix_Vec3fMtxFMultXYZ` after clearing the translation
+ */
 void Skin_UpdateVertices(MtxF* mtx, SkinVertex* skinVertices, SkinLimbModif* modifEntry, Vtx* vtxBuf, Vec3f* pos) {
     SkinVertex* vertexEntry;
     Vtx* vtx;
-    Vec3f wTemp;
-    Vec3f normal;
-    Vec3f sp44;
-
-    wTemp.x = mtx->xw;
-    wTemp.y = mtx->yw;
-    wTemp.z = mtx->zw;
-
-    mtx->xw = 0.0f;
-    mtx->yw = 0.0f;
-    mtx->zw = 0.0f;
+    f32 xx = mtx->xx;
+    f32 xy = mtx->xy;
+    f32 xz = mtx->xz;
+    f32 yx = mtx->yx;
+    f32 yy = mtx->yy;
+    f32 yz = mtx->yz;
+    f32 zx = mtx->zx;
+    f32 zy = mtx->zy;
+    f32 zz = mtx->zz;
+    f32 normX;
+    f32 normY;
+    f32 normZ;
+    s16 posX = pos->x;
+    s16 posY = pos->y;
+    s16 posZ = pos->z;
 
     for (vertexEntry = skinVertices; vertexEntry < &skinVertices[modifEntry->vtxCount]; vertexEntry++) {
         vtx = &vtxBuf[vertexEntry->index];
 
-        vtx->n.ob[0] = pos->x;
-        vtx->n.ob[1] = pos->y;
-        vtx->n.ob[2] = pos->z;
-
-        sp44.x = vertexEntry->normX;
-        sp44.y = vertexEntry->normY;
-        sp44.z = vertexEntry->normZ;
+        vtx->n.ob[0] = posX;
+        vtx->n.ob[1] = posY;
+        vtx->n.ob[2] = posZ;
 
-        SkinMatrix_Vec3fMtxFMultXYZ(mtx, &sp44, &normal);
+        normX = vertexEntry->normX;
+        normY = vertexEntry->normY;
+        normZ = vertexEntry->normZ;
 
-        vtx->n.n[0] = normal.x;
-        vtx->n.n[1] = normal.y;
-        vtx->n.n[2] = normal.z;
+        vtx->n.n[0] = (normX * xx) + (normY * xy) + (normZ * xz);
+        vtx->n.n[1] = (normX * yx) + (normY * yy) + (normZ * yz);
+        vtx->n.n[2] = (normX * zx) + (normY * zy) + (normZ * zz);
     }
-
-    mtx->xw = wTemp.x;
-    mtx->yw = wTemp.y;
-    mtx->zw = wTemp.z;
 }
 
 void Skin_ApplyLimbModifications(GraphicsContext* gfxCtx, Skin* skin, s32 limbIndex, s32 arg3) {
@@ -390,7 +390,7 @@ s32 func_80B85A00(EnKaizoku* this, PlayState* play, s16 arg2) {
         return true;
     }
 
-    explosiveActor = Actor_FindNearby(play, &this->picto.actor, -1, ACTORCAT_EXPLOSIVES, 80.0f);
+    explosiveActor = ActorGrid_FindFirst(play, &this->picto.actor, -1, ACTORCAT_EXPLOSIVES, 80.0f);
     if (explosiveActor != NULL) {
         this->picto.actor.shape.rot.y = this->picto.actor.world.rot.y = this->picto.actor.yawTowardsPlayer;
 
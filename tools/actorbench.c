@@ -0,0 +1,575 @@
+/*
+ * actorbench: times the per-actor projection and cull pass of Actor_DrawAll against the ActorHotTable version on a
+ * synthetic scene, and checks that both produce the same projected positions and in-view results.
+ *
+ * Actors are laid out the way ZeldaArena leaves them: one instance per overlay-sized block, allocated in a shuffled
+ * order so that walking a category list jumps around the heap. Only the Actor fields read by the pass are modelled,
+ * at their offsets from include/z64actor.h. The math is copied from SkinMatrix_Vec3fMtxFMultXYZW, func_800BA2FC,
+ * CullBatch_Project and ActorHotTable_ProjectAndCull.
+ *
+ * The host caches are much larger than the N64's 8 KiB data cache, so by default every pass starts by evicting the
+ * scene with a sweep over a large buffer, and the number of distinct 16-byte N64 data cache lines each pass reads is
+ * reported next to the time.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define ACTORBENCH_VER "0.1"
+
+#define ACTORCAT_MAX 12
+#define ACTOR_SIZE 0x144
+#define ACTOR_HOT_TABLE_MAX 256
+#define N64_DCACHE_LINE 16
+#define EVICT_SIZE (32 * 1024 * 1024)
+
+#define ACTOR_WORLD_POS 0x24
+#define ACTOR_PROJECTED_POS 0xEC
+#define ACTOR_PROJECTED_W 0xF8
+#define ACTOR_UNCULL_ZONE_FORWARD 0xFC
+#define ACTOR_UNCULL_ZONE_SCALE 0x100
+#define ACTOR_UNCULL_ZONE_DOWNWARD 0x104
+#define ACTOR_FLAGS 0x4
+#define ACTOR_NEXT 0x12C
+
+#define ACTOR_FLAG_40 (1 << 6)
+
+#define CLAMP_MIN(x, min) ((x) < (min) ? (min) : (x))
+
+typedef struct {
+    float x, y, z;
+} Vec3f;
+
+typedef struct {
+    float xx, yx, zx, wx;
+    float xy, yy, zy, wy;
+    float xz, yz, zz, wz;
+    float xw, yw, zw, ww;
+} MtxF;
+
+typedef struct {
+    MtxF viewProjectionMtxF;
+    Vec3f projectionMtxFDiagonal;
+    float fovy;
+} Scene;
+
+typedef struct {
+    uint8_t* actors[ACTOR_HOT_TABLE_MAX];
+    float posX[ACTOR_HOT_TABLE_MAX];
+    float posY[ACTOR_HOT_TABLE_MAX];
+    float posZ[ACTOR_HOT_TABLE_MAX];
+    float uncullZoneForward[ACTOR_HOT_TABLE_MAX];
+    float uncullZoneScale[ACTOR_HOT_TABLE_MAX];
+    float uncullZoneDownward[ACTOR_HOT_TABLE_MAX];
+    float projectedX[ACTOR_HOT_TABLE_MAX];
+    float projectedY[ACTOR_HOT_TABLE_MAX];
+    float projectedZ[ACTOR_HOT_TABLE_MAX];
+    float projectedW[ACTOR_HOT_TABLE_MAX];
+    uint8_t isInView[ACTOR_HOT_TABLE_MAX];
+    int count;
+} ActorHotTable;
+
+typedef struct {
+    uint8_t* first[ACTORCAT_MAX];
+    uint8_t* heap;
+    size_t heapSize;
+} ActorLists;
+
+// Records every N64 data cache line read by a pass, to count the distinct ones
+typedef struct {
+    uintptr_t* lines;
+    size_t count;
+    size_t capacity;
+    bool enabled;
+} LineLog;
+
+static LineLog sLineLog;
+
+static void line_log_touch(const void* p, size_t size) {
+    uintptr_t line;
+    uintptr_t end;
+
+    if (!sLineLog.enabled) {
+        return;
+    }
+    end = ((uintptr_t)p + size - 1) / N64_DCACHE_LINE;
+    for (line = (uintptr_t)p / N64_DCACHE_LINE; line <= end; line++) {
+        if (sLineLog.count == sLineLog.capacity) {
+            sLineLog.capacity = (sLineLog.capacity == 0) ? 4096 : sLineLog.capacity * 2;
+            sLineLog.lines = realloc(sLineLog.lines, sLineLog.capacity * sizeof(uintptr_t));
+        }
+        sLineLog.lines[sLineLog.count++] = line;
+    }
+}
+
+static int compare_lines(const void* a, const void* b) {
+    uintptr_t la = *(const uintptr_t*)a;
+    uintptr_t lb = *(const uintptr_t*)b;
+
+    return (la > lb) - (la < lb);
+}
+
+static size_t line_log_count_distinct(void) {
+    size_t i;
+    size_t n = 0;
+
+    qsort(sLineLog.lines, sLineLog.count, sizeof(uintptr_t), compare_lines);
+    for (i = 0; i < sLineLog.count; i++) {
+        if ((i == 0) || (sLineLog.lines[i] != sLineLog.lines[i - 1])) {
+            n++;
+        }
+    }
+    return n;
+}
+
+#define FIELD(actor, offset, type) (*(type*)((actor) + (offset)))
+
+static float read_f32(uint8_t* actor, size_t offset) {
+    line_log_touch(actor + offset, sizeof(float));
+    return FIELD(actor, offset, float);
+}
+
+static uint8_t* read_next(uint8_t* actor) {
+    line_log_touch(actor + ACTOR_NEXT, sizeof(uint8_t*));
+    return FIELD(actor, ACTOR_NEXT, uint8_t*);
+}
+
+static uint32_t next_rand(uint32_t* seed) {
+    *seed = *seed * 1664525 + 1013904223;
+    return *seed;
+}
+
+static float rand_float(uint32_t* seed, float min, float max) {
+    return min + (max - min) * ((next_rand(seed) >> 8) / (float)(1 << 24));
+}
+
+/**
+ * Builds `numActors` actors spread over the categories, with overlay-sized instances placed in shuffled heap order
+ */
+static void init_actors(ActorLists* lists, int numActors, uint32_t seed) {
+    uint8_t** blocks = malloc(numActors * sizeof(uint8_t*));
+    uint8_t* last[ACTORCAT_MAX] = { 0 };
+    size_t offset = 0;
+    int i;
+
+    // Instance sizes of actor overlays are mostly between the bare Actor and 0x800 bytes
+    lists->heapSize = (size_t)numActors * 0x900;
+    lists->heap = calloc(1, lists->heapSize);
+    for (i = 0; i < numActors; i++) {
+        blocks[i] = lists->heap + offset;
+        offset += (ACTOR_SIZE + (next_rand(&seed) % 0x6C0) + 0x10 + 15) & ~(size_t)15;
+    }
+    for (i = numActors - 1; i > 0; i--) {
+        int j = next_rand(&seed) % (i + 1);
+        uint8_t* tmp = blocks[i];
+
+        blocks[i] = blocks[j];
+        blocks[j] = tmp;
+    }
+
+    memset(lists->first, 0, sizeof(lists->first));
+    for (i = 0; i < numActors; i++) {
+        uint8_t* actor = blocks[i];
+        int category = next_rand(&seed) % ACTORCAT_MAX;
+
+        FIELD(actor, ACTOR_WORLD_POS + 0, float) = rand_float(&seed, -3000.0f, 3000.0f);
+        FIELD(actor, ACTOR_WORLD_POS + 4, float) = rand_float(&seed, -200.0f, 800.0f);
+        FIELD(actor, ACTOR_WORLD_POS + 8, float) = rand_float(&seed, -3000.0f, 3000.0f);
+        FIELD(actor, ACTOR_UNCULL_ZONE_FORWARD, float) = rand_float(&seed, 400.0f, 4000.0f);
+        FIELD(actor, ACTOR_UNCULL_ZONE_SCALE, float) = rand_float(&seed, 50.0f, 600.0f);
+        FIELD(actor, ACTOR_UNCULL_ZONE_DOWNWARD, float) = rand_float(&seed, 50.0f, 600.0f);
+        FIELD(actor, ACTOR_NEXT, uint8_t*) = NULL;
+        if (last[category] == NULL) {
+            lists->first[category] = actor;
+        } else {
+            FIELD(last[category], ACTOR_NEXT, uint8_t*) = actor;
+        }
+        last[category] = actor;
+    }
+    free(blocks);
+}
+
+/**
+ * Perspective projection from the origin looking down +z, so that actors in front of the camera have positive
+ * projected z and w like they do with the game's view matrix
+ */
+static void init_view(Scene* scene, float fovy) {
+    float cot = 1.0f / tanf(fovy * 0.5f * 3.14159265f / 180.0f);
+    float aspect = 4.0f / 3.0f;
+    float near = 10.0f;
+    float far = 12800.0f;
+
+    memset(scene, 0, sizeof(*scene));
+    scene->viewProjectionMtxF.xx = cot / aspect;
+    scene->viewProjectionMtxF.yy = cot;
+    scene->viewProjectionMtxF.zz = (far + near) / (far - near);
+    scene->viewProjectionMtxF.zw = -2.0f * far * near / (far - near);
+    scene->viewProjectionMtxF.wz = 1.0f;
+    scene->projectionMtxFDiagonal.x = scene->viewProjectionMtxF.xx;
+    scene->projectionMtxFDiagonal.y = scene->viewProjectionMtxF.yy;
+    scene->projectionMtxFDiagonal.z = scene->viewProjectionMtxF.zz;
+    scene->fovy = fovy;
+}
+
+/**
+ * The pass as Actor_DrawAll did it before the hot table: project and cull each actor while walking the lists
+ */
+static int per_actor_project_and_cull(Scene* scene, ActorLists* lists) {
+    MtxF* mf = &scene->viewProjectionMtxF;
+    int numInView = 0;
+    int i;
+
+    for (i = 0; i < ACTORCAT_MAX; i++) {
+        uint8_t* actor;
+
+        for (actor = lists->first[i]; actor != NULL; actor = read_next(actor)) {
+            Vec3f src;
+            Vec3f* projectedPos = &FIELD(actor, ACTOR_PROJECTED_POS, Vec3f);
+            float projectedW;
+            float uncullScale;
+            bool isInView = false;
+
+            src.x = read_f32(actor, ACTOR_WORLD_POS + 0);
+            src.y = read_f32(actor, ACTOR_WORLD_POS + 4);
+            src.z = read_f32(actor, ACTOR_WORLD_POS + 8);
+
+            // SkinMatrix_Vec3fMtxFMultXYZW
+            projectedPos->x = mf->xw + ((src.x * mf->xx) + (src.y * mf->xy) + (src.z * mf->xz));
+            projectedPos->y = mf->yw + ((src.x * mf->yx) + (src.y * mf->yy) + (src.z * mf->yz));
+            projectedPos->z = mf->zw + ((src.x * mf->zx) + (src.y * mf->zy) + (src.z * mf->zz));
+            projectedW = mf->ww + ((src.x * mf->wx) + (src.y * mf->wy) + (src.z * mf->wz));
+            FIELD(actor, ACTOR_PROJECTED_W, float) = projectedW;
+            line_log_touch(projectedPos, sizeof(Vec3f) + sizeof(float));
+
+            // func_800BA2FC
+            uncullScale = read_f32(actor, ACTOR_UNCULL_ZONE_SCALE);
+            if ((-uncullScale < projectedPos->z) &&
+                (projectedPos->z < (read_f32(actor, ACTOR_UNCULL_ZONE_FORWARD) + uncullScale))) {
+                float phi_f12;
+                float phi_f2 = CLAMP_MIN(projectedW, 1.0f);
+                float phi_f14;
+                float phi_f16;
+
+                if (scene->fovy != 60.0f) {
+                    phi_f12 = uncullScale * scene->projectionMtxFDiagonal.x * 0.76980036f;
+
+                    phi_f14 = scene->projectionMtxFDiagonal.y * 0.57735026f;
+                    phi_f16 = uncullScale * phi_f14;
+                    phi_f14 *= read_f32(actor, ACTOR_UNCULL_ZONE_DOWNWARD);
+                } else {
+                    phi_f16 = phi_f12 = uncullScale;
+                    phi_f14 = read_f32(actor, ACTOR_UNCULL_ZONE_DOWNWARD);
+                }
+
+                if (((fabsf(projectedPos->x) - phi_f12) < phi_f2) && ((-phi_f2 < (projectedPos->y + phi_f14))) &&
+                    ((projectedPos->y - phi_f16) < phi_f2)) {
+                    isInView = true;
+                }
+            }
+
+            line_log_touch(actor + ACTOR_FLAGS, sizeof(uint32_t));
+            if (isInView) {
+                FIELD(actor, ACTOR_FLAGS, uint32_t) |= ACTOR_FLAG_40;
+                numInView++;
+            } else {
+                FIELD(actor, ACTOR_FLAGS, uint32_t) &= ~ACTOR_FLAG_40;
+            }
+        }
+    }
+    return numInView;
+}
+
+static void hot_table_sync(ActorHotTable* table, ActorLists* lists) {
+    int n = 0;
+    int i;
+
+    for (i = 0; i < ACTORCAT_MAX; i++) {
+        uint8_t* actor;
+
+        for (actor = lists->first[i]; (actor != NULL) && (n < ACTOR_HOT_TABLE_MAX); actor = read_next(actor)) {
+            table->actors[n] = actor;
+            table->posX[n] = read_f32(actor, ACTOR_WORLD_POS + 0);
+            table->posY[n] = read_f32(actor, ACTOR_WORLD_POS + 4);
+            table->posZ[n] = read_f32(actor, ACTOR_WORLD_POS + 8);
+            table->uncullZoneForward[n] = read_f32(actor, ACTOR_UNCULL_ZONE_FORWARD);
+            table->uncullZoneScale[n] = read_f32(actor, ACTOR_UNCULL_ZONE_SCALE);
+            table->uncullZoneDownward[n] = read_f32(actor, ACTOR_UNCULL_ZONE_DOWNWARD);
+            n++;
+        }
+    }
+    table->count = n;
+}
+
+static void hot_table_project_and_cull(ActorHotTable* table, Scene* scene) {
+    MtxF* mf = &scene->viewProjectionMtxF;
+    float fovScaleY = scene->projectionMtxFDiagonal.y * 0.57735026f;
+    bool useFovScale = (scene->fovy != 60.0f);
+    int n = table->count;
+    int i;
+
+    line_log_touch(table->posX, n * sizeof(float));
+    line_log_touch(table->posY, n * sizeof(float));
+    line_log_touch(table->posZ, n * sizeof(float));
+
+    // CullBatch_Project
+    for (i = 0; i < n; i++) {
+        table->projectedX[i] = mf->xw + ((table->posX[i] * mf->xx) + (table->posY[i] * mf->xy) +
+                                         (table->posZ[i] * mf->xz));
+    }
+    for (i = 0; i < n; i++) {
+        table->projectedY[i] = mf->yw + ((table->posX[i] * mf->yx) + (table->posY[i] * mf->yy) +
+                                         (table->posZ[i] * mf->yz));
+    }
+    for (i = 0; i < n; i++) {
+        table->projectedZ[i] = mf->zw + ((table->posX[i] * mf->zx) + (table->posY[i] * mf->zy) +
+                                         (table->posZ[i] * mf->zz));
+    }
+    for (i = 0; i < n; i++) {
+        table->projectedW[i] = mf->ww + ((table->posX[i] * mf->wx) + (table->posY[i] * mf->wy) +
+                                         (table->posZ[i] * mf->wz));
+    }
+
+    line_log_touch(table->projectedX, n * sizeof(float));
+    line_log_touch(table->projectedY, n * sizeof(float));
+    line_log_touch(table->projectedZ, n * sizeof(float));
+    line_log_touch(table->projectedW, n * sizeof(float));
+    line_log_touch(table->uncullZoneForward, n * sizeof(float));
+    line_log_touch(table->uncullZoneScale, n * sizeof(float));
+    line_log_touch(table->uncullZoneDownward, n * sizeof(float));
+    line_log_touch(table->isInView, n);
+
+    for (i = 0; i < n; i++) {
+        float uncullScale = table->uncullZoneScale[i];
+        float z = table->projectedZ[i];
+
+        table->isInView[i] = false;
+        if ((-uncullScale < z) && (z < (table->uncullZoneForward[i] + uncullScale))) {
+            float w = CLAMP_MIN(table->projectedW[i], 1.0f);
+            float uncullScaleX;
+            float uncullScaleY;
+            float uncullDownward;
+            float y;
+
+            if (useFovScale) {
+                uncullScaleX = uncullScale * scene->projectionMtxFDiagonal.x * 0.76980036f;
+                uncullScaleY = uncullScale * fovScaleY;
+                uncullDownward = fovScaleY * table->uncullZoneDownward[i];
+            } else {
+                uncullScaleY = uncullScaleX = uncullScale;
+                uncullDownward = table->uncullZoneDownward[i];
+            }
+
+            y = table->projectedY[i];
+            if (((fabsf(table->projectedX[i]) - uncullScaleX) < w) && (-w < (y + uncullDownward)) &&
+                ((y - uncullScaleY) < w)) {
+                table->isInView[i] = true;
+            }
+        }
+    }
+}
+
+/**
+ * The read back done while Actor_DrawAll walks the lists, when every entry still matches its actor
+ */
+static int hot_table_apply(ActorHotTable* table) {
+    int numInView = 0;
+    int i;
+
+    for (i = 0; i < table->count; i++) {
+        uint8_t* actor = table->actors[i];
+        Vec3f* projectedPos = &FIELD(actor, ACTOR_PROJECTED_POS, Vec3f);
+
+        projectedPos->x = table->projectedX[i];
+        projectedPos->y = table->projectedY[i];
+        projectedPos->z = table->projectedZ[i];
+        FIELD(actor, ACTOR_PROJECTED_W, float) = table->projectedW[i];
+        line_log_touch(projectedPos, sizeof(Vec3f) + sizeof(float));
+        line_log_touch(actor + ACTOR_FLAGS, sizeof(uint32_t));
+        if (table->isInView[i]) {
+            FIELD(actor, ACTOR_FLAGS, uint32_t) |= ACTOR_FLAG_40;
+            numInView++;
+        } else {
+            FIELD(actor, ACTOR_FLAGS, uint32_t) &= ~ACTOR_FLAG_40;
+        }
+    }
+    return numInView;
+}
+
+typedef struct {
+    float projected[4];
+    uint32_t flags;
+} ActorResult;
+
+static void save_results(ActorLists* lists, ActorResult* out) {
+    int n = 0;
+    int i;
+
+    for (i = 0; i < ACTORCAT_MAX; i++) {
+        uint8_t* actor;
+
+        for (actor = lists->first[i]; actor != NULL; actor = FIELD(actor, ACTOR_NEXT, uint8_t*)) {
+            memcpy(out[n].projected, actor + ACTOR_PROJECTED_POS, sizeof(out[n].projected));
+            out[n].flags = FIELD(actor, ACTOR_FLAGS, uint32_t);
+            n++;
+        }
+    }
+}
+
+static volatile uint8_t sEvictSink;
+
+static void evict_caches(uint8_t* buffer) {
+    size_t i;
+    uint8_t sum = 0;
+
+    for (i = 0; i < EVICT_SIZE; i += 64) {
+        buffer[i]++;
+        sum += buffer[i];
+    }
+    sEvictSink = sum;
+}
+
+static double get_time(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_usage(const char* progname) {
+    printf("actorbench version %s\n", ACTORBENCH_VER);
+    printf("usage: %s [-n ACTORS] [-i ITERATIONS] [-f FOVY] [-s SEED] [-w]\n", progname);
+    printf("-n ACTORS      number of actors in the scene, at most %d (default 200)\n", ACTOR_HOT_TABLE_MAX);
+    printf("-i ITERATIONS  timed passes of each version (default 2000)\n");
+    printf("-f FOVY        view fovy, 60 takes the unscaled cull path (default 60)\n");
+    printf("-s SEED        scene layout seed (default 1)\n");
+    printf("-w             keep the caches warm between passes instead of evicting the scene\n");
+}
+
+int main(int argc, char** argv) {
+    ActorLists lists;
+    Scene scene;
+    static ActorHotTable table;
+    ActorResult* expected;
+    ActorResult* actual;
+    uint8_t* evictBuffer = NULL;
+    int numActors = 200;
+    int iterations = 2000;
+    float fovy = 60.0f;
+    uint32_t seed = 1;
+    bool warm = false;
+    double perActorTime = 0.0;
+    double hotTableTime = 0.0;
+    size_t perActorLines;
+    size_t hotTableLines;
+    int numInView;
+    int opt;
+    int i;
+
+    while ((opt = getopt(argc, argv, "n:i:f:s:wh")) != -1) {
+        switch (opt) {
+            case 'n':
+                numActors = atoi(optarg);
+                break;
+            case 'i':
+                iterations = atoi(optarg);
+                break;
+            case 'f':
+                fovy = atof(optarg);
+                break;
+            case 's':
+                seed = strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                warm = true;
+                break;
+            default:
+                print_usage(argv[0]);
+                return (opt == 'h') ? 0 : 1;
+        }
+    }
+    if ((numActors <= 0) || (numActors > ACTOR_HOT_TABLE_MAX) || (iterations <= 0)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    init_actors(&lists, numActors, seed);
+    init_view(&scene, fovy);
+    expected = calloc(numActors, sizeof(ActorResult));
+    actual = calloc(numActors, sizeof(ActorResult));
+
+    // Both versions must leave every actor with the same projection and ACTOR_FLAG_40
+    numInView = per_actor_project_and_cull(&scene, &lists);
+    save_results(&lists, expected);
+    for (i = 0; i < ACTORCAT_MAX; i++) {
+        uint8_t* actor;
+
+        for (actor = lists.first[i]; actor != NULL; actor = FIELD(actor, ACTOR_NEXT, uint8_t*)) {
+            memset(actor + ACTOR_PROJECTED_POS, 0, 4 * sizeof(float));
+            FIELD(actor, ACTOR_FLAGS, uint32_t) ^= ACTOR_FLAG_40;
+        }
+    }
+    hot_table_sync(&table, &lists);
+    hot_table_project_and_cull(&table, &scene);
+    if (hot_table_apply(&table) != numInView) {
+        fprintf(stderr, "in-view count mismatch\n");
+        return 1;
+    }
+    save_results(&lists, actual);
+    if (memcmp(expected, actual, numActors * sizeof(ActorResult)) != 0) {
+        fprintf(stderr, "results differ between the per-actor pass and the hot table\n");
+        return 1;
+    }
+
+    sLineLog.enabled = true;
+    per_actor_project_and_cull(&scene, &lists);
+    perActorLines = line_log_count_distinct();
+    sLineLog.count = 0;
+    hot_table_sync(&table, &lists);
+    hot_table_project_and_cull(&table, &scene);
+    hot_table_apply(&table);
+    hotTableLines = line_log_count_distinct();
+    sLineLog.enabled = false;
+
+    if (!warm) {
+        evictBuffer = malloc(EVICT_SIZE);
+        memset(evictBuffer, 0, EVICT_SIZE);
+    }
+    for (i = 0; i < iterations; i++) {
+        double start;
+
+        if (!warm) {
+            evict_caches(evictBuffer);
+        }
+        start = get_time();
+        per_actor_project_and_cull(&scene, &lists);
+        perActorTime += get_time() - start;
+
+        if (!warm) {
+            evict_caches(evictBuffer);
+        }
+        start = get_time();
+        hot_table_sync(&table, &lists);
+        hot_table_project_and_cull(&table, &scene);
+        hot_table_apply(&table);
+        hotTableTime += get_time() - start;
+    }
+
+    printf("%d actors, %d in view, %s caches, results match\n", numActors, numInView, warm ? "warm" : "cold");
+    printf("%-10s %10s %14s\n", "pass", "us/pass", "dcache lines");
+    printf("%-10s %10.3f %14zu\n", "per-actor", perActorTime * 1e6 / iterations, perActorLines);
+    printf("%-10s %10.3f %14zu\n", "hot table", hotTableTime * 1e6 / iterations, hotTableLines);
+
+    free(evictBuffer);
+    free(expected);
+    free(actual);
+    free(lists.heap);
+    free(sLineLog.lines);
+    return 0;
+}
@@ -0,0 +1,748 @@
+/*
+ * audiohle: runs an audio command list (Acmd) taken from an RDRAM dump on the host, in place of the RSP audio
+ * microcode, and writes the resulting samples to a file.
+ *
+ * The command set is the one listed in include/PR/abi.h and built by src/audio/lib/synthesis.c. Each command is
+ * emulated at a high level from its documented effect, so the output is close to, but not bit-exact with, what the
+ * microcode produces. The resample filter in particular uses a Catmull-Rom kernel in place of the microcode's table.
+ * This is enough to compare two builds of the synthesis code against each other, and to time how the cost of a frame
+ * is split between command types.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+#define AUDIOHLE_VER "0.1"
+
+#define DMEM_SIZE 0x1000
+#define RDRAM_MASK 0x00FFFFFF
+
+#define A_SPNOOP 0
+#define A_ADPCM 1
+#define A_CLEARBUFF 2
+#define A_UNK3 3
+#define A_ADDMIXER 4
+#define A_RESAMPLE 5
+#define A_RESAMPLE_ZOH 6
+#define A_FILTER 7
+#define A_SETBUFF 8
+#define A_DUPLICATE 9
+#define A_DMEMMOVE 10
+#define A_LOADADPCM 11
+#define A_MIXER 12
+#define A_INTERLEAVE 13
+#define A_HILOGAIN 14
+#define A_SETLOOP 15
+#define A_INTERL 17
+#define A_ENVSETUP1 18
+#define A_ENVMIXER 19
+#define A_LOADBUFF 20
+#define A_SAVEBUFF 21
+#define A_ENVSETUP2 22
+#define A_S8DEC 23
+#define A_UNK19 25
+#define A_CMD_MAX 32
+
+#define A_INIT 0x01
+#define A_LOOP 0x02
+#define A_ADPCM_SHORT 0x04
+
+typedef struct {
+    uint8_t* rdram;
+    size_t rdramSize;
+    uint8_t dmem[DMEM_SIZE];
+    /* Set by A_SETBUFF */
+    uint16_t in;
+    uint16_t out;
+    uint16_t count;
+    /* Set by A_LOADADPCM and A_SETLOOP */
+    int16_t adpcmTable[0x80];
+    uint32_t loopAddr;
+    /* Set by A_FILTER with flags 2 */
+    uint16_t filterCount;
+    uint32_t filterAddr;
+    /* Set by A_ENVSETUP1 and A_ENVSETUP2: dry left, dry right, wet */
+    uint16_t envValues[3];
+    uint16_t envSteps[3];
+} AudioHle;
+
+typedef struct {
+    uint64_t count[A_CMD_MAX];
+    uint64_t nanoseconds[A_CMD_MAX];
+} AudioHleStats;
+
+static const char* sCmdNames[A_CMD_MAX] = {
+    "SPNOOP",   "ADPCM",    "CLEARBUFF", "UNK3",      "ADDMIXER", "RESAMPLE", "RESAMPLE_ZOH", "FILTER",
+    "SETBUFF",  "DUPLICATE", "DMEMMOVE", "LOADADPCM", "MIXER",    "INTERLEAVE", "HILOGAIN",   "SETLOOP",
+    "16",       "INTERL",   "ENVSETUP1", "ENVMIXER",  "LOADBUFF", "SAVEBUFF", "ENVSETUP2",    "S8DEC",
+    "24",       "UNK19",    "26",        "27",        "28",       "29",       "30",           "31",
+};
+
+static int16_t sResampleTable[64][4];
+
+const struct option cmdline_opts[] = {
+    { "rdram", required_argument, NULL, 'r', },
+    { "list", required_argument, NULL, 'l', },
+    { "count", required_argument, NULL, 'c', },
+    { "out-addr", required_argument, NULL, 'a', },
+    { "out-size", required_argument, NULL, 's', },
+    { "out", required_argument, NULL, 'o', },
+    { "repeat", required_argument, NULL, 'n', },
+    { "version", no_argument, NULL, '~', },
+    { "help", no_argument, NULL, '?', },
+    { 0, 0, 0, 0 },
+};
+
+static uint32_t parse_int(const char* num) {
+    return strtoul(num, NULL, 0);
+}
+
+static void print_usage(void) {
+    puts("audiohle version " AUDIOHLE_VER "\n"
+         "Usage:\n"
+         "  audiohle -r/--rdram FILE -l/--list ADDR -c/--count N [options]\n"
+         "  audiohle -?/--help\n"
+         "  audiohle --version\n"
+         "Options:\n"
+         "  -r, --rdram FILE     Big-endian RDRAM dump to run the command list against\n"
+         "  -l, --list ADDR      Address of the command list, e.g. the task's data_ptr\n"
+         "  -c, --count N        Number of commands in the list\n"
+         "  -a, --out-addr ADDR  Address of the buffer to write out after running, e.g. the AI buffer\n"
+         "  -s, --out-size SIZE  Size of that buffer in bytes\n"
+         "  -o, --out FILE       File to write that buffer to, as big-endian 16-bit stereo PCM\n"
+         "  -n, --repeat N       Run the list N times from the same dump and report the time per command type");
+}
+
+static void print_version(void) {
+    puts("audiohle version " AUDIOHLE_VER);
+}
+
+static int16_t clamp16(int32_t x) {
+    if (x < -0x8000) {
+        return -0x8000;
+    }
+    if (x > 0x7FFF) {
+        return 0x7FFF;
+    }
+    return x;
+}
+
+static uint16_t align(uint32_t x, uint32_t n) {
+    return (x + n - 1) & ~(n - 1);
+}
+
+static uint8_t* rdram_ptr(AudioHle* hle, uint32_t addr, size_t size) {
+    addr &= RDRAM_MASK;
+    if (addr + size > hle->rdramSize) {
+        fprintf(stderr, "audiohle: access to 0x%06X-0x%06zX is outside of the RDRAM dump\n", addr, addr + size);
+        exit(1);
+    }
+    return &hle->rdram[addr];
+}
+
+static int16_t rdram_s16(AudioHle* hle, uint32_t addr) {
+    uint8_t* p = rdram_ptr(hle, addr, 2);
+
+    return (int16_t)((p[0] << 8) | p[1]);
+}
+
+static void rdram_set_s16(AudioHle* hle, uint32_t addr, int16_t x) {
+    uint8_t* p = rdram_ptr(hle, addr, 2);
+
+    p[0] = (uint16_t)x >> 8;
+    p[1] = (uint16_t)x & 0xFF;
+}
+
+/* DMEM is kept big-endian like RDRAM, so loads and saves are plain copies */
+static int16_t dmem_s16(AudioHle* hle, uint32_t addr) {
+    addr &= DMEM_SIZE - 2;
+    return (int16_t)((hle->dmem[addr] << 8) | hle->dmem[addr + 1]);
+}
+
+static void dmem_set_s16(AudioHle* hle, uint32_t addr, int16_t x) {
+    addr &= DMEM_SIZE - 2;
+    hle->dmem[addr] = (uint16_t)x >> 8;
+    hle->dmem[addr + 1] = (uint16_t)x & 0xFF;
+}
+
+static void dmem_copy(AudioHle* hle, uint32_t dest, uint32_t src, uint32_t size) {
+    uint32_t i;
+
+    /* Forwards, byte by byte, so overlapping moves behave like the microcode's */
+    for (i = 0; i < size; i++) {
+        hle->dmem[(dest + i) & (DMEM_SIZE - 1)] = hle->dmem[(src + i) & (DMEM_SIZE - 1)];
+    }
+}
+
+static void init_resample_table(void) {
+    int i;
+
+    for (i = 0; i < 64; i++) {
+        double t = i / 64.0;
+        double t2 = t * t;
+        double t3 = t2 * t;
+
+        sResampleTable[i][0] = (int16_t)(0x8000 * 0.5 * (-t3 + 2 * t2 - t));
+        sResampleTable[i][1] = (int16_t)(0x7FFF * 0.5 * (3 * t3 - 5 * t2 + 2));
+        sResampleTable[i][2] = (int16_t)(0x7FFF * 0.5 * (-3 * t3 + 4 * t2 + t));
+        sResampleTable[i][3] = (int16_t)(0x8000 * 0.5 * (t3 - t2));
+    }
+}
+
+/*
+ * Decodes `count` bytes of samples from `in` to `out`, after first writing the last 16 samples of the previous call,
+ * which are kept in RDRAM at `stateAddr`
+ */
+static void cmd_adpcm(AudioHle* hle, uint8_t flags, uint32_t stateAddr) {
+    bool isShort = flags & A_ADPCM_SHORT;
+    uint32_t frameSize = isShort ? 5 : 9;
+    uint32_t in = hle->in;
+    uint32_t out = hle->out;
+    int32_t count = align(hle->count, 32);
+    int16_t last[16];
+    int16_t residuals[16];
+    int i;
+    int j;
+
+    if (flags & A_INIT) {
+        memset(last, 0, sizeof(last));
+    } else {
+        for (i = 0; i < 16; i++) {
+            last[i] = rdram_s16(hle, ((flags & A_LOOP) ? hle->loopAddr : stateAddr) + i * 2);
+        }
+    }
+
+    for (i = 0; i < 16; i++) {
+        dmem_set_s16(hle, out + i * 2, last[i]);
+    }
+    out += 32;
+
+    for (; count > 0; count -= 32) {
+        uint8_t header = hle->dmem[in & (DMEM_SIZE - 1)];
+        int scale = header >> 4;
+        const int16_t* book1 = &hle->adpcmTable[(header & 0xF) << 4];
+        const int16_t* book2 = book1 + 8;
+
+        for (i = 0; i < 16; i++) {
+            uint8_t byte = hle->dmem[(in + 1 + (isShort ? i / 4 : i / 2)) & (DMEM_SIZE - 1)];
+            int16_t nibble;
+
+            if (isShort) {
+                nibble = (int16_t)(((byte << ((i % 4) * 2)) & 0xC0) << 8);
+                residuals[i] = nibble >> ((scale < 14) ? (14 - scale) : 0);
+            } else {
+                nibble = (int16_t)(((byte << ((i % 2) * 4)) & 0xF0) << 8);
+                residuals[i] = nibble >> ((scale < 12) ? (12 - scale) : 0);
+            }
+        }
+        in += frameSize;
+
+        /* Each half of the frame is predicted from the last two samples before it */
+        for (j = 0; j < 16; j += 8) {
+            int16_t prev2 = last[(j == 0) ? 14 : 6];
+            int16_t prev1 = last[(j == 0) ? 15 : 7];
+            int16_t half[8];
+
+            for (i = 0; i < 8; i++) {
+                int32_t accum = (int32_t)residuals[j + i] << 11;
+                int k;
+
+                accum += book1[i] * prev2 + book2[i] * prev1;
+                for (k = 0; k < i; k++) {
+                    accum += book2[k] * residuals[j + i - 1 - k];
+                }
+                half[i] = clamp16(accum >> 11);
+            }
+            memcpy(&last[j], half, sizeof(half));
+        }
+
+        for (i = 0; i < 16; i++) {
+            dmem_set_s16(hle, out + i * 2, last[i]);
+        }
+        out += 32;
+    }
+
+    for (i = 0; i < 16; i++) {
+        rdram_set_s16(hle, stateAddr + i * 2, last[i]);
+    }
+}
+
+/* Like cmd_adpcm, for signed 8-bit samples */
+static void cmd_s8dec(AudioHle* hle, uint8_t flags, uint32_t stateAddr) {
+    uint32_t out = hle->out;
+    int32_t count = align(hle->count, 16);
+    int16_t last[16];
+    int i;
+
+    if (flags & A_INIT) {
+        memset(last, 0, sizeof(last));
+    } else {
+        for (i = 0; i < 16; i++) {
+            last[i] = rdram_s16(hle, ((flags & A_LOOP) ? hle->loopAddr : stateAddr) + i * 2);
+        }
+    }
+
+    for (i = 0; i < 16; i++) {
+        dmem_set_s16(hle, out + i * 2, last[i]);
+    }
+    out += 32;
+
+    for (i = 0; i < count; i++) {
+        int16_t sample = (int16_t)(hle->dmem[(hle->in + i) & (DMEM_SIZE - 1)] << 8);
+
+        dmem_set_s16(hle, out + i * 2, sample);
+        last[i % 16] = sample;
+    }
+
+    for (i = 0; i < 16; i++) {
+        rdram_set_s16(hle, stateAddr + i * 2, last[i]);
+    }
+}
+
+/*
+ * Resamples `count` bytes of output from `in` at a step of `pitch` / 0x8000 input samples. The 4 samples before `in`
+ * and the fractional position are carried over between calls in RDRAM at `stateAddr`
+ */
+static void cmd_resample(AudioHle* hle, uint8_t flags, uint16_t pitch, uint32_t stateAddr) {
+    uint32_t ipos = hle->in - 8;
+    uint32_t opos = hle->out;
+    int32_t count = align(hle->count, 16) / 2;
+    uint32_t pitchAccum;
+    uint32_t step = (uint32_t)pitch << 1;
+    int i;
+
+    if (flags & A_INIT) {
+        for (i = 0; i < 4; i++) {
+            dmem_set_s16(hle, ipos + i * 2, 0);
+        }
+        pitchAccum = 0;
+    } else {
+        for (i = 0; i < 4; i++) {
+            dmem_set_s16(hle, ipos + i * 2, rdram_s16(hle, stateAddr + i * 2));
+        }
+        pitchAccum = (uint16_t)rdram_s16(hle, stateAddr + 8);
+    }
+
+    for (; count > 0; count--) {
+        const int16_t* coefs = sResampleTable[pitchAccum >> 10];
+        int32_t accum = 0;
+
+        for (i = 0; i < 4; i++) {
+            accum += dmem_s16(hle, ipos + i * 2) * coefs[i];
+        }
+        dmem_set_s16(hle, opos, clamp16(accum >> 15));
+        opos += 2;
+
+        pitchAccum += step;
+        ipos += (pitchAccum >> 16) * 2;
+        pitchAccum &= 0xFFFF;
+    }
+
+    for (i = 0; i < 4; i++) {
+        rdram_set_s16(hle, stateAddr + i * 2, dmem_s16(hle, ipos + i * 2));
+    }
+    rdram_set_s16(hle, stateAddr + 8, pitchAccum);
+}
+
+static void cmd_resample_zoh(AudioHle* hle, uint16_t pitch, uint16_t pitchAccum) {
+    uint32_t ipos = hle->in;
+    uint32_t opos = hle->out;
+    int32_t count = align(hle->count, 8) / 2;
+    uint32_t accum = pitchAccum;
+    uint32_t step = (uint32_t)pitch << 1;
+
+    for (; count > 0; count--) {
+        dmem_set_s16(hle, opos, dmem_s16(hle, ipos));
+        opos += 2;
+
+        accum += step;
+        ipos += (accum >> 16) * 2;
+        accum &= 0xFFFF;
+    }
+}
+
+/*
+ * 8-tap FIR over `hle->filterCount` bytes at `dmem`, with the coefficients set by the previous A_FILTER command and the
+ * last 8 input samples kept in RDRAM at `stateAddr`
+ */
+static void cmd_filter(AudioHle* hle, uint8_t flags, uint16_t dmem, uint32_t stateAddr) {
+    int16_t history[8];
+    int16_t coefs[8];
+    int32_t count = align(hle->filterCount, 16) / 2;
+    int i;
+    int n;
+
+    for (i = 0; i < 8; i++) {
+        coefs[i] = rdram_s16(hle, hle->filterAddr + i * 2);
+        history[i] = (flags & A_INIT) ? 0 : rdram_s16(hle, stateAddr + i * 2);
+    }
+
+    for (n = 0; n < count; n++) {
+        int32_t accum = 0;
+
+        memmove(&history[0], &history[1], sizeof(history) - sizeof(history[0]));
+        history[7] = dmem_s16(hle, dmem + n * 2);
+
+        for (i = 0; i < 8; i++) {
+            accum += history[i] * coefs[7 - i];
+        }
+        dmem_set_s16(hle, dmem + n * 2, clamp16(accum >> 14));
+    }
+
+    for (i = 0; i < 8; i++) {
+        rdram_set_s16(hle, stateAddr + i * 2, history[i]);
+    }
+}
+
+/*
+ * Mixes `count` samples from `in` into the dry and wet buffers of both channels. The volumes ramp by their step every
+ * 8 samples, and each of the four outputs can be phase inverted by its flag
+ */
+static void cmd_envmixer(AudioHle* hle, uint32_t w0, uint32_t w1) {
+    uint32_t in = (w0 >> 12) & 0xFF0;
+    int32_t count = align((w0 >> 8) & 0xFF, 8);
+    bool swapWetLR = (w0 >> 4) & 1;
+    uint32_t dryLeft = (w1 >> 20) & 0xFF0;
+    uint32_t dryRight = (w1 >> 12) & 0xFF0;
+    uint32_t wetLeft = (w1 >> 4) & 0xFF0;
+    uint32_t wetRight = (w1 << 4) & 0xFF0;
+    int16_t invDryLeft = -(int16_t)(w0 & 1);
+    int16_t invDryRight = -(int16_t)((w0 >> 1) & 1);
+    int16_t invWetLeft = -(int16_t)((w0 >> 2) & 1);
+    int16_t invWetRight = -(int16_t)((w0 >> 3) & 1);
+    int i;
+
+    if (swapWetLR) {
+        uint32_t temp = wetLeft;
+
+        wetLeft = wetRight;
+        wetRight = temp;
+    }
+
+    for (; count > 0; count -= 8) {
+        for (i = 0; i < 8; i++) {
+            int32_t sample = dmem_s16(hle, in);
+            int16_t left = (int16_t)((sample * hle->envValues[0]) >> 16);
+            int16_t right = (int16_t)((sample * hle->envValues[1]) >> 16);
+            int16_t wetL = (int16_t)((left * hle->envValues[2]) >> 16);
+            int16_t wetR = (int16_t)((right * hle->envValues[2]) >> 16);
+
+            dmem_set_s16(hle, dryLeft, clamp16(dmem_s16(hle, dryLeft) + (left ^ invDryLeft)));
+            dmem_set_s16(hle, dryRight, clamp16(dmem_s16(hle, dryRight) + (right ^ invDryRight)));
+            dmem_set_s16(hle, wetLeft, clamp16(dmem_s16(hle, wetLeft) + (wetL ^ invWetLeft)));
+            dmem_set_s16(hle, wetRight, clamp16(dmem_s16(hle, wetRight) + (wetR ^ invWetRight)));
+
+            in += 2;
+            dryLeft += 2;
+            dryRight += 2;
+            wetLeft += 2;
+            wetRight += 2;
+        }
+
+        hle->envValues[0] += hle->envSteps[0];
+        hle->envValues[1] += hle->envSteps[1];
+        hle->envValues[2] += hle->envSteps[2];
+    }
+}
+
+static void run_command(AudioHle* hle, uint32_t w0, uint32_t w1) {
+    uint8_t flags = (w0 >> 16) & 0xFF;
+    uint32_t i;
+    uint32_t count;
+    uint32_t in;
+    uint32_t out;
+
+    switch (w0 >> 24) {
+        case A_ADPCM:
+            cmd_adpcm(hle, flags, w1);
+            break;
+
+        case A_CLEARBUFF:
+            count = align(w1 & 0xFFFF, 16);
+            for (i = 0; i < count; i++) {
+                hle->dmem[((w0 & 0xFFFF) + i) & (DMEM_SIZE - 1)] = 0;
+            }
+            break;
+
+        case A_ADDMIXER:
+            count = (w0 >> 12) & 0xFF0;
+            in = w1 >> 16;
+            out = w1 & 0xFFFF;
+            for (i = 0; i < count; i += 2) {
+                dmem_set_s16(hle, out + i, clamp16(dmem_s16(hle, out + i) + dmem_s16(hle, in + i)));
+            }
+            break;
+
+        case A_RESAMPLE:
+            cmd_resample(hle, flags, w0 & 0xFFFF, w1);
+            break;
+
+        case A_RESAMPLE_ZOH:
+            cmd_resample_zoh(hle, w0 & 0xFFFF, w1 & 0xFFFF);
+            break;
+
+        case A_FILTER:
+            if (flags > A_INIT) {
+                hle->filterCount = w0 & 0xFFFF;
+                hle->filterAddr = w1;
+            } else {
+                cmd_filter(hle, flags, w0 & 0xFFFF, w1);
+            }
+            break;
+
+        case A_SETBUFF:
+            hle->in = w0 & 0xFFFF;
+            hle->out = w1 >> 16;
+            hle->count = w1 & 0xFFFF;
+            break;
+
+        case A_DUPLICATE:
+            count = (w0 >> 16) & 0xFF;
+            in = w0 & 0xFFFF;
+            out = w1 >> 16;
+            for (i = 0; i < count; i++) {
+                dmem_copy(hle, out + i * 0x80, in, 0x80);
+            }
+            break;
+
+        case A_DMEMMOVE:
+            dmem_copy(hle, w1 >> 16, w0 & 0xFFFF, align(w1 & 0xFFFF, 16));
+            break;
+
+        case A_LOADADPCM:
+            count = (w0 & 0xFFFF) / 2;
+            for (i = 0; (i < count) && (i < 0x80); i++) {
+                hle->adpcmTable[i] = rdram_s16(hle, w1 + i * 2);
+            }
+            break;
+
+        case A_MIXER:
+            count = (w0 >> 12) & 0xFF0;
+            in = w1 >> 16;
+            out = w1 & 0xFFFF;
+            for (i = 0; i < count; i += 2) {
+                int32_t mixed = (dmem_s16(hle, in + i) * (int16_t)(w0 & 0xFFFF)) >> 15;
+
+                dmem_set_s16(hle, out + i, clamp16(dmem_s16(hle, out + i) + mixed));
+            }
+            break;
+
+        case A_INTERLEAVE:
+            count = (w0 >> 12) & 0xFF0;
+            out = w0 & 0xFFFF;
+            in = w1 >> 16;
+            for (i = 0; i < count; i += 2) {
+                dmem_set_s16(hle, out + i * 2, dmem_s16(hle, in + i));
+                dmem_set_s16(hle, out + i * 2 + 2, dmem_s16(hle, (w1 & 0xFFFF) + i));
+            }
+            break;
+
+        case A_HILOGAIN:
+            count = w0 & 0xFFFF;
+            in = w1 >> 16;
+            for (i = 0; i < count; i += 2) {
+                dmem_set_s16(hle, in + i, clamp16((dmem_s16(hle, in + i) * (int8_t)flags) >> 4));
+            }
+            break;
+
+        case A_SETLOOP:
+            hle->loopAddr = w1;
+            break;
+
+        case A_INTERL:
+            count = w0 & 0xFFFF;
+            in = w1 >> 16;
+            out = w1 & 0xFFFF;
+            for (i = 0; i < count; i++) {
+                dmem_set_s16(hle, out + i * 2, dmem_s16(hle, in + i * 4));
+            }
+            break;
+
+        case A_ENVSETUP1:
+            hle->envValues[2] = (w0 >> 8) & 0xFF00;
+            hle->envSteps[2] = w0 & 0xFFFF;
+            hle->envSteps[0] = w1 >> 16;
+            hle->envSteps[1] = w1 & 0xFFFF;
+            break;
+
+        case A_ENVMIXER:
+            cmd_envmixer(hle, w0, w1);
+            break;
+
+        case A_LOADBUFF:
+            count = (w0 >> 12) & 0xFF0;
+            in = w0 & (DMEM_SIZE - 1);
+            memcpy(&hle->dmem[in], rdram_ptr(hle, w1, count), (count <= DMEM_SIZE - in) ? count : DMEM_SIZE - in);
+            break;
+
+        case A_SAVEBUFF:
+            count = (w0 >> 12) & 0xFF0;
+            out = w0 & (DMEM_SIZE - 1);
+            memcpy(rdram_ptr(hle, w1, count), &hle->dmem[out], (count <= DMEM_SIZE - out) ? count : DMEM_SIZE - out);
+            break;
+
+        case A_ENVSETUP2:
+            hle->envValues[0] = w1 >> 16;
+            hle->envValues[1] = w1 & 0xFFFF;
+            break;
+
+        case A_S8DEC:
+            cmd_s8dec(hle, flags, w1);
+            break;
+
+        default:
+            break;
+    }
+}
+
+static uint64_t get_time_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void run_list(AudioHle* hle, uint32_t listAddr, uint32_t numCmds, AudioHleStats* stats) {
+    uint32_t i;
+
+    for (i = 0; i < numCmds; i++) {
+        uint8_t* cmd = rdram_ptr(hle, listAddr + i * 8, 8);
+        uint32_t w0 = ((uint32_t)cmd[0] << 24) | (cmd[1] << 16) | (cmd[2] << 8) | cmd[3];
+        uint32_t w1 = ((uint32_t)cmd[4] << 24) | (cmd[5] << 16) | (cmd[6] << 8) | cmd[7];
+        uint64_t start = get_time_ns();
+
+        run_command(hle, w0, w1);
+
+        stats->count[(w0 >> 24) & (A_CMD_MAX - 1)]++;
+        stats->nanoseconds[(w0 >> 24) & (A_CMD_MAX - 1)] += get_time_ns() - start;
+    }
+}
+
+static uint8_t* read_file(const char* filename, size_t* size) {
+    FILE* f = fopen(filename, "rb");
+    uint8_t* data;
+
+    if (f == NULL) {
+        perror(filename);
+        exit(1);
+    }
+
+    fseek(f, 0, SEEK_END);
+    *size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    data = malloc(*size);
+    if ((data == NULL) || (fread(data, 1, *size, f) != *size)) {
+        fprintf(stderr, "audiohle: could not read %s\n", filename);
+        exit(1);
+    }
+
+    fclose(f);
+    return data;
+}
+
+int main(int argc, char** argv) {
+    int opt;
+    char* rdramFilename = NULL;
+    char* outFilename = NULL;
+    uint32_t listAddr = 0;
+    uint32_t numCmds = 0;
+    uint32_t outAddr = 0;
+    uint32_t outSize = 0;
+    uint32_t repeat = 1;
+    uint8_t* rdramOrig;
+    AudioHle* hle;
+    AudioHleStats stats;
+    uint32_t i;
+
+    while (1) {
+        opt = getopt_long(argc, argv, "r:l:c:a:s:o:n:?", cmdline_opts, NULL);
+        if (opt == -1) {
+            break;
+        }
+        switch (opt) {
+            case 'r':
+                rdramFilename = optarg;
+                break;
+            case 'l':
+                listAddr = parse_int(optarg);
+                break;
+            case 'c':
+                numCmds = parse_int(optarg);
+                break;
+            case 'a':
+                outAddr = parse_int(optarg);
+                break;
+            case 's':
+                outSize = parse_int(optarg);
+                break;
+            case 'o':
+                outFilename = optarg;
+                break;
+            case 'n':
+                repeat = parse_int(optarg);
+                break;
+            case '~':
+                print_version();
+                return 0;
+            case '?':
+                print_usage();
+                return 0;
+        }
+    }
+
+    if ((rdramFilename == NULL) || (numCmds == 0) || (repeat == 0)) {
+        printf("Must specify -r, -l and -c\n");
+        print_usage();
+        exit(1);
+    }
+
+    hle = calloc(1, sizeof(AudioHle));
+    if (hle == NULL) {
+        exit(1);
+    }
+    rdramOrig = read_file(rdramFilename, &hle->rdramSize);
+    hle->rdram = malloc(hle->rdramSize);
+    if (hle->rdram == NULL) {
+        exit(1);
+    }
+
+    init_resample_table();
+    memset(&stats, 0, sizeof(stats));
+
+    for (i = 0; i < repeat; i++) {
+        memcpy(hle->rdram, rdramOrig, hle->rdramSize);
+        memset(hle->dmem, 0, sizeof(hle->dmem));
+        run_list(hle, listAddr, numCmds, &stats);
+    }
+
+    if (outFilename != NULL) {
+        FILE* f = fopen(outFilename, "wb");
+
+        if ((f == NULL) || (fwrite(rdram_ptr(hle, outAddr, outSize), 1, outSize, f) != outSize)) {
+            perror(outFilename);
+            exit(1);
+        }
+        fclose(f);
+    }
+
+    printf("%-12s %10s %14s\n", "command", "count", "ns per run");
+    for (i = 0; i < A_CMD_MAX; i++) {
+        if (stats.count[i] != 0) {
+            printf("%-12s %10" PRIu64 " %14" PRIu64 "\n", sCmdNames[i], stats.count[i] / repeat,
+                   stats.nanoseconds[i] / repeat);
+        }
+    }
+
+    free(hle->rdram);
+    free(rdramOrig);
+    free(hle);
+    return 0;
+}
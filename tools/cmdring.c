@@ -0,0 +1,496 @@
+/*
+ * cmdring: stress test for the ring of audio commands the graph thread queues and the audio thread processes.
+ *
+ * queue_cmd, schedule_process_cmds, reset_cmd_queue, process_cmds and run_audio_frame are copies of
+ * AudioThread_QueueCmd, AudioThread_ScheduleProcessCmds, AudioThread_ResetCmdQueue, AudioThread_ProcessCmds and the
+ * command part of AudioThread_UpdateImpl in src/audio/lib/thread.c, and need to be kept in sync with them.
+ *
+ * Only one thread runs at a time and the audio thread has the higher priority, so it can start between any two
+ * statements of the graph thread but always runs a whole frame. PREEMPT() marks those points in the graph thread
+ * copies and sometimes runs an audio frame there. AudioThread_ResetCmdQueue is only called while the audio thread is
+ * resetting the heap and not reading commands, so the test lets the audio thread drain the message queue first and
+ * does not preempt the reset.
+ *
+ * Every queued command carries a serial number as data. The test keeps the list of commands the audio thread should
+ * process, applying coalescing, drops and resets as the stats report them, and checks that:
+ * - the audio thread processes exactly that list, in order and with the data of the latest coalesced command
+ * - a command is only coalesced into a command with the same op and args, with only coalescible commands after it
+ * - a command is only dropped when every other slot holds a command the audio thread has not processed
+ * - the write position is always as far ahead of the audio thread's read position as the list says
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CMDRING_VER "0.1"
+
+#define SEQ_PLAYER_MAX 5
+#define SEQ_NUM_CHANNELS 16
+#define THREAD_CMD_PROC_MSG_COUNT 4
+#define COALESCE_KEY_COUNT (3 * SEQ_PLAYER_MAX * SEQ_NUM_CHANNELS)
+
+#define AUDIOCMD_OP_CHANNEL_SET_VOL_SCALE 0x01
+#define AUDIOCMD_OP_CHANNEL_SET_VOL 0x02
+#define AUDIOCMD_OP_CHANNEL_SET_PAN 0x03
+#define AUDIOCMD_OP_CHANNEL_SET_FREQ_SCALE 0x04
+#define AUDIOCMD_OP_SEQPLAYER_SET_TEMPO 0x47
+#define AUDIOCMD_OP_GLOBAL_STOP_AUDIOCMDS 0xF8
+#define AUDIOCMD_ALL_CHANNELS 0xFF
+
+#define AUDIO_MK_CMD(op, a, b, c) \
+    ((uint32_t)(((op) & 0xFF) << 24) | (((a) & 0xFF) << 16) | (((b) & 0xFF) << 8) | ((c) & 0xFF))
+
+typedef struct {
+    uint32_t opArgs;
+    uint32_t data;
+} AudioCmd;
+
+typedef struct {
+    uint32_t queued;
+    uint32_t coalesced;
+    uint32_t dropped;
+    uint32_t publishFailures;
+    uint32_t maxPending;
+} AudioCmdQueueStats;
+
+typedef struct {
+    uint8_t threadCmdWritePos;
+    uint8_t threadCmdReadPos;
+    uint8_t threadCmdQueueFinished;
+    AudioCmd threadCmdBuf[0x100];
+    uint32_t threadCmdProcMsgBuf[THREAD_CMD_PROC_MSG_COUNT];
+    int msgHead;
+    int msgCount;
+} AudioCtx;
+
+static AudioCtx gAudioCtx;
+static uint8_t sThreadCmdCoalesceSlots[COALESCE_KEY_COUNT];
+static uint8_t sThreadCmdCoalesceKeys[COALESCE_KEY_COUNT];
+static int sThreadCmdNumCoalesceKeys;
+static uint8_t sCurCmdRdPos;
+static AudioCmdQueueStats gAudioCmdQueueStats;
+
+static uint32_t sRandState = 1;
+static unsigned sPreemptRate = 64;
+static bool sNoPreempt;
+
+static uint32_t next_rand(void) {
+    sRandState = sRandState * 1664525 + 1013904223;
+    return sRandState >> 8;
+}
+
+/*
+ * Expected commands
+ */
+
+static AudioCmd* sExpected;
+static size_t sNumExpected;
+static size_t sExpectedCapacity;
+static size_t sNumFetched;       // entries of sExpected the audio thread has taken from the ring, stops included
+static size_t sNumSkipped;       // commands a reset left in the ring that the audio thread has not skipped yet
+static size_t sSlotOwner[0x100]; // entry of sExpected last written to each ring slot
+static size_t sNumProcessed;
+static unsigned sNumErrors;
+
+static void report(const char* msg, size_t index) {
+    if (sNumErrors < 10) {
+        printf("error: %s, command %zu\n", msg, index);
+    }
+    sNumErrors++;
+}
+
+static void expect_cmd(uint32_t opArgs, uint32_t data) {
+    if (sNumExpected == sExpectedCapacity) {
+        sExpectedCapacity = (sExpectedCapacity == 0) ? 4096 : sExpectedCapacity * 2;
+        sExpected = realloc(sExpected, sExpectedCapacity * sizeof(AudioCmd));
+        if (sExpected == NULL) {
+            printf("out of memory\n");
+            exit(1);
+        }
+    }
+    sExpected[sNumExpected].opArgs = opArgs;
+    sExpected[sNumExpected].data = data;
+    sNumExpected++;
+}
+
+/*
+ * Message queue, as osSendMesg and osRecvMesg with OS_MESG_NOBLOCK
+ */
+
+static int send_mesg(uint32_t msg) {
+    if (gAudioCtx.msgCount == THREAD_CMD_PROC_MSG_COUNT) {
+        return -1;
+    }
+    gAudioCtx.threadCmdProcMsgBuf[(gAudioCtx.msgHead + gAudioCtx.msgCount) % THREAD_CMD_PROC_MSG_COUNT] = msg;
+    gAudioCtx.msgCount++;
+    return 0;
+}
+
+static int recv_mesg(uint32_t* msg) {
+    if (gAudioCtx.msgCount == 0) {
+        return -1;
+    }
+    *msg = gAudioCtx.threadCmdProcMsgBuf[gAudioCtx.msgHead];
+    gAudioCtx.msgHead = (gAudioCtx.msgHead + 1) % THREAD_CMD_PROC_MSG_COUNT;
+    gAudioCtx.msgCount--;
+    return 0;
+}
+
+static void run_audio_frame(void);
+
+#define PREEMPT()                                                     \
+    do {                                                              \
+        if (!sNoPreempt && ((next_rand() % 1024) < sPreemptRate)) {   \
+            run_audio_frame();                                        \
+        }                                                             \
+    } while (0)
+
+/*
+ * Graph thread
+ */
+
+static int get_cmd_coalesce_key(uint32_t opArgs) {
+    int op = (opArgs >> 24) & 0xFF;
+    int seqPlayerIndex = (opArgs >> 16) & 0xFF;
+    int channelIndex = (opArgs >> 8) & 0xFF;
+    int field;
+
+    switch (op) {
+        case AUDIOCMD_OP_CHANNEL_SET_VOL_SCALE:
+            field = 0;
+            break;
+
+        case AUDIOCMD_OP_CHANNEL_SET_VOL:
+            field = 1;
+            break;
+
+        case AUDIOCMD_OP_CHANNEL_SET_FREQ_SCALE:
+            field = 2;
+            break;
+
+        default:
+            return -1;
+    }
+
+    if ((seqPlayerIndex >= SEQ_PLAYER_MAX) || (channelIndex >= SEQ_NUM_CHANNELS)) {
+        return -1;
+    }
+
+    return (field * SEQ_PLAYER_MAX + seqPlayerIndex) * SEQ_NUM_CHANNELS + channelIndex;
+}
+
+static void clear_cmd_coalescing(void) {
+    while (sThreadCmdNumCoalesceKeys != 0) {
+        sThreadCmdCoalesceSlots[sThreadCmdCoalesceKeys[--sThreadCmdNumCoalesceKeys]] = 0;
+    }
+}
+
+/**
+ * Not preempted before the coalescing check, so that test_queue_cmd knows which slot is coalesced into
+ */
+static void queue_cmd(uint32_t opArgs, uint32_t* data) {
+    AudioCmd* cmd;
+    int key = get_cmd_coalesce_key(opArgs);
+    uint8_t numPending;
+    uint8_t slot;
+
+    if (key < 0) {
+        clear_cmd_coalescing();
+    } else {
+        slot = sThreadCmdCoalesceSlots[key];
+        if (slot != 0) {
+            PREEMPT();
+            gAudioCtx.threadCmdBuf[slot - 1].data = *data;
+            gAudioCmdQueueStats.coalesced++;
+            return;
+        }
+    }
+
+    PREEMPT();
+    if ((uint8_t)(gAudioCtx.threadCmdWritePos + 1) == sCurCmdRdPos) {
+        gAudioCmdQueueStats.dropped++;
+        return;
+    }
+
+    PREEMPT();
+    cmd = &gAudioCtx.threadCmdBuf[gAudioCtx.threadCmdWritePos & 0xFF];
+
+    cmd->opArgs = opArgs;
+    PREEMPT();
+    cmd->data = *data;
+
+    PREEMPT();
+    if (key >= 0) {
+        sThreadCmdCoalesceSlots[key] = (gAudioCtx.threadCmdWritePos & 0xFF) + 1;
+        PREEMPT();
+        sThreadCmdCoalesceKeys[sThreadCmdNumCoalesceKeys++] = key;
+    }
+
+    PREEMPT();
+    gAudioCtx.threadCmdWritePos++;
+
+    PREEMPT();
+    gAudioCmdQueueStats.queued++;
+    numPending = gAudioCtx.threadCmdWritePos - sCurCmdRdPos;
+    if (gAudioCmdQueueStats.maxPending < numPending) {
+        gAudioCmdQueueStats.maxPending = numPending;
+    }
+}
+
+static int schedule_process_cmds(void) {
+    int ret;
+
+    PREEMPT();
+    ret = send_mesg(((gAudioCtx.threadCmdReadPos & 0xFF) << 8) | (gAudioCtx.threadCmdWritePos & 0xFF));
+    PREEMPT();
+    if (ret != -1) {
+        gAudioCtx.threadCmdReadPos = gAudioCtx.threadCmdWritePos;
+        PREEMPT();
+        clear_cmd_coalescing();
+        ret = 0;
+    } else {
+        gAudioCmdQueueStats.publishFailures++;
+        return -1;
+    }
+
+    return ret;
+}
+
+static void reset_cmd_queue(void) {
+    gAudioCtx.threadCmdQueueFinished = false;
+    gAudioCtx.threadCmdReadPos = gAudioCtx.threadCmdWritePos;
+    clear_cmd_coalescing();
+}
+
+/*
+ * Audio thread
+ */
+
+static void process_cmd(AudioCmd* cmd) {
+    if (sNumFetched >= sNumExpected) {
+        report("processed a command that was not queued", sNumFetched);
+    } else if ((sExpected[sNumFetched].opArgs != cmd->opArgs) || (sExpected[sNumFetched].data != cmd->data)) {
+        report("processed a different command than was queued", sNumFetched);
+    }
+    sNumFetched++;
+    sNumProcessed++;
+}
+
+static void process_cmds(uint32_t msg) {
+    AudioCmd* cmd;
+    uint8_t endPos;
+
+    if (!gAudioCtx.threadCmdQueueFinished) {
+        sCurCmdRdPos = msg >> 8;
+    }
+
+    while (true) {
+        endPos = msg & 0xFF;
+        if (sCurCmdRdPos == endPos) {
+            gAudioCtx.threadCmdQueueFinished = false;
+            break;
+        }
+
+        cmd = &gAudioCtx.threadCmdBuf[sCurCmdRdPos++ & 0xFF];
+        if ((cmd->opArgs >> 24) == AUDIOCMD_OP_GLOBAL_STOP_AUDIOCMDS) {
+            gAudioCtx.threadCmdQueueFinished = true;
+            break;
+        }
+
+        process_cmd(cmd);
+        cmd->opArgs &= 0x00FFFFFF; // AUDIOCMD_OP_NOOP
+    }
+}
+
+static void run_audio_frame(void) {
+    uint32_t msg;
+    int j = 0;
+
+    sNoPreempt = true;
+    while (recv_mesg(&msg) != -1) {
+        if (!gAudioCtx.threadCmdQueueFinished) {
+            // Starts from the message's read position, past anything a reset left behind
+            sNumSkipped = 0;
+        }
+        process_cmds(msg);
+        if (gAudioCtx.threadCmdQueueFinished) {
+            if ((sNumFetched >= sNumExpected) ||
+                ((sExpected[sNumFetched].opArgs >> 24) != AUDIOCMD_OP_GLOBAL_STOP_AUDIOCMDS)) {
+                report("stopped without a stop command", sNumFetched);
+            }
+            sNumFetched++;
+        }
+        j++;
+    }
+    if ((j == 0) && gAudioCtx.threadCmdQueueFinished) {
+        schedule_process_cmds();
+    }
+    sNoPreempt = false;
+}
+
+/*
+ * Test driver
+ */
+
+static uint32_t sSerial;
+
+static size_t num_pending(void) {
+    return sNumExpected - sNumFetched + sNumSkipped;
+}
+
+static void check_pending(void) {
+    if ((uint8_t)(gAudioCtx.threadCmdWritePos - sCurCmdRdPos) != num_pending()) {
+        report("ring holds a different number of commands than were queued", sNumExpected);
+    }
+}
+
+static void test_queue_cmd(uint32_t opArgs) {
+    AudioCmdQueueStats prev = gAudioCmdQueueStats;
+    uint32_t data = ++sSerial;
+    int key = get_cmd_coalesce_key(opArgs);
+    uint8_t coalesceSlot = (key >= 0) ? sThreadCmdCoalesceSlots[key] : 0;
+    uint8_t writePos = gAudioCtx.threadCmdWritePos;
+    size_t index;
+    size_t i;
+
+    queue_cmd(opArgs, &data);
+
+    if (gAudioCmdQueueStats.coalesced != prev.coalesced) {
+        index = sSlotOwner[coalesceSlot - 1];
+        if ((index >= sNumExpected) || (sExpected[index].opArgs != opArgs)) {
+            report("coalesced into a command with a different op or args", sNumExpected);
+        } else {
+            for (i = index + 1; i < sNumExpected; i++) {
+                if (get_cmd_coalesce_key(sExpected[i].opArgs) < 0) {
+                    report("coalesced across a command that cannot be coalesced", i);
+                    break;
+                }
+            }
+            sExpected[index].data = data;
+        }
+    } else if (gAudioCmdQueueStats.dropped != prev.dropped) {
+        if (num_pending() != 0xFF) {
+            report("dropped a command with free slots in the ring", sNumExpected);
+        }
+    } else {
+        sSlotOwner[writePos] = sNumExpected;
+        expect_cmd(opArgs, data);
+    }
+    check_pending();
+}
+
+static void test_reset_cmd_queue(void) {
+    if (gAudioCtx.msgCount != 0) {
+        run_audio_frame();
+    }
+    reset_cmd_queue();
+    // Commands behind a stop and unpublished commands are never processed
+    sNumSkipped += sNumExpected - sNumFetched;
+    sNumExpected = sNumFetched;
+    check_pending();
+}
+
+static uint32_t random_cmd(void) {
+    static const uint8_t sCoalescibleOps[] = {
+        AUDIOCMD_OP_CHANNEL_SET_VOL_SCALE,
+        AUDIOCMD_OP_CHANNEL_SET_VOL,
+        AUDIOCMD_OP_CHANNEL_SET_FREQ_SCALE,
+    };
+    uint32_t r = next_rand() % 1000;
+    int seqPlayerIndex = next_rand() % SEQ_PLAYER_MAX;
+    // Few channels, so that commands coalesce often
+    int channelIndex = next_rand() % 4;
+
+    if (r < 600) {
+        if ((next_rand() % 16) == 0) {
+            channelIndex = AUDIOCMD_ALL_CHANNELS;
+        }
+        return AUDIO_MK_CMD(sCoalescibleOps[next_rand() % 3], seqPlayerIndex, channelIndex, 0);
+    }
+    if (r < 850) {
+        return AUDIO_MK_CMD(AUDIOCMD_OP_CHANNEL_SET_PAN, seqPlayerIndex, channelIndex, 0);
+    }
+    if (r < 997) {
+        return AUDIO_MK_CMD(AUDIOCMD_OP_SEQPLAYER_SET_TEMPO, seqPlayerIndex, 0, 0);
+    }
+    return AUDIO_MK_CMD(AUDIOCMD_OP_GLOBAL_STOP_AUDIOCMDS, 0, 0, 0);
+}
+
+static void print_usage(void) {
+    printf("Usage: cmdring [-n FRAMES] [-c CMDS] [-p RATE] [-s SEED]\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("-n FRAMES  graph thread frames to run (default 100000)\n");
+    printf("-c CMDS    most commands queued in a frame (default 300)\n");
+    printf("-p RATE    chance in 1024 of an audio frame at each preemption point (default 64)\n");
+    printf("-s SEED    random seed (default 1)\n");
+}
+
+int main(int argc, char** argv) {
+    int opt;
+    unsigned numFrames = 100000;
+    unsigned maxCmds = 300;
+    unsigned frame;
+    unsigned numCmds;
+    unsigned i;
+
+    while ((opt = getopt(argc, argv, "n:c:p:s:?")) != -1) {
+        switch (opt) {
+            case 'n':
+                numFrames = strtoul(optarg, NULL, 0);
+                break;
+            case 'c':
+                maxCmds = strtoul(optarg, NULL, 0);
+                break;
+            case 'p':
+                sPreemptRate = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                sRandState = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("cmdring version %s\n", CMDRING_VER);
+                print_usage();
+                return (opt == '?') ? 0 : 1;
+        }
+    }
+
+    for (frame = 0; frame < numFrames; frame++) {
+        numCmds = next_rand() % (maxCmds + 1);
+        for (i = 0; i < numCmds; i++) {
+            test_queue_cmd(random_cmd());
+        }
+        if ((next_rand() % 1000) == 0) {
+            test_reset_cmd_queue();
+        } else {
+            schedule_process_cmds();
+        }
+    }
+
+    // Let both threads run whole frames until everything queued is processed
+    for (i = 0; (i < 1000) && ((sNumFetched != sNumExpected) || (gAudioCtx.msgCount != 0)); i++) {
+        sNoPreempt = true;
+        schedule_process_cmds();
+        sNoPreempt = false;
+        run_audio_frame();
+    }
+    if (sNumFetched != sNumExpected) {
+        report("commands were never processed", sNumFetched);
+    }
+
+    printf("%u frames: %u queued, %u coalesced, %u dropped, %u publish failures, %u max pending\n", numFrames,
+           gAudioCmdQueueStats.queued, gAudioCmdQueueStats.coalesced, gAudioCmdQueueStats.dropped,
+           gAudioCmdQueueStats.publishFailures, gAudioCmdQueueStats.maxPending);
+    printf("%zu commands processed\n", sNumProcessed);
+    free(sExpected);
+
+    if (sNumErrors != 0) {
+        printf("FAILED: %u errors\n", sNumErrors);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,1382 @@
+/*
+ * jpegdecode: runs Jpeg_Decode with the IDCT and color conversion done on the CPU, and checks the image it writes.
+ *
+ * jpeg_decode, jpeg_parse_markers, jpeg_inverse_dct_block, jpeg_decode_mcu_on_cpu, jpeg_decode_on_cpu and
+ * jpeg_copy_to_zbuffer are copies of the Jpeg_ functions of the same names in src/code/z_jpeg.c. The jpeg_utils_ and
+ * jpeg_decoder_ functions are copies of the JpegUtils_ and JpegDecoder_ functions in src/code/jpegutils.c and
+ * src/code/jpegdecoder.c. All of them need to be kept in sync with the game's. jpeg_decode does not set up a message
+ * queue, and jpeg_schedule_decoder_task only counts the tasks that would have gone to the njpgdsp microcode.
+ *
+ * Random 320x240 images are encoded as baseline JPEGs with 16x16 MCUs (mode 2) at several qualities, with the standard
+ * tables in the layout Jpeg_Decode expects: two DQT and four DHT markers. Each image is decoded with jpeg_decode, and
+ * the result is compared with a reference decode of the quantized coefficients the encoder wrote, done in floating
+ * point. The integer IDCT and color conversion may round differently, so every 5-bit channel may differ by 1, but no
+ * more, and no more than 2% of the pixels may differ at all (about 1% do). A 320x120 image with 16x8 MCUs (mode 0)
+ * is then decoded to check that it goes to the microcode.
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define JPEGDECODE_VER "0.1"
+
+#define SCREEN_WIDTH 320
+#define SCREEN_HEIGHT 240
+
+#define MARKER_ESCAPE 0x00
+#define MARKER_SOI 0xD8
+#define MARKER_SOF 0xC0
+#define MARKER_DHT 0xC4
+#define MARKER_DQT 0xDB
+#define MARKER_DRI 0xDD
+#define MARKER_SOS 0xDA
+#define MARKER_APP0 0xE0
+#define MARKER_APP1 0xE1
+#define MARKER_APP2 0xE2
+#define MARKER_COM 0xFE
+#define MARKER_EOI 0xD9
+
+#define JPEG_IDCT_CONST_BITS 13
+#define JPEG_IDCT_PASS1_BITS 2
+#define JPEG_DESCALE(x, n) (((x) + (1 << ((n)-1))) >> (n))
+
+#define JPEG_HUFFMAN_LOOKAHEAD_BITS 8
+
+#define PI 3.14159265358979323846
+
+#define ARRAY_COUNT(arr) (int32_t)(sizeof(arr) / sizeof(arr[0]))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#define CLAMP(x, min, max) ((x) < (min) ? (min) : (x) > (max) ? (max) : (x))
+
+#define MAX_JPEG_SIZE 0x40000
+
+typedef struct {
+    uint16_t table[8 * 8];
+} JpegQuantizationTable;
+
+typedef struct {
+    uint8_t lengths[1 << JPEG_HUFFMAN_LOOKAHEAD_BITS];
+    uint8_t symbols[1 << JPEG_HUFFMAN_LOOKAHEAD_BITS];
+} JpegHuffmanLookup;
+
+typedef struct {
+    uint8_t codeOffs[16];
+    uint16_t codesA[16];
+    uint16_t codesB[16];
+    uint8_t* symbols;
+    JpegHuffmanLookup* lookup;
+} JpegHuffmanTable;
+
+typedef struct {
+    JpegQuantizationTable qTableY;
+    JpegQuantizationTable qTableU;
+    JpegQuantizationTable qTableV;
+    uint8_t codesLengths[0x110];
+    uint16_t codes[0x108];
+    uint16_t data[4][0x180];
+} JpegWork;
+
+typedef struct {
+    void* imageData;
+    uint8_t mode;
+    uint8_t unk_05;
+    JpegHuffmanTable* hTablePtrs[4];
+    uint8_t unk_18;
+} JpegDecoder;
+
+typedef struct {
+    uint8_t dqtCount;
+    uint8_t* dqtPtr[3];
+    uint8_t dhtCount;
+    uint8_t* dhtPtr[4];
+    void* imageData;
+    uint8_t mode;
+    JpegWork* workBuf;
+} JpegContext;
+
+typedef struct {
+    uint32_t byteIdx;
+    uint8_t bitIdx;
+    uint8_t dontSkip;
+    uint32_t curWord;
+    int16_t unk_0C;
+    int16_t unk_0E;
+    int16_t unk_10;
+} JpegDecoderState;
+
+static uint8_t sJpegZigZagToNatural[8 * 8] = {
+    0,  1,  8,  16, 9,  2,  3,  10, 17, 24, 32, 25, 18, 11, 4,  5,  12, 19, 26, 33, 40, 48,
+    41, 34, 27, 20, 13, 6,  7,  14, 21, 28, 35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23,
+    30, 37, 44, 51, 58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+};
+
+static JpegHuffmanLookup sJpegHuffmanLookups[4];
+static bool sJpegDecodeOnCpu = true;
+static unsigned sNumDecoderTasks;
+
+static uint8_t* sJpegBitStreamPtr;
+static uint32_t sJpegBitStreamByteIdx;
+static uint8_t sJpegBitStreamBitIdx;
+static uint8_t sJpegBitStreamDontSkip;
+static uint32_t sJpegBitStreamCurWord;
+
+/*
+ * jpegutils.c
+ */
+
+static void jpeg_utils_process_quantization_table(uint8_t* dqt, JpegQuantizationTable* qt, uint8_t count) {
+    uint8_t i;
+
+    for (i = 0; i < count; i++) {
+        uint8_t j;
+
+        dqt++;
+        for (j = 0; j < ARRAY_COUNT(qt[i].table); j++) {
+            qt[i].table[j] = *dqt++;
+        }
+    }
+}
+
+static int32_t jpeg_utils_parse_huffman_codes_lengths(uint8_t* ptr, uint8_t* codesLengths) {
+    uint8_t off = 1;
+    int16_t count = 0;
+    int16_t idx = 1;
+
+    while (off <= 16) {
+        while (idx <= ptr[off - 1]) {
+            codesLengths[count++] = off;
+            idx++;
+        }
+        idx = 1;
+        off++;
+    }
+
+    codesLengths[count] = 0;
+    return count;
+}
+
+static int32_t jpeg_utils_get_huffman_codes(uint8_t* codesLengths, uint16_t* codes) {
+    int16_t idx = 0;
+    uint16_t code = 0;
+    uint8_t lastLen = codesLengths[0];
+
+    while (true) {
+        while (true) {
+            codes[idx++] = code++;
+
+            if (codesLengths[idx] != lastLen) {
+                break;
+            }
+        }
+
+        if (codesLengths[idx] == 0) {
+            break;
+        }
+
+        while (true) {
+            if (code <<= 1, codesLengths[idx] == ++lastLen) {
+                break;
+            }
+        }
+    }
+
+    return idx;
+}
+
+static int32_t jpeg_utils_set_huffman_table(uint8_t* data, JpegHuffmanTable* ht, uint16_t* codes) {
+    uint8_t idx;
+    uint16_t codeOff = 0;
+
+    for (idx = 0; idx < 16; idx++) {
+        if (data[idx]) {
+            ht->codeOffs[idx] = codeOff;
+            ht->codesA[idx] = codes[codeOff];
+            codeOff += data[idx] - 1;
+            ht->codesB[idx] = codes[codeOff];
+            codeOff++;
+        } else {
+            ht->codesB[idx] = 0xFFFF;
+        }
+    }
+
+    return codeOff;
+}
+
+static uint32_t jpeg_utils_process_huffman_table_impl(uint8_t* data, JpegHuffmanTable* ht, uint8_t* codesLengths,
+                                                      uint16_t* codes, uint8_t isAc) {
+    int16_t ret;
+    int32_t count = jpeg_utils_parse_huffman_codes_lengths(data, codesLengths);
+    int32_t temp;
+
+    ret = count;
+    if ((count == 0) || (isAc && (count > 0x100)) || (!isAc && (count > 0x10))) {
+        return 0;
+    }
+    if (ret != jpeg_utils_get_huffman_codes(codesLengths, codes)) {
+        return 0;
+    }
+    if (temp = jpeg_utils_set_huffman_table(data, ht, codes), temp != ret) {
+        return 0;
+    }
+
+    return ret;
+}
+
+static uint32_t jpeg_utils_process_huffman_table(uint8_t* dht, JpegHuffmanTable* ht, uint8_t* codesLengths,
+                                                 uint16_t* codes, uint8_t count) {
+    uint8_t idx;
+    uint32_t codeCount;
+
+    for (idx = 0; idx < count; idx++) {
+        uint32_t ac = (*dht++ >> 4);
+
+        codeCount = jpeg_utils_process_huffman_table_impl(dht, &ht[idx], codesLengths, codes, ac);
+        if (codeCount == 0) {
+            return true;
+        }
+
+        dht += 16;
+        ht[idx].symbols = dht;
+        ht[idx].lookup = NULL;
+        dht += codeCount;
+    }
+    return false;
+}
+
+static void jpeg_utils_set_huffman_lookup(JpegHuffmanTable* ht, JpegHuffmanLookup* lookup) {
+    int32_t prefix;
+    int32_t codeIdx;
+    uint16_t codeOff;
+
+    for (prefix = 0; prefix < ARRAY_COUNT(lookup->lengths); prefix++) {
+        lookup->lengths[prefix] = 0;
+        lookup->symbols[prefix] = 0;
+
+        for (codeIdx = 0; codeIdx < JPEG_HUFFMAN_LOOKAHEAD_BITS; codeIdx++) {
+            if (ht->codesB[codeIdx] == 0xFFFF) {
+                continue;
+            }
+
+            codeOff = prefix >> (JPEG_HUFFMAN_LOOKAHEAD_BITS - 1 - codeIdx);
+            if (codeOff <= ht->codesB[codeIdx]) {
+                lookup->lengths[prefix] = codeIdx + 1;
+                lookup->symbols[prefix] = ht->symbols[ht->codeOffs[codeIdx] + codeOff - ht->codesA[codeIdx]];
+                break;
+            }
+        }
+    }
+
+    ht->lookup = lookup;
+}
+
+/*
+ * jpegdecoder.c
+ */
+
+static uint16_t jpeg_decoder_read_bits(uint8_t len) {
+    uint8_t byteCount;
+    uint8_t data;
+    int32_t ret;
+    uint32_t temp;
+    ret = 0;
+
+    for (byteCount = sJpegBitStreamBitIdx >> 3; byteCount > 0; byteCount--) {
+        data = sJpegBitStreamPtr[sJpegBitStreamByteIdx++];
+        if (sJpegBitStreamDontSkip) {
+            if (data == 0) {
+                data = sJpegBitStreamPtr[sJpegBitStreamByteIdx++];
+            }
+        }
+
+        sJpegBitStreamDontSkip = (data == 0xFF) ? true : false;
+
+        sJpegBitStreamCurWord <<= 8;
+        sJpegBitStreamCurWord |= data;
+        sJpegBitStreamBitIdx -= 8;
+    }
+
+    ret = (sJpegBitStreamCurWord << (sJpegBitStreamBitIdx));
+    temp = ret;
+    // The game shifts by -len, which the N64 takes modulo 32
+    ret = temp >> (32 - len);
+    sJpegBitStreamBitIdx += len;
+    return ret;
+}
+
+static int32_t jpeg_decoder_parse_next_symbol(JpegHuffmanTable* hTable, int16_t* outCoeff, int8_t* outZeroCount) {
+    uint8_t codeIdx;
+    uint8_t sym;
+    uint16_t codeOff = 0;
+    uint16_t buff = jpeg_decoder_read_bits(16);
+    uint8_t prefix = buff >> (16 - JPEG_HUFFMAN_LOOKAHEAD_BITS);
+
+    if ((hTable->lookup != NULL) && (hTable->lookup->lengths[prefix] != 0)) {
+        codeIdx = hTable->lookup->lengths[prefix] - 1;
+        sym = hTable->lookup->symbols[prefix];
+    } else {
+        for (codeIdx = 0; codeIdx < ARRAY_COUNT(hTable->codesB); codeIdx++) {
+            if (hTable->codesB[codeIdx] == 0xFFFF) {
+                continue;
+            }
+
+            codeOff = buff >> (15 - codeIdx);
+            if (codeOff <= hTable->codesB[codeIdx]) {
+                break;
+            }
+        }
+
+        if (codeIdx >= ARRAY_COUNT(hTable->codesB)) {
+            return true;
+        }
+
+        sym = hTable->symbols[hTable->codeOffs[codeIdx] + codeOff - hTable->codesA[codeIdx]];
+    }
+    *outZeroCount = sym >> 4;
+    sym &= 0xF;
+
+    sJpegBitStreamBitIdx += codeIdx - 15;
+    *outCoeff = 0;
+    if (sym) {
+        *outCoeff = jpeg_decoder_read_bits(sym);
+        if (*outCoeff < (1 << (sym - 1))) {
+            *outCoeff += (0xFFFFFFFF << sym) + 1;
+        }
+    }
+
+    return false;
+}
+
+static int32_t jpeg_decoder_process_mcu(JpegHuffmanTable* hTable0, JpegHuffmanTable* hTable1, uint16_t* mcu,
+                                        int16_t* unk) {
+    int8_t i = 0;
+    int8_t zeroCount;
+    int16_t coeff;
+
+    if (jpeg_decoder_parse_next_symbol(hTable0, &coeff, &zeroCount)) {
+        return true;
+    }
+
+    *unk += coeff;
+    mcu[i++] = *unk;
+    while (i < 8 * 8) {
+        if (jpeg_decoder_parse_next_symbol(hTable1, &coeff, &zeroCount)) {
+            return true;
+        }
+
+        if (coeff == 0) {
+            if (zeroCount == 0xF) {
+                while (zeroCount-- >= 0) {
+                    mcu[i++] = 0;
+                }
+            } else {
+                while (i < 8 * 8) {
+                    mcu[i++] = 0;
+                }
+                break;
+            }
+        } else {
+            while (0 < zeroCount--) {
+                mcu[i++] = 0;
+            }
+            mcu[i++] = coeff;
+        }
+    }
+
+    return false;
+}
+
+static int32_t jpeg_decoder_decode(JpegDecoder* decoder, uint16_t* mcuBuff, int32_t count, uint8_t isFollowing,
+                                   JpegDecoderState* state) {
+    int16_t unk0;
+    int16_t unk1;
+    int16_t unk2;
+    uint32_t idx;
+    int32_t inc;
+    uint16_t unkCount;
+
+    JpegHuffmanTable* hTable0;
+    JpegHuffmanTable* hTable1;
+    JpegHuffmanTable* hTable2;
+    JpegHuffmanTable* hTable3;
+
+    inc = 0;
+    sJpegBitStreamPtr = decoder->imageData;
+    if (decoder->mode == 0) {
+        unkCount = 2;
+    } else {
+        unkCount = 4;
+        if (decoder->unk_05 == 1) {
+            inc = 8 * 8 * 2;
+        }
+    }
+
+    hTable0 = decoder->hTablePtrs[0];
+    hTable1 = decoder->hTablePtrs[1];
+    hTable2 = decoder->hTablePtrs[2];
+    hTable3 = decoder->hTablePtrs[3];
+
+    if (!isFollowing) {
+        sJpegBitStreamByteIdx = 0;
+        sJpegBitStreamBitIdx = 32;
+        sJpegBitStreamCurWord = 0;
+        sJpegBitStreamDontSkip = 0;
+        unk0 = 0;
+        unk1 = 0;
+        unk2 = 0;
+    } else {
+        sJpegBitStreamByteIdx = state->byteIdx;
+        sJpegBitStreamBitIdx = state->bitIdx;
+        sJpegBitStreamCurWord = state->curWord;
+        sJpegBitStreamDontSkip = state->dontSkip;
+        unk0 = state->unk_0C;
+        unk1 = state->unk_0E;
+        unk2 = state->unk_10;
+    }
+
+    while (count != 0) {
+        for (idx = 0; idx < unkCount; idx++) {
+            if (jpeg_decoder_process_mcu(hTable0, hTable1, mcuBuff, &unk0)) {
+                return 2;
+            }
+            mcuBuff += 8 * 8;
+        }
+
+        if (jpeg_decoder_process_mcu(hTable2, hTable3, mcuBuff, &unk1)) {
+            return 2;
+        }
+        mcuBuff += 8 * 8;
+
+        if (jpeg_decoder_process_mcu(hTable2, hTable3, mcuBuff, &unk2)) {
+            return 2;
+        }
+
+        count--;
+        mcuBuff += 8 * 8;
+        mcuBuff += inc;
+    }
+
+    state->byteIdx = sJpegBitStreamByteIdx;
+    state->bitIdx = sJpegBitStreamBitIdx;
+    state->curWord = sJpegBitStreamCurWord;
+    state->dontSkip = sJpegBitStreamDontSkip;
+    state->unk_0C = unk0;
+    state->unk_0E = unk1;
+    state->unk_10 = unk2;
+    return 0;
+}
+
+/*
+ * z_jpeg.c
+ */
+
+static void jpeg_schedule_decoder_task(JpegContext* jpegCtx) {
+    (void)jpegCtx;
+    sNumDecoderTasks++;
+}
+
+static void jpeg_inverse_dct_block(uint16_t* coeffs, JpegQuantizationTable* qTable, uint8_t* out, int32_t outStride) {
+    int32_t block[8 * 8];
+    int32_t* ptr;
+    int32_t tmp0;
+    int32_t tmp1;
+    int32_t tmp2;
+    int32_t tmp3;
+    int32_t tmp10;
+    int32_t tmp11;
+    int32_t tmp12;
+    int32_t tmp13;
+    int32_t z1;
+    int32_t z2;
+    int32_t z3;
+    int32_t z4;
+    int32_t z5;
+    int32_t i;
+    int32_t j;
+
+    for (i = 0; i < ARRAY_COUNT(block); i++) {
+        block[i] = 0;
+    }
+    for (i = 0; i < ARRAY_COUNT(block); i++) {
+        block[sJpegZigZagToNatural[i]] = (int16_t)coeffs[i] * qTable->table[i];
+    }
+
+    // Columns
+    for (i = 0; i < 8; i++) {
+        ptr = &block[i];
+
+        if ((ptr[8 * 1] | ptr[8 * 2] | ptr[8 * 3] | ptr[8 * 4] | ptr[8 * 5] | ptr[8 * 6] | ptr[8 * 7]) == 0) {
+            tmp0 = ptr[0] << JPEG_IDCT_PASS1_BITS;
+            for (j = 0; j < 8; j++) {
+                ptr[8 * j] = tmp0;
+            }
+            continue;
+        }
+
+        z2 = ptr[8 * 2];
+        z3 = ptr[8 * 6];
+        z1 = (z2 + z3) * 4433;
+        tmp2 = z1 + z3 * -15137;
+        tmp3 = z1 + z2 * 6270;
+
+        tmp0 = (ptr[8 * 0] + ptr[8 * 4]) << JPEG_IDCT_CONST_BITS;
+        tmp1 = (ptr[8 * 0] - ptr[8 * 4]) << JPEG_IDCT_CONST_BITS;
+
+        tmp10 = tmp0 + tmp3;
+        tmp13 = tmp0 - tmp3;
+        tmp11 = tmp1 + tmp2;
+        tmp12 = tmp1 - tmp2;
+
+        tmp0 = ptr[8 * 7];
+        tmp1 = ptr[8 * 5];
+        tmp2 = ptr[8 * 3];
+        tmp3 = ptr[8 * 1];
+
+        z1 = tmp0 + tmp3;
+        z2 = tmp1 + tmp2;
+        z3 = tmp0 + tmp2;
+        z4 = tmp1 + tmp3;
+        z5 = (z3 + z4) * 9633;
+
+        tmp0 *= 2446;
+        tmp1 *= 16819;
+        tmp2 *= 25172;
+        tmp3 *= 12299;
+        z1 *= -7373;
+        z2 *= -20995;
+        z3 = z3 * -16069 + z5;
+        z4 = z4 * -3196 + z5;
+
+        tmp0 += z1 + z3;
+        tmp1 += z2 + z4;
+        tmp2 += z2 + z3;
+        tmp3 += z1 + z4;
+
+        ptr[8 * 0] = JPEG_DESCALE(tmp10 + tmp3, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 7] = JPEG_DESCALE(tmp10 - tmp3, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 1] = JPEG_DESCALE(tmp11 + tmp2, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 6] = JPEG_DESCALE(tmp11 - tmp2, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 2] = JPEG_DESCALE(tmp12 + tmp1, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 5] = JPEG_DESCALE(tmp12 - tmp1, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 3] = JPEG_DESCALE(tmp13 + tmp0, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+        ptr[8 * 4] = JPEG_DESCALE(tmp13 - tmp0, JPEG_IDCT_CONST_BITS - JPEG_IDCT_PASS1_BITS);
+    }
+
+    // Rows
+    for (i = 0; i < 8; i++) {
+        ptr = &block[8 * i];
+
+        if ((ptr[1] | ptr[2] | ptr[3] | ptr[4] | ptr[5] | ptr[6] | ptr[7]) == 0) {
+            tmp0 = JPEG_DESCALE(ptr[0], JPEG_IDCT_PASS1_BITS + 3) + 128;
+            tmp0 = CLAMP(tmp0, 0, 255);
+            for (j = 0; j < 8; j++) {
+                out[j] = tmp0;
+            }
+            out += outStride;
+            continue;
+        }
+
+        z2 = ptr[2];
+        z3 = ptr[6];
+        z1 = (z2 + z3) * 4433;
+        tmp2 = z1 + z3 * -15137;
+        tmp3 = z1 + z2 * 6270;
+
+        tmp0 = (ptr[0] + ptr[4]) << JPEG_IDCT_CONST_BITS;
+        tmp1 = (ptr[0] - ptr[4]) << JPEG_IDCT_CONST_BITS;
+
+        tmp10 = tmp0 + tmp3;
+        tmp13 = tmp0 - tmp3;
+        tmp11 = tmp1 + tmp2;
+        tmp12 = tmp1 - tmp2;
+
+        tmp0 = ptr[7];
+        tmp1 = ptr[5];
+        tmp2 = ptr[3];
+        tmp3 = ptr[1];
+
+        z1 = tmp0 + tmp3;
+        z2 = tmp1 + tmp2;
+        z3 = tmp0 + tmp2;
+        z4 = tmp1 + tmp3;
+        z5 = (z3 + z4) * 9633;
+
+        tmp0 *= 2446;
+        tmp1 *= 16819;
+        tmp2 *= 25172;
+        tmp3 *= 12299;
+        z1 *= -7373;
+        z2 *= -20995;
+        z3 = z3 * -16069 + z5;
+        z4 = z4 * -3196 + z5;
+
+        tmp0 += z1 + z3;
+        tmp1 += z2 + z4;
+        tmp2 += z2 + z3;
+        tmp3 += z1 + z4;
+
+        ptr[0] = tmp10 + tmp3;
+        ptr[7] = tmp10 - tmp3;
+        ptr[1] = tmp11 + tmp2;
+        ptr[6] = tmp11 - tmp2;
+        ptr[2] = tmp12 + tmp1;
+        ptr[5] = tmp12 - tmp1;
+        ptr[3] = tmp13 + tmp0;
+        ptr[4] = tmp13 - tmp0;
+
+        for (j = 0; j < 8; j++) {
+            tmp0 = JPEG_DESCALE(ptr[j], JPEG_IDCT_CONST_BITS + JPEG_IDCT_PASS1_BITS + 3) + 128;
+            out[j] = CLAMP(tmp0, 0, 255);
+        }
+        out += outStride;
+    }
+}
+
+static void jpeg_decode_mcu_on_cpu(uint16_t* mcu, JpegWork* workBuf) {
+    uint8_t lum[16 * 16];
+    uint8_t cb[8 * 8];
+    uint8_t cr[8 * 8];
+    int32_t i;
+    int32_t x;
+    int32_t y;
+    int32_t lumVal;
+    int32_t cbVal;
+    int32_t crVal;
+    int32_t r;
+    int32_t g;
+    int32_t b;
+
+    for (i = 0; i < 4; i++) {
+        jpeg_inverse_dct_block(&mcu[i * 8 * 8], &workBuf->qTableY, &lum[(i >> 1) * 8 * 16 + (i & 1) * 8], 16);
+    }
+    jpeg_inverse_dct_block(&mcu[4 * 8 * 8], &workBuf->qTableU, cb, 8);
+    jpeg_inverse_dct_block(&mcu[5 * 8 * 8], &workBuf->qTableV, cr, 8);
+
+    for (y = 0; y < 16; y++) {
+        for (x = 0; x < 16; x++) {
+            lumVal = lum[y * 16 + x];
+            i = (y >> 1) * 8 + (x >> 1);
+            cbVal = cb[i] - 128;
+            crVal = cr[i] - 128;
+
+            r = lumVal + ((91881 * crVal + (1 << 15)) >> 16);
+            g = lumVal + ((-22554 * cbVal - 46802 * crVal + (1 << 15)) >> 16);
+            b = lumVal + ((116130 * cbVal + (1 << 15)) >> 16);
+            r = CLAMP(r, 0, 255);
+            g = CLAMP(g, 0, 255);
+            b = CLAMP(b, 0, 255);
+
+            mcu[y * 16 + x] = ((r >> 3) << 11) | ((g >> 3) << 6) | ((b >> 3) << 1) | 1;
+        }
+    }
+}
+
+static void jpeg_decode_on_cpu(JpegContext* jpegCtx) {
+    JpegWork* workBuf = jpegCtx->workBuf;
+    int32_t i;
+
+    for (i = 0; i < ARRAY_COUNT(workBuf->data); i++) {
+        jpeg_decode_mcu_on_cpu(workBuf->data[i], workBuf);
+    }
+}
+
+static void jpeg_copy_to_zbuffer(uint16_t* src, uint16_t* zbuffer, int32_t x, int32_t y) {
+    uint16_t* dst = zbuffer + (((y * SCREEN_WIDTH) + x) * 16);
+    int32_t i;
+
+    for (i = 0; i < 16; i++) {
+        memcpy(dst, src, 16 * sizeof(uint16_t));
+        src += 16;
+        dst += SCREEN_WIDTH;
+    }
+}
+
+static uint16_t jpeg_get_unaligned_u16(uint8_t* ptr) {
+    return (ptr[0] << 8) | ptr[1];
+}
+
+static void jpeg_parse_markers(uint8_t* ptr, JpegContext* jpegCtx) {
+    uint32_t exit = false;
+
+    jpegCtx->dqtCount = 0;
+    jpegCtx->dhtCount = 0;
+
+    while (true) {
+        if (exit) {
+            break;
+        }
+
+        if (*ptr++ == 0xFF) {
+            switch (*ptr++) {
+                case MARKER_ESCAPE:
+                case MARKER_SOI:
+                    break;
+
+                case MARKER_DQT:
+                    jpegCtx->dqtPtr[jpegCtx->dqtCount++] = ptr + 2;
+                    ptr += jpeg_get_unaligned_u16(ptr);
+                    break;
+
+                case MARKER_DHT:
+                    jpegCtx->dhtPtr[jpegCtx->dhtCount++] = ptr + 2;
+                    ptr += jpeg_get_unaligned_u16(ptr);
+                    break;
+
+                case MARKER_SOF:
+                    if (ptr[9] == 0x21) {
+                        jpegCtx->mode = 0;
+                    } else if (ptr[9] == 0x22) {
+                        jpegCtx->mode = 2;
+                    }
+                    ptr += jpeg_get_unaligned_u16(ptr);
+                    break;
+
+                case MARKER_SOS:
+                    ptr += jpeg_get_unaligned_u16(ptr);
+                    jpegCtx->imageData = ptr;
+                    break;
+
+                case MARKER_EOI:
+                    exit = true;
+                    break;
+
+                default:
+                    // APP0, APP1, APP2, DRI and any other marker
+                    ptr += jpeg_get_unaligned_u16(ptr);
+                    break;
+            }
+        }
+    }
+}
+
+static int32_t jpeg_decode(void* data, void* zbuffer, void* work, uint32_t workSize) {
+    int32_t y;
+    int32_t x;
+    int32_t j;
+    int32_t i;
+    // Zeroed so that the host compiler does not warn, the game leaves them uninitialized
+    JpegContext jpegCtx = { 0 };
+    JpegHuffmanTable hTables[4];
+    JpegDecoder decoder;
+    JpegDecoderState state = { 0 };
+    JpegWork* workBuff = work;
+
+    if (workSize < sizeof(JpegWork)) {
+        return -1;
+    }
+
+    jpegCtx.workBuf = workBuff;
+
+    jpeg_parse_markers(data, &jpegCtx);
+
+    switch (jpegCtx.dqtCount) {
+        case 1:
+            jpeg_utils_process_quantization_table(jpegCtx.dqtPtr[0], &workBuff->qTableY, 3);
+            break;
+
+        case 2:
+            jpeg_utils_process_quantization_table(jpegCtx.dqtPtr[0], &workBuff->qTableY, 1);
+            jpeg_utils_process_quantization_table(jpegCtx.dqtPtr[1], &workBuff->qTableU, 1);
+            jpeg_utils_process_quantization_table(jpegCtx.dqtPtr[1], &workBuff->qTableV, 1);
+            break;
+
+        case 3:
+            jpeg_utils_process_quantization_table(jpegCtx.dqtPtr[0], &workBuff->qTableY, 1);
+            jpeg_utils_process_quantization_table(jpegCtx.dqtPtr[1], &workBuff->qTableU, 1);
+            jpeg_utils_process_quantization_table(jpegCtx.dqtPtr[2], &workBuff->qTableV, 1);
+            break;
+
+        default:
+            return -1;
+    }
+
+    switch (jpegCtx.dhtCount) {
+        case 1:
+            if (jpeg_utils_process_huffman_table(jpegCtx.dhtPtr[0], &hTables[0], workBuff->codesLengths,
+                                                 workBuff->codes, 4)) {
+                return -1;
+            }
+            break;
+
+        case 4:
+            if (jpeg_utils_process_huffman_table(jpegCtx.dhtPtr[0], &hTables[0], workBuff->codesLengths,
+                                                 workBuff->codes, 1)) {
+            } else if (jpeg_utils_process_huffman_table(jpegCtx.dhtPtr[1], &hTables[1], workBuff->codesLengths,
+                                                        workBuff->codes, 1)) {
+            } else if (jpeg_utils_process_huffman_table(jpegCtx.dhtPtr[2], &hTables[2], workBuff->codesLengths,
+                                                        workBuff->codes, 1)) {
+            } else if (!jpeg_utils_process_huffman_table(jpegCtx.dhtPtr[3], &hTables[3], workBuff->codesLengths,
+                                                         workBuff->codes, 1)) {
+                break;
+            }
+            return -1;
+
+        default:
+            return -1;
+    }
+
+    for (i = 0; i < ARRAY_COUNT(hTables); i++) {
+        jpeg_utils_set_huffman_lookup(&hTables[i], &sJpegHuffmanLookups[i]);
+    }
+
+    decoder.imageData = jpegCtx.imageData;
+    decoder.mode = jpegCtx.mode;
+    decoder.unk_05 = 2;
+
+    decoder.hTablePtrs[0] = &hTables[0];
+    decoder.hTablePtrs[1] = &hTables[1];
+    decoder.hTablePtrs[2] = &hTables[2];
+    decoder.hTablePtrs[3] = &hTables[3];
+    decoder.unk_18 = 0;
+
+    x = y = 0;
+    for (i = 0; i < 300; i += 4) {
+        if (!jpeg_decoder_decode(&decoder, (uint16_t*)workBuff->data, 4, (i != 0), &state)) {
+            if (sJpegDecodeOnCpu && (jpegCtx.mode == 2)) {
+                jpeg_decode_on_cpu(&jpegCtx);
+            } else {
+                jpeg_schedule_decoder_task(&jpegCtx);
+            }
+
+            for (j = 0; j < 4; j++) {
+                jpeg_copy_to_zbuffer(workBuff->data[j], zbuffer, x, y);
+                x++;
+
+                if (x >= 20) {
+                    x = 0;
+                    y++;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Baseline JPEG encoder, with the example tables of the JPEG standard
+ */
+
+static const uint8_t sLumQuant[8 * 8] = {
+    16, 11, 10, 16, 24,  40,  51,  61,  12, 12, 14, 19, 26,  58,  60,  55,  14, 13, 16, 24, 40,  57,
+    69, 56, 14, 17, 22,  29,  51,  87,  80, 62, 18, 22, 37,  56,  68,  109, 103, 77, 24, 35, 55, 64,
+    81, 104, 113, 92, 49, 64, 78,  87,  103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99,
+};
+
+static const uint8_t sChromaQuant[8 * 8] = {
+    17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99, 24, 26, 56, 99, 99, 99,
+    99, 99, 47, 66, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+};
+
+static const uint8_t sLumDcBits[16] = { 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 };
+static const uint8_t sChromaDcBits[16] = { 0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0 };
+static const uint8_t sDcSymbols[12] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+
+static const uint8_t sLumAcBits[16] = { 0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7D };
+static const uint8_t sLumAcSymbols[162] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71,
+    0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0, 0x24, 0x33, 0x62, 0x72,
+    0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x34, 0x35, 0x36, 0x37,
+    0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+    0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83,
+    0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3,
+    0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3,
+    0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE1, 0xE2,
+    0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA,
+};
+
+static const uint8_t sChromaAcBits[16] = { 0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77 };
+static const uint8_t sChromaAcSymbols[162] = {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22,
+    0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0, 0x15, 0x62, 0x72, 0xD1,
+    0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
+    0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A,
+    0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A,
+    0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA,
+    0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA,
+    0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA,
+};
+
+typedef struct {
+    uint16_t codes[256];
+    uint8_t lengths[256];
+} HuffmanEncoder;
+
+typedef struct {
+    uint8_t* buf;
+    uint32_t size;
+    uint32_t bits;
+    int32_t numBits;
+} BitWriter;
+
+/* Image being encoded, as 8-bit samples with chroma subsampled to the MCU's layout */
+typedef struct {
+    int32_t mcuHeight; // 8 for mode 0, 16 for mode 2
+    int32_t height;
+    uint8_t y[SCREEN_HEIGHT][SCREEN_WIDTH];
+    uint8_t cb[SCREEN_HEIGHT][SCREEN_WIDTH / 2];
+    uint8_t cr[SCREEN_HEIGHT][SCREEN_WIDTH / 2];
+    uint8_t qTables[2][8 * 8];                                  // zigzag order
+    int16_t coeffs[3][SCREEN_HEIGHT / 8][SCREEN_WIDTH / 8][8 * 8]; // quantized, zigzag order
+} EncodedImage;
+
+static HuffmanEncoder sEncoders[4];
+static double sCosTable[8][8];
+
+static uint32_t sRandState = 1;
+
+static uint32_t next_rand(void) {
+    sRandState = sRandState * 1664525 + 1013904223;
+    return sRandState >> 8;
+}
+
+static void init_encoder(HuffmanEncoder* enc, const uint8_t* bits, const uint8_t* symbols) {
+    uint16_t code = 0;
+    int32_t k = 0;
+    int32_t len;
+    int32_t i;
+
+    memset(enc, 0, sizeof(*enc));
+    for (len = 1; len <= 16; len++) {
+        for (i = 0; i < bits[len - 1]; i++) {
+            enc->codes[symbols[k]] = code++;
+            enc->lengths[symbols[k]] = len;
+            k++;
+        }
+        code <<= 1;
+    }
+}
+
+static void put_byte(BitWriter* bw, uint8_t byte) {
+    if (bw->size < MAX_JPEG_SIZE) {
+        bw->buf[bw->size++] = byte;
+    }
+}
+
+static void put_u16(BitWriter* bw, uint16_t val) {
+    put_byte(bw, val >> 8);
+    put_byte(bw, val & 0xFF);
+}
+
+static void put_bits(BitWriter* bw, uint32_t val, int32_t len) {
+    bw->bits = (bw->bits << len) | (val & ((1 << len) - 1));
+    bw->numBits += len;
+    while (bw->numBits >= 8) {
+        bw->numBits -= 8;
+        put_byte(bw, bw->bits >> bw->numBits);
+        if (((bw->bits >> bw->numBits) & 0xFF) == 0xFF) {
+            put_byte(bw, 0x00);
+        }
+    }
+}
+
+static void put_dht(BitWriter* bw, uint8_t tableClass, const uint8_t* bits, const uint8_t* symbols, int32_t count) {
+    int32_t i;
+
+    put_byte(bw, 0xFF);
+    put_byte(bw, MARKER_DHT);
+    put_u16(bw, 2 + 1 + 16 + count);
+    put_byte(bw, tableClass);
+    for (i = 0; i < 16; i++) {
+        put_byte(bw, bits[i]);
+    }
+    for (i = 0; i < count; i++) {
+        put_byte(bw, symbols[i]);
+    }
+}
+
+/**
+ * Returns the number of bits needed for `val`, and its JPEG encoding in those bits in `out`
+ */
+static int32_t get_magnitude(int32_t val, uint32_t* out) {
+    int32_t size = 0;
+    int32_t mag = (val < 0) ? -val : val;
+
+    while (mag != 0) {
+        size++;
+        mag >>= 1;
+    }
+    *out = (val < 0) ? (uint32_t)(val - 1) : (uint32_t)val;
+    return size;
+}
+
+static void encode_block(BitWriter* bw, int16_t* coeffs, int16_t* prevDc, HuffmanEncoder* dcEnc,
+                         HuffmanEncoder* acEnc) {
+    uint32_t bits;
+    int32_t size;
+    int32_t run = 0;
+    int32_t i;
+
+    size = get_magnitude(coeffs[0] - *prevDc, &bits);
+    *prevDc = coeffs[0];
+    put_bits(bw, dcEnc->codes[size], dcEnc->lengths[size]);
+    put_bits(bw, bits, size);
+
+    for (i = 1; i < 8 * 8; i++) {
+        if (coeffs[i] == 0) {
+            run++;
+            continue;
+        }
+        while (run > 15) {
+            put_bits(bw, acEnc->codes[0xF0], acEnc->lengths[0xF0]);
+            run -= 16;
+        }
+        size = get_magnitude(coeffs[i], &bits);
+        put_bits(bw, acEnc->codes[(run << 4) | size], acEnc->lengths[(run << 4) | size]);
+        put_bits(bw, bits, size);
+        run = 0;
+    }
+    if (run != 0) {
+        put_bits(bw, acEnc->codes[0x00], acEnc->lengths[0x00]);
+    }
+}
+
+/**
+ * Transforms and quantizes the 8x8 block of `plane` at (`bx`, `by`) into zigzag ordered coefficients
+ */
+static void forward_dct_block(uint8_t* plane, int32_t stride, int32_t bx, int32_t by, const uint8_t* qTable,
+                              int16_t* out) {
+    double sum;
+    double q;
+    int32_t u;
+    int32_t v;
+    int32_t x;
+    int32_t y;
+    int32_t i;
+
+    for (i = 0; i < 8 * 8; i++) {
+        u = sJpegZigZagToNatural[i] % 8;
+        v = sJpegZigZagToNatural[i] / 8;
+        sum = 0.0;
+        for (y = 0; y < 8; y++) {
+            for (x = 0; x < 8; x++) {
+                sum += (plane[(by * 8 + y) * stride + bx * 8 + x] - 128) * sCosTable[x][u] * sCosTable[y][v];
+            }
+        }
+        q = sum / 4.0 / qTable[i];
+        out[i] = (int16_t)((q < 0.0) ? -floor(-q + 0.5) : floor(q + 0.5));
+    }
+}
+
+static void fill_image(EncodedImage* image, int32_t mcuHeight) {
+    int32_t noise = 8 + next_rand() % 120;
+    int32_t period = 4 + next_rand() % 60;
+    int32_t r;
+    int32_t g;
+    int32_t b;
+    int32_t x;
+    int32_t y;
+
+    image->mcuHeight = mcuHeight;
+    image->height = 15 * mcuHeight;
+    for (y = 0; y < image->height; y++) {
+        for (x = 0; x < SCREEN_WIDTH; x++) {
+            // Gradients and a checkerboard with sharp edges, plus noise
+            r = (x + next_rand() % noise) & 0xFF;
+            g = (y * 2 + next_rand() % noise) & 0xFF;
+            b = ((x ^ y) + next_rand() % noise) & 0xFF;
+            if ((((x / period) + (y / period)) % 2) != 0) {
+                r = 255 - r;
+                b = next_rand() % noise;
+            }
+            image->y[y][x] = CLAMP((int32_t)floor(0.299 * r + 0.587 * g + 0.114 * b + 0.5), 0, 255);
+        }
+    }
+    for (y = 0; y < image->height / (mcuHeight / 8); y++) {
+        for (x = 0; x < SCREEN_WIDTH / 2; x++) {
+            image->cb[y][x] = next_rand() % 256;
+            image->cr[y][x] = 128 + (int32_t)((x + y) % period) - period / 2;
+        }
+    }
+}
+
+/**
+ * Encodes `image` at `quality` (1 to 100) into `buf`, returns the size of the encoded file
+ */
+static uint32_t encode_image(EncodedImage* image, int32_t quality, uint8_t* buf) {
+    static const uint8_t* sQuants[2] = { sLumQuant, sChromaQuant };
+    BitWriter bw = { buf, 0, 0, 0 };
+    int32_t scale = (quality < 50) ? (5000 / quality) : (200 - 2 * quality);
+    int32_t numLumRows = image->mcuHeight / 8;
+    int16_t prevDc[3] = { 0, 0, 0 };
+    int32_t mx;
+    int32_t my;
+    int32_t t;
+    int32_t i;
+    int32_t j;
+
+    for (t = 0; t < 2; t++) {
+        for (i = 0; i < 8 * 8; i++) {
+            j = (sQuants[t][sJpegZigZagToNatural[i]] * scale + 50) / 100;
+            image->qTables[t][i] = CLAMP(j, 1, 255);
+        }
+    }
+
+    put_byte(&bw, 0xFF);
+    put_byte(&bw, MARKER_SOI);
+
+    for (t = 0; t < 2; t++) {
+        put_byte(&bw, 0xFF);
+        put_byte(&bw, MARKER_DQT);
+        put_u16(&bw, 2 + 1 + 8 * 8);
+        put_byte(&bw, t);
+        for (i = 0; i < 8 * 8; i++) {
+            put_byte(&bw, image->qTables[t][i]);
+        }
+    }
+
+    put_byte(&bw, 0xFF);
+    put_byte(&bw, MARKER_SOF);
+    put_u16(&bw, 8 + 3 * 3);
+    put_byte(&bw, 8);
+    put_u16(&bw, image->height);
+    put_u16(&bw, SCREEN_WIDTH);
+    put_byte(&bw, 3);
+    put_byte(&bw, 1);
+    put_byte(&bw, 0x20 | numLumRows);
+    put_byte(&bw, 0);
+    put_byte(&bw, 2);
+    put_byte(&bw, 0x11);
+    put_byte(&bw, 1);
+    put_byte(&bw, 3);
+    put_byte(&bw, 0x11);
+    put_byte(&bw, 1);
+
+    put_dht(&bw, 0x00, sLumDcBits, sDcSymbols, ARRAY_COUNT(sDcSymbols));
+    put_dht(&bw, 0x10, sLumAcBits, sLumAcSymbols, ARRAY_COUNT(sLumAcSymbols));
+    put_dht(&bw, 0x01, sChromaDcBits, sDcSymbols, ARRAY_COUNT(sDcSymbols));
+    put_dht(&bw, 0x11, sChromaAcBits, sChromaAcSymbols, ARRAY_COUNT(sChromaAcSymbols));
+
+    put_byte(&bw, 0xFF);
+    put_byte(&bw, MARKER_SOS);
+    put_u16(&bw, 6 + 2 * 3);
+    put_byte(&bw, 3);
+    put_byte(&bw, 1);
+    put_byte(&bw, 0x00);
+    put_byte(&bw, 2);
+    put_byte(&bw, 0x11);
+    put_byte(&bw, 3);
+    put_byte(&bw, 0x11);
+    put_byte(&bw, 0);
+    put_byte(&bw, 63);
+    put_byte(&bw, 0);
+
+    for (my = 0; my < 15; my++) {
+        for (mx = 0; mx < SCREEN_WIDTH / 16; mx++) {
+            for (i = 0; i < 2 * numLumRows; i++) {
+                int16_t* coeffs = image->coeffs[0][my * numLumRows + i / 2][mx * 2 + i % 2];
+
+                forward_dct_block(&image->y[0][0], SCREEN_WIDTH, mx * 2 + i % 2, my * numLumRows + i / 2,
+                                  image->qTables[0], coeffs);
+                encode_block(&bw, coeffs, &prevDc[0], &sEncoders[0], &sEncoders[1]);
+            }
+            forward_dct_block(&image->cb[0][0], SCREEN_WIDTH / 2, mx, my, image->qTables[1], image->coeffs[1][my][mx]);
+            encode_block(&bw, image->coeffs[1][my][mx], &prevDc[1], &sEncoders[2], &sEncoders[3]);
+            forward_dct_block(&image->cr[0][0], SCREEN_WIDTH / 2, mx, my, image->qTables[1], image->coeffs[2][my][mx]);
+            encode_block(&bw, image->coeffs[2][my][mx], &prevDc[2], &sEncoders[2], &sEncoders[3]);
+        }
+    }
+    // Pad the last byte with 1 bits
+    put_bits(&bw, 0x7F, 7);
+
+    put_byte(&bw, 0xFF);
+    put_byte(&bw, MARKER_EOI);
+    return bw.size;
+}
+
+/*
+ * Reference decode
+ */
+
+static void reference_idct_block(int16_t* coeffs, uint8_t* qTable, uint8_t* out, int32_t outStride) {
+    double block[8 * 8] = { 0 };
+    double sum;
+    int32_t x;
+    int32_t y;
+    int32_t i;
+    int32_t val;
+
+    for (i = 0; i < 8 * 8; i++) {
+        block[sJpegZigZagToNatural[i]] = coeffs[i] * qTable[i];
+    }
+    for (y = 0; y < 8; y++) {
+        for (x = 0; x < 8; x++) {
+            sum = 0.0;
+            for (i = 0; i < 8 * 8; i++) {
+                sum += block[i] * sCosTable[x][i % 8] * sCosTable[y][i / 8];
+            }
+            val = (int32_t)floor(sum / 4.0 + 128.5);
+            out[y * outStride + x] = CLAMP(val, 0, 255);
+        }
+    }
+}
+
+/**
+ * Decodes the coefficients of `image` into RGBA16 with a floating point IDCT and JFIF color conversion
+ */
+static void reference_decode(EncodedImage* image, uint16_t* out) {
+    static uint8_t sLum[SCREEN_HEIGHT][SCREEN_WIDTH];
+    static uint8_t sCb[SCREEN_HEIGHT / 2][SCREEN_WIDTH / 2];
+    static uint8_t sCr[SCREEN_HEIGHT / 2][SCREEN_WIDTH / 2];
+    int32_t lumVal;
+    int32_t cbVal;
+    int32_t crVal;
+    int32_t r;
+    int32_t g;
+    int32_t b;
+    int32_t x;
+    int32_t y;
+
+    for (y = 0; y < image->height / 8; y++) {
+        for (x = 0; x < SCREEN_WIDTH / 8; x++) {
+            reference_idct_block(image->coeffs[0][y][x], image->qTables[0], &sLum[y * 8][x * 8], SCREEN_WIDTH);
+        }
+    }
+    for (y = 0; y < 15; y++) {
+        for (x = 0; x < SCREEN_WIDTH / 16; x++) {
+            reference_idct_block(image->coeffs[1][y][x], image->qTables[1], &sCb[y * 8][x * 8], SCREEN_WIDTH / 2);
+            reference_idct_block(image->coeffs[2][y][x], image->qTables[1], &sCr[y * 8][x * 8], SCREEN_WIDTH / 2);
+        }
+    }
+
+    for (y = 0; y < image->height; y++) {
+        for (x = 0; x < SCREEN_WIDTH; x++) {
+            lumVal = sLum[y][x];
+            cbVal = sCb[y / 2][x / 2] - 128;
+            crVal = sCr[y / 2][x / 2] - 128;
+            r = (int32_t)floor(lumVal + 1.402 * crVal + 0.5);
+            g = (int32_t)floor(lumVal - 0.344136 * cbVal - 0.714136 * crVal + 0.5);
+            b = (int32_t)floor(lumVal + 1.772 * cbVal + 0.5);
+            r = CLAMP(r, 0, 255);
+            g = CLAMP(g, 0, 255);
+            b = CLAMP(b, 0, 255);
+            out[y * SCREEN_WIDTH + x] = ((r >> 3) << 11) | ((g >> 3) << 6) | ((b >> 3) << 1) | 1;
+        }
+    }
+}
+
+/*
+ * Test driver
+ */
+
+static int32_t get_channel_diff(uint16_t a, uint16_t b, int32_t shift) {
+    int32_t diff = ((a >> shift) & 0x1F) - ((b >> shift) & 0x1F);
+
+    return (diff < 0) ? -diff : diff;
+}
+
+static void print_usage(void) {
+    printf("Usage: jpegdecode [-n IMAGES] [-s SEED]\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("-n IMAGES  random images to decode (default 20)\n");
+    printf("-s SEED    random seed (default 1)\n");
+}
+
+int main(int argc, char** argv) {
+    static const int32_t sQualities[] = { 10, 25, 50, 75, 90, 100 };
+    static EncodedImage sImage;
+    static uint8_t sJpeg[MAX_JPEG_SIZE + 16];
+    static uint16_t sZbuffer[SCREEN_WIDTH * SCREEN_HEIGHT];
+    static uint16_t sExpected[SCREEN_WIDTH * SCREEN_HEIGHT];
+    static JpegWork sWork;
+    unsigned numImages = 20;
+    unsigned numErrors = 0;
+    unsigned numOffByOne = 0;
+    unsigned numPixels = 0;
+    unsigned n;
+    int32_t quality;
+    int32_t diff;
+    int32_t maxDiff;
+    int32_t i;
+    int32_t j;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:?")) != -1) {
+        switch (opt) {
+            case 'n':
+                numImages = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                sRandState = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("jpegdecode version %s\n", JPEGDECODE_VER);
+                print_usage();
+                return (opt == '?') ? 0 : 1;
+        }
+    }
+
+    for (i = 0; i < 8; i++) {
+        for (j = 0; j < 8; j++) {
+            sCosTable[i][j] = ((j == 0) ? sqrt(0.5) : 1.0) * cos((2 * i + 1) * j * PI / 16.0);
+        }
+    }
+    init_encoder(&sEncoders[0], sLumDcBits, sDcSymbols);
+    init_encoder(&sEncoders[1], sLumAcBits, sLumAcSymbols);
+    init_encoder(&sEncoders[2], sChromaDcBits, sDcSymbols);
+    init_encoder(&sEncoders[3], sChromaAcBits, sChromaAcSymbols);
+
+    for (n = 0; n < numImages; n++) {
+        quality = sQualities[n % ARRAY_COUNT(sQualities)];
+        fill_image(&sImage, 16);
+        encode_image(&sImage, quality, sJpeg);
+        reference_decode(&sImage, sExpected);
+
+        memset(sZbuffer, 0, sizeof(sZbuffer));
+        sNumDecoderTasks = 0;
+        if ((jpeg_decode(sJpeg, sZbuffer, &sWork, sizeof(sWork)) != 0) || (sNumDecoderTasks != 0)) {
+            printf("error: image %u at quality %d was not decoded on the CPU\n", n, quality);
+            numErrors++;
+            continue;
+        }
+
+        maxDiff = 0;
+        for (i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
+            diff = get_channel_diff(sZbuffer[i], sExpected[i], 11);
+            diff = MAX(diff, get_channel_diff(sZbuffer[i], sExpected[i], 6));
+            diff = MAX(diff, get_channel_diff(sZbuffer[i], sExpected[i], 1));
+            if ((sZbuffer[i] & 1) == 0) {
+                diff = 0x1F;
+            }
+            if (diff == 1) {
+                numOffByOne++;
+            }
+            maxDiff = MAX(maxDiff, diff);
+        }
+        numPixels += SCREEN_WIDTH * SCREEN_HEIGHT;
+        if (maxDiff > 1) {
+            if (numErrors < 10) {
+                printf("error: image %u at quality %d is off by up to %d\n", n, quality, maxDiff);
+            }
+            numErrors++;
+        }
+    }
+    printf("%u images checked, %u of %u pixels off by one\n", numImages, numOffByOne, numPixels);
+    if (numOffByOne * 50 > numPixels) {
+        printf("error: more pixels are off by one than with an accurate IDCT\n");
+        numErrors++;
+    }
+
+    // Mode 0 images have 16x8 MCUs, which the CPU path does not decode
+    fill_image(&sImage, 8);
+    encode_image(&sImage, 75, sJpeg);
+    sNumDecoderTasks = 0;
+    jpeg_decode(sJpeg, sZbuffer, &sWork, sizeof(sWork));
+    if (sNumDecoderTasks != 300 / 4) {
+        printf("error: %u microcode tasks for a mode 0 image, expected %d\n", sNumDecoderTasks, 300 / 4);
+        numErrors++;
+    }
+
+    if (numErrors != 0) {
+        printf("FAILED: %u errors\n", numErrors);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
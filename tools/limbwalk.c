@@ -0,0 +1,312 @@
+/*
+ * limbwalk: checks that the iterative limb walk of the skeleton draw functions visits limbs and pushes and pops the
+ * matrix stack in the same order as the recursion it replaced, and times both.
+ *
+ * get_next_limb is a copy of SkelAnime_GetNextLimb in src/code/z_skelanime.c and needs to be kept in sync with it.
+ * draw_limb_recursive has the shape every limb draw function had before: push, draw the limb, recurse into the child,
+ * pop, recurse into the sibling. draw_limb_iterative is the loop they use now.
+ *
+ * Random limb tables are built the way skeletons are laid out, with limbs in preorder and the root at index 0. Each
+ * walk records an event per push, pop and drawn limb, and the two event lists have to match. The draw itself is a
+ * matrix multiply on a host matrix stack, so the times only compare the cost of the walks on the host.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define LIMBWALK_VER "0.1"
+
+#define LIMB_DONE 0xFF
+#define MATRIX_STACK_SIZE 20
+#define MAX_EVENTS (3 * LIMB_DONE)
+
+typedef struct {
+    int16_t jointPos[3];
+    uint8_t child;
+    uint8_t sibling;
+} StandardLimb;
+
+typedef enum {
+    EVENT_PUSH = 0x100,
+    EVENT_POP = 0x200
+    // Drawn limbs are recorded as their index
+} LimbEvent;
+
+typedef struct {
+    float mf[4][4];
+} MtxF;
+
+static StandardLimb sLimbs[LIMB_DONE];
+static StandardLimb* sSkeleton[LIMB_DONE];
+static MtxF sMatrixStack[MATRIX_STACK_SIZE];
+static MtxF* sCurrentMatrix;
+static int sEvents[MAX_EVENTS];
+static int sNumEvents;
+static bool sRecordEvents;
+static unsigned sNumErrors;
+
+static uint32_t sRandState = 1;
+
+static uint32_t next_rand(void) {
+    sRandState = sRandState * 1664525 + 1013904223;
+    return sRandState >> 8;
+}
+
+static void record(int event) {
+    if (sRecordEvents && (sNumEvents < MAX_EVENTS)) {
+        sEvents[sNumEvents++] = event;
+    }
+}
+
+/*
+ * Matrix stack and limb draw, standing in for Matrix_Push, Matrix_Pop and Matrix_TranslateRotateZYX
+ */
+
+static void matrix_push(void) {
+    record(EVENT_PUSH);
+    if (sCurrentMatrix == &sMatrixStack[MATRIX_STACK_SIZE - 1]) {
+        sNumErrors++;
+        return;
+    }
+    sCurrentMatrix[1] = sCurrentMatrix[0];
+    sCurrentMatrix++;
+}
+
+static void matrix_pop(void) {
+    record(EVENT_POP);
+    if (sCurrentMatrix == &sMatrixStack[0]) {
+        sNumErrors++;
+        return;
+    }
+    sCurrentMatrix--;
+}
+
+static void draw_limb(int limbIndex, StandardLimb* limb) {
+    MtxF* mf = sCurrentMatrix;
+    int i;
+
+    record(limbIndex);
+    for (i = 0; i < 3; i++) {
+        mf->mf[3][i] += mf->mf[0][i] * limb->jointPos[0] + mf->mf[1][i] * limb->jointPos[1] +
+                        mf->mf[2][i] * limb->jointPos[2];
+    }
+}
+
+/*
+ * Walks
+ */
+
+static void draw_limb_recursive(int limbIndex) {
+    StandardLimb* limb = sSkeleton[limbIndex];
+
+    matrix_push();
+    draw_limb(limbIndex, limb);
+
+    if (limb->child != LIMB_DONE) {
+        draw_limb_recursive(limb->child);
+    }
+
+    matrix_pop();
+
+    if (limb->sibling != LIMB_DONE) {
+        draw_limb_recursive(limb->sibling);
+    }
+}
+
+static int get_next_limb(StandardLimb** skeleton, int limbIndex, StandardLimb* limb, uint8_t* parents, int* depth) {
+    if (limb->child != LIMB_DONE) {
+        parents[(*depth)++] = limbIndex;
+        return limb->child;
+    }
+
+    while (true) {
+        matrix_pop();
+        if (limb->sibling != LIMB_DONE) {
+            return limb->sibling;
+        }
+        if (*depth == 0) {
+            return LIMB_DONE;
+        }
+        limb = skeleton[parents[--(*depth)]];
+    }
+}
+
+static void draw_limb_iterative(int limbIndex) {
+    StandardLimb* limb;
+    uint8_t parents[LIMB_DONE];
+    int depth = 0;
+
+    do {
+        matrix_push();
+        limb = sSkeleton[limbIndex];
+        draw_limb(limbIndex, limb);
+        limbIndex = get_next_limb(sSkeleton, limbIndex, limb, parents, &depth);
+    } while (limbIndex != LIMB_DONE);
+}
+
+/*
+ * Test driver
+ */
+
+/**
+ * Builds a random tree of `numLimbs` limbs in preorder, at most `maxDepth` limbs deep
+ */
+static void build_skeleton(int numLimbs, int maxDepth) {
+    int stack[LIMB_DONE];
+    int lastChild[LIMB_DONE];
+    int depth = 0;
+    int i;
+
+    for (i = 0; i < numLimbs; i++) {
+        sLimbs[i].jointPos[0] = next_rand() % 200 - 100;
+        sLimbs[i].jointPos[1] = next_rand() % 200 - 100;
+        sLimbs[i].jointPos[2] = next_rand() % 200 - 100;
+        sLimbs[i].child = LIMB_DONE;
+        sLimbs[i].sibling = LIMB_DONE;
+        sSkeleton[i] = &sLimbs[i];
+        if (i == 0) {
+            stack[0] = 0;
+            lastChild[0] = LIMB_DONE;
+            depth = 1;
+            continue;
+        }
+
+        // Attach to a limb on the path to the last one, mostly the deepest so that chains like arms form
+        if (depth >= maxDepth) {
+            depth = maxDepth - 1;
+        }
+        if ((next_rand() % 4) == 0) {
+            depth = 1 + next_rand() % depth;
+        }
+
+        if (lastChild[depth - 1] == LIMB_DONE) {
+            sLimbs[stack[depth - 1]].child = i;
+        } else {
+            sLimbs[lastChild[depth - 1]].sibling = i;
+        }
+        lastChild[depth - 1] = i;
+        stack[depth] = i;
+        lastChild[depth] = LIMB_DONE;
+        depth++;
+    }
+}
+
+static int run_walk(void (*walk)(int), int* events) {
+    sCurrentMatrix = &sMatrixStack[0];
+    sNumEvents = 0;
+    sRecordEvents = true;
+    walk(0);
+    sRecordEvents = false;
+    if (sCurrentMatrix != &sMatrixStack[0]) {
+        sNumErrors++;
+    }
+    memcpy(events, sEvents, sNumEvents * sizeof(int));
+    return sNumEvents;
+}
+
+static double get_time(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double time_walk(void (*walk)(int), unsigned iterations) {
+    double start = get_time();
+    unsigned i;
+
+    for (i = 0; i < iterations; i++) {
+        sCurrentMatrix = &sMatrixStack[0];
+        walk(0);
+    }
+    return get_time() - start;
+}
+
+static void print_usage(void) {
+    printf("Usage: limbwalk [-n SKELETONS] [-l LIMBS] [-i ITERATIONS] [-s SEED]\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("-n SKELETONS  random skeletons to check (default 20000)\n");
+    printf("-l LIMBS      limbs in the timed skeleton, at most %d (default 22)\n", LIMB_DONE - 1);
+    printf("-i ITERATIONS timed walks of the skeleton with each version (default 2000000)\n");
+    printf("-s SEED       random seed (default 1)\n");
+}
+
+int main(int argc, char** argv) {
+    static int sRecursiveEvents[MAX_EVENTS];
+    static int sIterativeEvents[MAX_EVENTS];
+    unsigned numSkeletons = 20000;
+    unsigned numTimedLimbs = 22;
+    unsigned iterations = 2000000;
+    unsigned numMismatches = 0;
+    unsigned n;
+    int numRecursiveEvents;
+    int numIterativeEvents;
+    int numLimbs;
+    double recursiveTime;
+    double iterativeTime;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:l:i:s:?")) != -1) {
+        switch (opt) {
+            case 'n':
+                numSkeletons = strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                numTimedLimbs = strtoul(optarg, NULL, 0);
+                break;
+            case 'i':
+                iterations = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                sRandState = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("limbwalk version %s\n", LIMBWALK_VER);
+                print_usage();
+                return (opt == '?') ? 0 : 1;
+        }
+    }
+    if ((numTimedLimbs == 0) || (numTimedLimbs >= LIMB_DONE)) {
+        print_usage();
+        return 1;
+    }
+
+    for (n = 0; n < numSkeletons; n++) {
+        // The game's matrix stack is 20 deep, so skeletons are far shallower than their limb count
+        numLimbs = 1 + next_rand() % (LIMB_DONE - 1);
+        build_skeleton(numLimbs, 2 + next_rand() % (MATRIX_STACK_SIZE - 3));
+
+        numRecursiveEvents = run_walk(draw_limb_recursive, sRecursiveEvents);
+        numIterativeEvents = run_walk(draw_limb_iterative, sIterativeEvents);
+        if ((numRecursiveEvents != 3 * numLimbs) || (numIterativeEvents != numRecursiveEvents) ||
+            (memcmp(sRecursiveEvents, sIterativeEvents, numRecursiveEvents * sizeof(int)) != 0)) {
+            if (numMismatches < 10) {
+                printf("error: walks differ on a skeleton of %d limbs\n", numLimbs);
+            }
+            numMismatches++;
+        }
+    }
+
+    build_skeleton(numTimedLimbs, 8);
+    memset(sMatrixStack, 0, sizeof(sMatrixStack));
+    recursiveTime = time_walk(draw_limb_recursive, iterations);
+    iterativeTime = time_walk(draw_limb_iterative, iterations);
+
+    printf("%u skeletons checked, %u mismatches\n", numSkeletons, numMismatches);
+    printf("%u limbs, %u walks: recursive %.1f ns/walk, iterative %.1f ns/walk\n", numTimedLimbs, iterations,
+           recursiveTime * 1e9 / iterations, iterativeTime * 1e9 / iterations);
+
+    if ((numMismatches != 0) || (sNumErrors != 0)) {
+        printf("FAILED: %u mismatches, %u matrix stack errors\n", numMismatches, sNumErrors);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
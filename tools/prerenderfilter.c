@@ -0,0 +1,931 @@
+/*
+ * prerenderfilter: checks that the anti-aliasing and divot filters of PreRender give the same image as the versions
+ * they replaced, and times both.
+ *
+ * aa_filter_pixel, aa_filter_inner_pixel, aa_filter_row, aa_filter, median3, sort_5b_column, get_5b_median9_sorted,
+ * get_5b_median9, divot_filter_init, divot_filter_row and divot_filter are copies of the PreRender_ functions of the
+ * same names in src/code/PreRender.c, and need to be kept in sync with them. aa_filter_original,
+ * get_5b_median9_original and divot_filter_original are PreRender_AntiAliasFilter, PreRender_Get5bMedian9 and
+ * PreRender_DivotFilter as they were before, filtering every partially covered pixel with
+ * PreRender_AntiAliasFilterPixel and taking medians from a histogram. The line buffers of the divot filters come from
+ * a static buffer in place of alloca.
+ *
+ * Random images of several sizes, with coverage buffers at every alignment and with few, some or most pixels partially
+ * covered, are filtered with both versions of both filters and compared byte for byte. get_5b_median9 is compared with
+ * get_5b_median9_original on random 5-bit values. Both filters are then timed on a 320x240 image.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define PRERENDERFILTER_VER "0.1"
+
+#define MAX_WIDTH 400
+#define MAX_HEIGHT 300
+
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+
+/* The fields are listed from the low bits up, so that r is in the top bits as on the N64 */
+typedef union {
+    __extension__ struct {
+        uint16_t a : 1;
+        uint16_t b : 5;
+        uint16_t g : 5;
+        uint16_t r : 5;
+    };
+    uint16_t rgba;
+} Color_RGBA16;
+
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint16_t* fbufSave;
+    uint8_t* cvgSave;
+} PreRender;
+
+typedef struct {
+    uint8_t* redRow[3];
+    uint8_t* greenRow[3];
+    uint8_t* blueRow[3];
+    uint8_t* cvgFull;
+} PreRenderDivotState;
+
+static uint8_t sDivotBuffer[MAX_WIDTH * 10];
+
+/*
+ * Shared by both versions
+ */
+
+/**
+ * Applies the Video Interface anti-aliasing of silhouette edges to an image.
+ *
+ * This filter performs a linear interpolation on partially covered pixels between the current pixel color (called
+ * foreground color) and a "background" pixel color obtained by sampling fully covered pixels at the six highlighted
+ * points in the following 5x3 neighborhood:
+ *    _ _ _ _ _
+ *  |   o   o   |
+ *  | o   X   o |
+ *  |   o   o   |
+ *    ‾ ‾ ‾ ‾ ‾
+ * Whether a pixel is partially covered is determined by reading the coverage values associated with the image.
+ * Coverage is a measure of how many subpixels the last drawn primitive covered. A fully covered pixel is one with a
+ * full coverage value, the entire pixel was covered by the primitive.
+ * The background color is calculated as the average of the "penultimate" minimum and maximum colors in the 5x3
+ * neighborhood.
+ *
+ * The final color is calculated by interpolating the foreground and background color weighted by the coverage:
+ *      OutputColor = cvg * ForeGround + (1.0 - cvg) * BackGround
+ *
+ * This is a software implementation of the same algorithm used in the Video Interface hardware when Anti-Aliasing is
+ * enabled in the VI Control Register.
+ *
+ * Patent describing the algorithm:
+ *
+ * Gossett, C. P., & van Hook, T. J. (Filed 1995, Published 1998)
+ * Antialiasing of silhouette edges (USOO5742277A)
+ * U.S. Patent and Trademark Office
+ * Expired 2015-10-06
+ * https://patents.google.com/patent/US5742277A/en
+ *
+ * @param this  PreRender instance
+ * @param x     Center pixel x
+ * @param y     Center pixel y
+ */
+static void aa_filter_pixel(PreRender* this, int32_t x, int32_t y) {
+    int32_t i;
+    int32_t j;
+    int32_t buffCvg[3 * 5];
+    int32_t buffR[3 * 5];
+    int32_t buffG[3 * 5];
+    int32_t buffB[3 * 5];
+    int32_t xi;
+    int32_t yi;
+    int32_t temp;
+    int32_t pmaxR;
+    int32_t pmaxG;
+    int32_t pmaxB;
+    int32_t pminR;
+    int32_t pminG;
+    int32_t pminB;
+    Color_RGBA16 pxIn;
+    Color_RGBA16 pxOut;
+    uint32_t outR;
+    uint32_t outG;
+    uint32_t outB;
+
+    // Extract pixels in the 5x3 neighborhood
+    for (i = 0; i < 5 * 3; i++) {
+        xi = x + (i % 5) - 2;
+        yi = y + (i / 5) - 1;
+
+        // Clamp coordinates to the edges of the image
+        if (xi < 0) {
+            xi = 0;
+        } else if (xi > (this->width - 1)) {
+            xi = this->width - 1;
+        }
+        if (yi < 0) {
+            yi = 0;
+        } else if (yi > (this->height - 1)) {
+            yi = this->height - 1;
+        }
+
+        // Extract color channels for each pixel, convert 5-bit color channels to 8-bit
+        pxIn.rgba = this->fbufSave[xi + yi * this->width];
+        buffR[i] = (pxIn.r << 3) | (pxIn.r >> 2);
+        buffG[i] = (pxIn.g << 3) | (pxIn.g >> 2);
+        buffB[i] = (pxIn.b << 3) | (pxIn.b >> 2);
+        buffCvg[i] = this->cvgSave[xi + yi * this->width] >> 5;
+    }
+
+    pmaxR = pminR = buffR[7];
+    pmaxG = pminG = buffG[7];
+    pmaxB = pminB = buffB[7];
+
+    // For each neighbor
+    for (i = 1; i < 5 * 3; i += 2) {
+        // Only sample fully covered pixels
+        if (buffCvg[i] == 7) {
+            // Determine "Penultimate Maximum" Value
+
+            // If current maximum is less than this neighbor
+            if (pmaxR < buffR[i]) {
+                // For each neighbor (again)
+                for (j = 1; j < 5 * 3; j += 2) {
+                    // If not the neighbor we were at before, and this neighbor has a larger value and this pixel is
+                    // fully covered, that means the neighbor at `i` is the "penultimate maximum"
+                    if ((i != j) && (buffR[j] >= buffR[i]) && (buffCvg[j] == 7)) {
+                        pmaxR = buffR[i];
+                    }
+                }
+            }
+            if (pmaxG < buffG[i]) {
+                for (j = 1; j < 5 * 3; j += 2) {
+                    if ((i != j) && (buffG[j] >= buffG[i]) && (buffCvg[j] == 7)) {
+                        pmaxG = buffG[i];
+                    }
+                }
+            }
+            if (pmaxB < buffB[i]) {
+                for (j = 1; j < 5 * 3; j += 2) {
+                    if ((i != j) && (buffB[j] >= buffB[i]) && (buffCvg[j] == 7)) {
+                        pmaxB = buffB[i];
+                    }
+                }
+            }
+
+            if (1) {}
+
+            // Determine "Penultimate Minimum" Value
+
+            // Same as above with inverted conditions
+            if (pminR > buffR[i]) {
+                for (j = 1; j < 5 * 3; j += 2) {
+                    if ((i != j) && (buffR[j] <= buffR[i]) && (buffCvg[j] == 7)) {
+                        pminR = buffR[i];
+                    }
+                }
+            }
+            if (pminG > buffG[i]) {
+                for (j = 1; j < 5 * 3; j += 2) {
+                    if ((i != j) && (buffG[j] <= buffG[i]) && (buffCvg[j] == 7)) {
+                        pminG = buffG[i];
+                    }
+                }
+            }
+            if (pminB > buffB[i]) {
+                for (j = 1; j < 5 * 3; j += 2) {
+                    if ((i != j) && (buffB[j] <= buffB[i]) && (buffCvg[j] == 7)) {
+                        pminB = buffB[i];
+                    }
+                }
+            }
+        }
+    }
+
+    // The background color is determined by averaging the penultimate minimum and maximum pixels, and subtracting the
+    // Foreground color:
+    //      BackGround = (pMax + pMin) - (ForeGround) * 2
+
+    // OutputColor = cvg * ForeGround + (1.0 - cvg) * BackGround
+    temp = 7 - buffCvg[7];
+    outR = buffR[7] + ((int32_t)(temp * (pmaxR + pminR - (buffR[7] * 2)) + 4) >> 3);
+    outG = buffG[7] + ((int32_t)(temp * (pmaxG + pminG - (buffG[7] * 2)) + 4) >> 3);
+    outB = buffB[7] + ((int32_t)(temp * (pmaxB + pminB - (buffB[7] * 2)) + 4) >> 3);
+
+    pxOut.r = outR >> 3;
+    pxOut.g = outG >> 3;
+    pxOut.b = outB >> 3;
+    pxOut.a = 1;
+    this->fbufSave[x + y * this->width] = pxOut.rgba;
+}
+
+/*
+ * Previous versions
+ */
+
+/**
+ * Applies the Video Interface anti-aliasing filter to `this->fbufSave` using `this->cvgSave`
+ */
+static void aa_filter_original(PreRender* this) {
+    int32_t x;
+    int32_t y;
+    int32_t cvg;
+
+    // Apply AA filter
+    for (y = 0; y < this->height; y++) {
+        for (x = 0; x < this->width; x++) {
+            cvg = this->cvgSave[x + y * this->width];
+            cvg >>= 5;
+            cvg++;
+
+            if (cvg != 8) {
+                // If this pixel has only partial coverage, perform the Video Filter interpolation on it
+                aa_filter_pixel(this, x, y);
+            }
+        }
+    }
+}
+
+/**
+ * Selects the median value from 9 different 5-bit pixels:
+ * px1[0], px1[1], px1[2], px2[0], px2[1], px2[2], px3[0], px3[1], px3[2]
+ * all args are expected to be an array of 3 different 5-bit values
+ */
+static uint32_t get_5b_median9_original(uint8_t* px1, uint8_t* px2, uint8_t* px3) {
+    uint8_t pxValCount[32]; // Stores the count for each of the possible 32 5-bit pixel values
+    uint32_t pxCount;       // Pixel count
+    int32_t pxMed;         // Pixel median value
+
+    // Initialize count to 0 in groups of 4 bits
+    *(int32_t*)(&pxValCount[0]) = 0;
+    *(int32_t*)(&pxValCount[4]) = 0;
+    *(int32_t*)(&pxValCount[8]) = 0;
+    *(int32_t*)(&pxValCount[12]) = 0;
+    *(int32_t*)(&pxValCount[16]) = 0;
+    *(int32_t*)(&pxValCount[20]) = 0;
+    *(int32_t*)(&pxValCount[24]) = 0;
+    *(int32_t*)(&pxValCount[28]) = 0;
+
+    // Increment the count that contains the pixel values
+    pxValCount[px1[0]]++;
+    pxValCount[px1[1]]++;
+    pxValCount[px1[2]]++;
+
+    pxValCount[px2[0]]++;
+    pxValCount[px2[1]]++;
+    pxValCount[px2[2]]++;
+
+    pxValCount[px3[0]]++;
+    pxValCount[px3[1]]++;
+    pxValCount[px3[2]]++;
+
+    // Loop through the 32 bits until 5 values are found, then return that bit value.
+    // Note that the median of 9 is the 5th sequential value.
+    pxCount = 0;
+    pxMed = 0;
+    while (true) {
+        pxCount += pxValCount[pxMed];
+        if (pxCount >= 5) {
+            // the median is found
+            break;
+        }
+        pxMed++;
+    }
+
+    return pxMed;
+}
+
+// Despite the name, this function doesn't seem like an hardware-accurate divot filter
+static void divot_filter_original(PreRender* this) {
+    uint32_t width = this->width;
+    uint32_t height = this->height;
+    uint8_t* buffer = sDivotBuffer;
+    uint8_t* redRow[3];
+    uint8_t* greenRow[3];
+    uint8_t* blueRow[3];
+    uint8_t* cvgFull;
+    Color_RGBA16 inPx;
+    Color_RGBA16 outPx;
+    uint32_t x;
+    uint32_t y;
+
+    redRow[0] = &buffer[width * 0];
+    redRow[1] = &buffer[width * 1];
+    redRow[2] = &buffer[width * 2];
+
+    greenRow[0] = &buffer[width * 3];
+    greenRow[1] = &buffer[width * 4];
+    greenRow[2] = &buffer[width * 5];
+
+    blueRow[0] = &buffer[width * 6];
+    blueRow[1] = &buffer[width * 7];
+    blueRow[2] = &buffer[width * 8];
+
+    cvgFull = &buffer[width * 9];
+
+    // Fill line buffers for first 2 rows
+    for (y = 0; y < 2; y++) {
+        for (x = 0; x < width; x++) {
+            inPx.rgba = this->fbufSave[x + y * this->width];
+
+            redRow[y][x] = inPx.r;
+            greenRow[y][x] = inPx.g;
+            blueRow[y][x] = inPx.b;
+        }
+    }
+
+    // For each row in the image, except first and last
+    for (y = 1; y < height - 1; y++) {
+        // Find start of pixels and coverage for current line (bug? this should probably be fetching the NEXT line, but
+        // really the divot filter only cares about individual lines so it's already wrong)
+        uint8_t* redRow2 = redRow[2];
+        uint8_t* greenRow2 = greenRow[2];
+        uint8_t* blueRow2 = blueRow[2];
+        uint8_t* lineCvg = &this->cvgSave[width * y];
+        uint16_t* linePx = &this->fbufSave[width * y];
+
+        // Obtain next row from current line, current line becomes the bottom row?? (weird, you would expect this to
+        // sample the NEXT line?)
+        for (x = 0; x < width; x++) {
+            inPx.rgba = linePx[x];
+
+            redRow2[x] = inPx.r;
+            greenRow2[x] = inPx.g;
+            blueRow2[x] = inPx.b;
+
+            // checking for full coverage
+            cvgFull[x] = (lineCvg[x] >> 5) == 7;
+        }
+
+        for (x = 1; x < width - 1; x++) {
+            // if the coverage of the three adjacent pixels on the current line are not all fully covered
+            if (cvgFull[x - 1] && cvgFull[x] && cvgFull[x + 1]) {
+                continue;
+            }
+
+            // find median value in 3x3 square for each (r,g,b), replaces the pixel marked by X:
+            //  * * *
+            //  * * *
+            //  * X *
+            outPx.r = get_5b_median9_original(&redRow[0][x - 1], &redRow[1][x - 1], &redRow[2][x - 1]);
+            outPx.g = get_5b_median9_original(&greenRow[0][x - 1], &greenRow[1][x - 1], &greenRow[2][x - 1]);
+            outPx.b = get_5b_median9_original(&blueRow[0][x - 1], &blueRow[1][x - 1], &blueRow[2][x - 1]);
+            outPx.a = 1;
+
+            this->fbufSave[x + y * this->width] = outPx.rgba;
+        }
+
+        // Shuffle row 1 -> 0
+        redRow[0] = redRow[1];
+        greenRow[0] = greenRow[1];
+        blueRow[0] = blueRow[1];
+        // Shuffle row 2 -> 1
+        redRow[1] = redRow[2];
+        greenRow[1] = greenRow[2];
+        blueRow[1] = blueRow[2];
+    }
+}
+
+/*
+ * Current versions
+ */
+
+#define PRERENDER_5B_TO_8B(v) (((v) << 3) | ((v) >> 2))
+
+/**
+ * Same as `aa_filter_pixel` for a partially covered pixel at least 2 pixels away from the left and right
+ * edges and 1 pixel away from the top and bottom edges, so its neighborhood needs no clamping.
+ *
+ * The search in `aa_filter_pixel` only samples the fully covered neighbors at odd indices of the 5x3
+ * neighborhood, as the center is never fully covered. The penultimate maximum it finds is the second largest of them
+ * if there are at least two, or the center if that is larger, and likewise for the minimum. Those are tracked in one
+ * pass over the 5-bit values, which order the same way as their 8-bit expansions.
+ *
+ * @param this             PreRender instance
+ * @param x                Center pixel x
+ * @param y                Center pixel y
+ * @param neighborOffsets  Offsets from the center pixel to the neighbors at (-1,-1), (1,-1), (-2,0), (2,0), (-1,1)
+ *                         and (1,1)
+ */
+static void aa_filter_inner_pixel(PreRender* this, int32_t x, int32_t y, int32_t* neighborOffsets) {
+    uint16_t* px = &this->fbufSave[x + y * this->width];
+    uint8_t* cvg = &this->cvgSave[x + y * this->width];
+    int32_t center[3];
+    int32_t val[3];
+    int32_t max[3][2]; // Largest and second largest fully covered neighbor of each channel
+    int32_t min[3][2]; // Smallest and second smallest
+    int32_t numFull = 0;
+    int32_t pmax;
+    int32_t pmin;
+    int32_t temp;
+    int32_t i;
+    int32_t c;
+    Color_RGBA16 pxIn;
+    Color_RGBA16 pxOut;
+    uint32_t out[3];
+
+    pxIn.rgba = px[0];
+    center[0] = pxIn.r;
+    center[1] = pxIn.g;
+    center[2] = pxIn.b;
+
+    for (c = 0; c < 3; c++) {
+        max[c][0] = max[c][1] = -1;
+        min[c][0] = min[c][1] = 32;
+    }
+
+    for (i = 0; i < 6; i++) {
+        if ((cvg[neighborOffsets[i]] >> 5) != 7) {
+            continue;
+        }
+
+        numFull++;
+        pxIn.rgba = px[neighborOffsets[i]];
+        val[0] = pxIn.r;
+        val[1] = pxIn.g;
+        val[2] = pxIn.b;
+
+        for (c = 0; c < 3; c++) {
+            if (val[c] > max[c][0]) {
+                max[c][1] = max[c][0];
+                max[c][0] = val[c];
+            } else if (val[c] > max[c][1]) {
+                max[c][1] = val[c];
+            }
+            if (val[c] < min[c][0]) {
+                min[c][1] = min[c][0];
+                min[c][0] = val[c];
+            } else if (val[c] < min[c][1]) {
+                min[c][1] = val[c];
+            }
+        }
+    }
+
+    // OutputColor = cvg * ForeGround + (1.0 - cvg) * BackGround, as in `aa_filter_pixel`
+    temp = 7 - (cvg[0] >> 5);
+    for (c = 0; c < 3; c++) {
+        pmax = pmin = center[c];
+        if (numFull >= 2) {
+            if (max[c][1] > pmax) {
+                pmax = max[c][1];
+            }
+            if (min[c][1] < pmin) {
+                pmin = min[c][1];
+            }
+        }
+
+        pmax = PRERENDER_5B_TO_8B(pmax);
+        pmin = PRERENDER_5B_TO_8B(pmin);
+        val[c] = PRERENDER_5B_TO_8B(center[c]);
+        out[c] = val[c] + ((int32_t)(temp * (pmax + pmin - (val[c] * 2)) + 4) >> 3);
+    }
+
+    pxOut.r = out[0] >> 3;
+    pxOut.g = out[1] >> 3;
+    pxOut.b = out[2] >> 3;
+    pxOut.a = 1;
+    px[0] = pxOut.rgba;
+}
+
+/**
+ * Applies the Video Interface anti-aliasing filter to row `y` of `this->fbufSave`. Rows must be filtered in order, as
+ * pixels are filtered in place and later pixels see the filtered earlier ones
+ */
+static void aa_filter_row(PreRender* this, int32_t y) {
+    int32_t width = this->width;
+    int32_t height = this->height;
+    int32_t neighborOffsets[6];
+    uint8_t* cvgRow = &this->cvgSave[y * width];
+    int32_t x = 0;
+
+    neighborOffsets[0] = -1 - width;
+    neighborOffsets[1] = 1 - width;
+    neighborOffsets[2] = -2;
+    neighborOffsets[3] = 2;
+    neighborOffsets[4] = -1 + width;
+    neighborOffsets[5] = 1 + width;
+
+    while (x < width) {
+        // Skip runs of fully covered pixels four at a time, where the coverage is word aligned
+        if ((((uintptr_t)&cvgRow[x] % 4) == 0) && ((x + 4) <= width) &&
+            ((*(uint32_t*)&cvgRow[x] & 0xE0E0E0E0) == 0xE0E0E0E0)) {
+            x += 4;
+            continue;
+        }
+
+        if ((cvgRow[x] >> 5) != 7) {
+            // If this pixel has only partial coverage, perform the Video Filter interpolation on it
+            if ((y > 0) && (y < (height - 1)) && (x >= 2) && (x < (width - 2))) {
+                aa_filter_inner_pixel(this, x, y, neighborOffsets);
+            } else {
+                aa_filter_pixel(this, x, y);
+            }
+        }
+        x++;
+    }
+}
+
+/**
+ * Applies the Video Interface anti-aliasing filter to `this->fbufSave` using `this->cvgSave`
+ */
+static void aa_filter(PreRender* this) {
+    int32_t y;
+
+    // Apply AA filter
+    for (y = 0; y < this->height; y++) {
+        aa_filter_row(this, y);
+    }
+}
+
+static uint32_t median3(uint32_t a, uint32_t b, uint32_t c) {
+    if (a > b) {
+        uint32_t temp = a;
+
+        a = b;
+        b = temp;
+    }
+    // a <= b, so the median is b clamped to [a, c] or c clamped to [a, b]
+    if (c < b) {
+        return (c > a) ? c : a;
+    }
+    return b;
+}
+
+/**
+ * Writes column `x` of the three rows to `sorted`, in ascending order
+ */
+static void sort_5b_column(uint8_t** rows, int32_t x, uint8_t* sorted) {
+    uint8_t a = rows[0][x];
+    uint8_t b = rows[1][x];
+    uint8_t c = rows[2][x];
+    uint8_t temp;
+
+    if (a > b) {
+        temp = a;
+        a = b;
+        b = temp;
+    }
+    if (b > c) {
+        temp = b;
+        b = c;
+        c = temp;
+    }
+    if (a > b) {
+        temp = a;
+        a = b;
+        b = temp;
+    }
+
+    sorted[0] = a;
+    sorted[1] = b;
+    sorted[2] = c;
+}
+
+/**
+ * Selects the median value of 9 values given as three sorted groups of 3. It is the median of the largest of the low
+ * values, the median of the middle values and the smallest of the high values
+ */
+static uint32_t get_5b_median9_sorted(uint8_t* sorted0, uint8_t* sorted1, uint8_t* sorted2) {
+    uint32_t maxLow = MAX(MAX(sorted0[0], sorted1[0]), sorted2[0]);
+    uint32_t minHigh = MIN(MIN(sorted0[2], sorted1[2]), sorted2[2]);
+
+    return median3(maxLow, median3(sorted0[1], sorted1[1], sorted2[1]), minHigh);
+}
+
+/**
+ * Selects the median value from 9 different 5-bit pixels:
+ * px1[0], px1[1], px1[2], px2[0], px2[1], px2[2], px3[0], px3[1], px3[2]
+ * all args are expected to be an array of 3 different 5-bit values
+ */
+static uint32_t get_5b_median9(uint8_t* px1, uint8_t* px2, uint8_t* px3) {
+    uint8_t* rows[3];
+    uint8_t sorted[3][3];
+    int32_t i;
+
+    rows[0] = px1;
+    rows[1] = px2;
+    rows[2] = px3;
+
+    // Sort the three values at each index, and select the median of the groups
+    for (i = 0; i < 3; i++) {
+        sort_5b_column(rows, i, sorted[i]);
+    }
+
+    return get_5b_median9_sorted(sorted[0], sorted[1], sorted[2]);
+}
+
+/**
+ * Points the line buffers of `state` into `buffer`, which must hold `this->width * 10` bytes, and fills them for the
+ * first 2 rows
+ */
+static void divot_filter_init(PreRender* this, PreRenderDivotState* state, uint8_t* buffer) {
+    uint32_t width = this->width;
+    Color_RGBA16 inPx;
+    uint32_t x;
+    uint32_t y;
+
+    state->redRow[0] = &buffer[width * 0];
+    state->redRow[1] = &buffer[width * 1];
+    state->redRow[2] = &buffer[width * 2];
+
+    state->greenRow[0] = &buffer[width * 3];
+    state->greenRow[1] = &buffer[width * 4];
+    state->greenRow[2] = &buffer[width * 5];
+
+    state->blueRow[0] = &buffer[width * 6];
+    state->blueRow[1] = &buffer[width * 7];
+    state->blueRow[2] = &buffer[width * 8];
+
+    state->cvgFull = &buffer[width * 9];
+
+    // Fill line buffers for first 2 rows
+    for (y = 0; y < 2; y++) {
+        for (x = 0; x < width; x++) {
+            inPx.rgba = this->fbufSave[x + y * this->width];
+
+            state->redRow[y][x] = inPx.r;
+            state->greenRow[y][x] = inPx.g;
+            state->blueRow[y][x] = inPx.b;
+        }
+    }
+}
+
+/**
+ * Applies the divot filter to row `y`, which must be the row after the one last filtered with `state`, starting at 1
+ */
+static void divot_filter_row(PreRender* this, PreRenderDivotState* state, uint32_t y) {
+    uint32_t width = this->width;
+    uint8_t** redRow = state->redRow;
+    uint8_t** greenRow = state->greenRow;
+    uint8_t** blueRow = state->blueRow;
+    uint8_t* cvgFull = state->cvgFull;
+    // Find start of pixels and coverage for current line (bug? this should probably be fetching the NEXT line, but
+    // really the divot filter only cares about individual lines so it's already wrong)
+    uint8_t* redRow2 = redRow[2];
+    uint8_t* greenRow2 = greenRow[2];
+    uint8_t* blueRow2 = blueRow[2];
+    uint8_t* lineCvg = &this->cvgSave[width * y];
+    uint16_t* linePx = &this->fbufSave[width * y];
+    uint8_t sortedRed[3][3];
+    uint8_t sortedGreen[3][3];
+    uint8_t sortedBlue[3][3];
+    Color_RGBA16 inPx;
+    Color_RGBA16 outPx;
+    uint32_t x;
+    int32_t col;
+    int32_t sortedX = -1; // Last column sorted for this row
+
+    // Obtain next row from current line, current line becomes the bottom row?? (weird, you would expect this to
+    // sample the NEXT line?)
+    for (x = 0; x < width; x++) {
+        inPx.rgba = linePx[x];
+
+        redRow2[x] = inPx.r;
+        greenRow2[x] = inPx.g;
+        blueRow2[x] = inPx.b;
+
+        // checking for full coverage
+        cvgFull[x] = (lineCvg[x] >> 5) == 7;
+    }
+
+    for (x = 1; x < width - 1; x++) {
+        // if the coverage of the three adjacent pixels on the current line are not all fully covered
+        if (cvgFull[x - 1] && cvgFull[x] && cvgFull[x + 1]) {
+            continue;
+        }
+
+        // Sort the columns of the 3x3 square that were not already sorted for the previous pixel. Column `col` is
+        // kept in slot `col % 3`, so the slots always hold columns x - 1 to x + 1
+        for (col = MAX((int32_t)x - 1, sortedX + 1); col <= (int32_t)x + 1; col++) {
+            sort_5b_column(redRow, col, sortedRed[col % 3]);
+            sort_5b_column(greenRow, col, sortedGreen[col % 3]);
+            sort_5b_column(blueRow, col, sortedBlue[col % 3]);
+        }
+        sortedX = x + 1;
+
+        // find median value in 3x3 square for each (r,g,b), replaces the pixel marked by X:
+        //  * * *
+        //  * * *
+        //  * X *
+        outPx.r = get_5b_median9_sorted(sortedRed[0], sortedRed[1], sortedRed[2]);
+        outPx.g = get_5b_median9_sorted(sortedGreen[0], sortedGreen[1], sortedGreen[2]);
+        outPx.b = get_5b_median9_sorted(sortedBlue[0], sortedBlue[1], sortedBlue[2]);
+        outPx.a = 1;
+
+        this->fbufSave[x + y * this->width] = outPx.rgba;
+    }
+
+    // Shuffle row 1 -> 0
+    redRow[0] = redRow[1];
+    greenRow[0] = greenRow[1];
+    blueRow[0] = blueRow[1];
+    // Shuffle row 2 -> 1
+    redRow[1] = redRow[2];
+    greenRow[1] = greenRow[2];
+    blueRow[1] = blueRow[2];
+}
+
+// Despite the name, this function doesn't seem like an hardware-accurate divot filter
+static void divot_filter(PreRender* this) {
+    PreRenderDivotState state;
+    uint32_t y;
+
+    divot_filter_init(this, &state, sDivotBuffer);
+
+    // For each row in the image, except first and last
+    for (y = 1; y < (uint32_t)(this->height - 1); y++) {
+        divot_filter_row(this, &state, y);
+    }
+}
+
+/*
+ * Test driver
+ */
+
+static uint32_t sRandState = 1;
+
+static uint32_t next_rand(void) {
+    sRandState = sRandState * 1664525 + 1013904223;
+    return sRandState >> 8;
+}
+
+/**
+ * Fills `fbuf` and `cvg` with a random image. In mode 0 colors are noise, otherwise they are smooth gradients with
+ * noise. The share of fully covered pixels is 50%, 85% or 97% for modes 0 to 2
+ */
+static void random_image(uint16_t* fbuf, uint8_t* cvg, int32_t width, int32_t height, int32_t mode) {
+    static const uint32_t sFullPercent[] = { 50, 85, 97 };
+    int32_t base;
+    int32_t i;
+
+    for (i = 0; i < width * height; i++) {
+        if (mode == 0) {
+            fbuf[i] = next_rand();
+        } else {
+            base = ((i / width) * 7 + (i % width) * 3) % 32;
+            fbuf[i] = (((base + next_rand() % 3) % 32) << 11) | ((next_rand() % 32) << 6) | ((next_rand() % 4) << 1) |
+                      1;
+        }
+        if ((next_rand() % 100) < sFullPercent[mode]) {
+            cvg[i] = 0xE0 | (next_rand() % 32);
+        } else {
+            cvg[i] = next_rand();
+        }
+    }
+}
+
+static double get_time(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_usage(void) {
+    printf("Usage: prerenderfilter [-n IMAGES] [-i ITERATIONS] [-m MODE] [-s SEED]\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("-n IMAGES      random images to check (default 2000)\n");
+    printf("-i ITERATIONS  timed runs of each filter version (default 100)\n");
+    printf("-m MODE        timed image: 0 noise, 1 and 2 gradients with 85%% and 97%% fully covered (default 1)\n");
+    printf("-s SEED        random seed (default 1)\n");
+}
+
+int main(int argc, char** argv) {
+    static const uint16_t sWidths[] = { 320, 321, 319, 64, 17, 6, 5 };
+    static const uint16_t sHeights[] = { 240, 30, 17, 4, 3, 2 };
+    static uint16_t sInitialFbuf[MAX_WIDTH * MAX_HEIGHT];
+    static uint16_t sOriginalFbuf[MAX_WIDTH * MAX_HEIGHT];
+    static uint16_t sFbuf[MAX_WIDTH * MAX_HEIGHT];
+    static uint8_t sCvg[MAX_WIDTH * MAX_HEIGHT + 4] __attribute__((aligned(4)));
+    PreRender original;
+    PreRender current;
+    uint8_t px[3][3];
+    unsigned numImages = 2000;
+    unsigned iterations = 100;
+    unsigned timedMode = 1;
+    unsigned numMismatches = 0;
+    unsigned numMedianMismatches = 0;
+    unsigned n;
+    unsigned i;
+    int32_t width;
+    int32_t height;
+    int32_t mode;
+    double times[4];
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:i:m:s:?")) != -1) {
+        switch (opt) {
+            case 'n':
+                numImages = strtoul(optarg, NULL, 0);
+                break;
+            case 'i':
+                iterations = strtoul(optarg, NULL, 0);
+                break;
+            case 'm':
+                timedMode = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                sRandState = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("prerenderfilter version %s\n", PRERENDERFILTER_VER);
+                print_usage();
+                return (opt == '?') ? 0 : 1;
+        }
+    }
+    if (timedMode > 2) {
+        print_usage();
+        return 1;
+    }
+
+    for (n = 0; n < numImages; n++) {
+        width = sWidths[next_rand() % (sizeof(sWidths) / sizeof(sWidths[0]))];
+        height = sHeights[next_rand() % (sizeof(sHeights) / sizeof(sHeights[0]))];
+        mode = next_rand() % 3;
+
+        original.width = current.width = width;
+        original.height = current.height = height;
+        // The coverage buffer is only 1-byte aligned in general, which changes where 4-pixel runs can be skipped
+        original.cvgSave = current.cvgSave = &sCvg[next_rand() % 4];
+        random_image(sInitialFbuf, original.cvgSave, width, height, mode);
+
+        memcpy(sOriginalFbuf, sInitialFbuf, width * height * sizeof(uint16_t));
+        original.fbufSave = sOriginalFbuf;
+        aa_filter_original(&original);
+        divot_filter_original(&original);
+
+        memcpy(sFbuf, sInitialFbuf, width * height * sizeof(uint16_t));
+        current.fbufSave = sFbuf;
+        aa_filter(&current);
+        divot_filter(&current);
+
+        if (memcmp(sOriginalFbuf, sFbuf, width * height * sizeof(uint16_t)) != 0) {
+            if (numMismatches < 10) {
+                printf("error: %dx%d image in mode %d differs\n", width, height, mode);
+            }
+            numMismatches++;
+        }
+    }
+
+    for (n = 0; n < 1000000; n++) {
+        for (i = 0; i < 9; i++) {
+            px[i / 3][i % 3] = next_rand() % 32;
+        }
+        if (get_5b_median9(px[0], px[1], px[2]) != get_5b_median9_original(px[0], px[1], px[2])) {
+            numMedianMismatches++;
+        }
+    }
+
+    original.width = current.width = 320;
+    original.height = current.height = 240;
+    original.cvgSave = current.cvgSave = sCvg;
+    original.fbufSave = sOriginalFbuf;
+    current.fbufSave = sFbuf;
+    random_image(sInitialFbuf, sCvg, 320, 240, timedMode);
+
+    times[0] = get_time();
+    for (i = 0; i < iterations; i++) {
+        memcpy(sOriginalFbuf, sInitialFbuf, 320 * 240 * sizeof(uint16_t));
+        aa_filter_original(&original);
+    }
+    times[0] = get_time() - times[0];
+    times[1] = get_time();
+    for (i = 0; i < iterations; i++) {
+        memcpy(sFbuf, sInitialFbuf, 320 * 240 * sizeof(uint16_t));
+        aa_filter(&current);
+    }
+    times[1] = get_time() - times[1];
+    times[2] = get_time();
+    for (i = 0; i < iterations; i++) {
+        divot_filter_original(&original);
+    }
+    times[2] = get_time() - times[2];
+    times[3] = get_time();
+    for (i = 0; i < iterations; i++) {
+        divot_filter(&current);
+    }
+    times[3] = get_time() - times[3];
+
+    printf("%u images checked, %u mismatches; 1000000 medians checked, %u mismatches\n", numImages, numMismatches,
+           numMedianMismatches);
+    printf("320x240 in mode %u: AA filter original %.1f us, current %.1f us; divot filter original %.1f us, current "
+           "%.1f us\n",
+           timedMode, times[0] * 1e6 / iterations, times[1] * 1e6 / iterations, times[2] * 1e6 / iterations,
+           times[3] * 1e6 / iterations);
+
+    if ((numMismatches != 0) || (numMedianMismatches != 0)) {
+        printf("FAILED\n");
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
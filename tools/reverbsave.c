@@ -0,0 +1,283 @@
+/*
+ * reverbsave: checks the command sequence AudioSynth_SaveResampledReverbSamplesImpl builds to save reverb samples to
+ * an address that may not be 16-byte aligned.
+ *
+ * save_reverb_samples is a copy of AudioSynth_SaveResampledReverbSamplesImpl in src/audio/lib/synthesis.c and needs to
+ * be kept in sync with it. save_reverb_samples_original is the function as it was before it was rewritten to load
+ * both edge blocks into a single staging area. The commands are run the way tools/audiohle.c runs them: LOADBUFF and
+ * SAVEBUFF move their size rounded down to 16 bytes, and DMEMMOVE copies forwards with its count rounded up to 16.
+ *
+ * For random sizes, source DMEM addresses and start addresses, both sequences are run on the same DMEM and RDRAM, and
+ * the test checks that:
+ * - RDRAM afterwards holds the samples at the start address and is unchanged everywhere else
+ * - DMEM from DMEM_WET_SCRATCH up is unchanged, as the samples of a wrapped ring buffer are saved from there next
+ * The number of commands each sequence emits is reported.
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+
+#define REVERBSAVE_VER "0.1"
+
+#define DMEM_SIZE 0x1000
+#define RDRAM_SIZE 0x800
+
+#define DMEM_TEMP 0x3B0
+#define DMEM_TEMP2 0x3C0
+#define DMEM_WET_SCRATCH 0x710
+#define DMEM_WET_LEFT_CH 0xC70
+#define DMEM_WET_RIGHT_CH 0xE10
+#define DMEM_1CH_SIZE 0x1A0
+
+#define A_DMEMMOVE 10
+#define A_LOADBUFF 20
+#define A_SAVEBUFF 21
+
+#define ALIGN16(val) (((val) + 0xF) & ~0xF)
+#define _SHIFTL(v, s, w) ((uint32_t)(((uint32_t)(v) & ((0x01 << (w)) - 1)) << (s)))
+
+typedef struct {
+    uint32_t w0;
+    uint32_t w1;
+} Acmd;
+
+typedef struct {
+    uint8_t dmem[DMEM_SIZE];
+    uint8_t rdram[RDRAM_SIZE];
+} AudioState;
+
+/*
+ * Command building, as in include/PR/abi.h. RDRAM addresses are offsets into AudioState.rdram
+ */
+
+static void aLoadBuffer(Acmd* a, uint32_t addrSrc, uint32_t dmemDest, uint32_t size) {
+    a->w0 = _SHIFTL(A_LOADBUFF, 24, 8) | _SHIFTL(size >> 4, 16, 8) | _SHIFTL(dmemDest, 0, 16);
+    a->w1 = addrSrc;
+}
+
+static void aSaveBuffer(Acmd* a, uint32_t dmemSrc, uint32_t addrDest, uint32_t size) {
+    a->w0 = _SHIFTL(A_SAVEBUFF, 24, 8) | _SHIFTL(size >> 4, 16, 8) | _SHIFTL(dmemSrc, 0, 16);
+    a->w1 = addrDest;
+}
+
+static void aDMEMMove(Acmd* a, uint32_t i, uint32_t o, uint32_t c) {
+    a->w0 = _SHIFTL(A_DMEMMOVE, 24, 8) | _SHIFTL(i, 0, 24);
+    a->w1 = _SHIFTL(o, 16, 16) | _SHIFTL(c, 0, 16);
+}
+
+/*
+ * Command sequences
+ */
+
+static Acmd* save_reverb_samples_original(Acmd* cmd, uint16_t dmem, uint16_t size, uintptr_t startAddr) {
+    int32_t startAddrAlignDropped;
+    uint32_t endAddr;
+    int32_t endAddrAlignDropped;
+
+    endAddr = startAddr + size;
+
+    endAddrAlignDropped = endAddr & 0xF;
+    if (endAddrAlignDropped != 0) {
+        aLoadBuffer(cmd++, (endAddr - endAddrAlignDropped), DMEM_TEMP, 0x10);
+        aDMEMMove(cmd++, dmem, DMEM_TEMP2, size);
+        aDMEMMove(cmd++, DMEM_TEMP + endAddrAlignDropped, size + DMEM_TEMP2, 0x10 - endAddrAlignDropped);
+
+        size += (0x10 - endAddrAlignDropped);
+        dmem = DMEM_TEMP2;
+    }
+
+    startAddrAlignDropped = startAddr & 0xF;
+    if (startAddrAlignDropped != 0) {
+        aLoadBuffer(cmd++, startAddr - startAddrAlignDropped, DMEM_TEMP, 0x10);
+        aDMEMMove(cmd++, dmem, startAddrAlignDropped + DMEM_TEMP, size);
+
+        size += startAddrAlignDropped;
+        dmem = DMEM_TEMP;
+    }
+
+    aSaveBuffer(cmd++, dmem, startAddr - startAddrAlignDropped, size);
+
+    return cmd;
+}
+
+static Acmd* save_reverb_samples(Acmd* cmd, uint16_t dmem, uint16_t size, uintptr_t startAddr) {
+    int32_t startAddrAlignDropped = startAddr & 0xF;
+    uintptr_t alignedStartAddr = startAddr - startAddrAlignDropped;
+    uint32_t endAddr = startAddr + size;
+    int32_t endAddrAlignDropped = endAddr & 0xF;
+    uint16_t alignedSize = ALIGN16(startAddrAlignDropped + size);
+    uint16_t endBlockDmem = DMEM_TEMP + alignedSize + 0x10;
+
+    if ((startAddrAlignDropped == 0) && (endAddrAlignDropped == 0)) {
+        aSaveBuffer(cmd++, dmem, startAddr, size);
+        return cmd;
+    }
+
+    if (startAddrAlignDropped != 0) {
+        aLoadBuffer(cmd++, alignedStartAddr, DMEM_TEMP, 0x10);
+    }
+
+    aDMEMMove(cmd++, dmem, DMEM_TEMP + startAddrAlignDropped, size);
+
+    if (endAddrAlignDropped != 0) {
+        aLoadBuffer(cmd++, endAddr - endAddrAlignDropped, endBlockDmem, 0x10);
+        aDMEMMove(cmd++, endBlockDmem + endAddrAlignDropped, DMEM_TEMP + startAddrAlignDropped + size,
+                  0x10 - endAddrAlignDropped);
+    }
+
+    aSaveBuffer(cmd++, DMEM_TEMP, alignedStartAddr, alignedSize);
+
+    return cmd;
+}
+
+/*
+ * Command execution, as in tools/audiohle.c
+ */
+
+static void run_cmds(AudioState* state, Acmd* cmd, Acmd* end) {
+    uint32_t count;
+    uint32_t dmem;
+    uint32_t i;
+
+    for (; cmd < end; cmd++) {
+        switch (cmd->w0 >> 24) {
+            case A_DMEMMOVE:
+                count = ALIGN16(cmd->w1 & 0xFFFF);
+                for (i = 0; i < count; i++) {
+                    state->dmem[((cmd->w1 >> 16) + i) & (DMEM_SIZE - 1)] =
+                        state->dmem[((cmd->w0 & 0xFFFF) + i) & (DMEM_SIZE - 1)];
+                }
+                break;
+
+            case A_LOADBUFF:
+                count = (cmd->w0 >> 12) & 0xFF0;
+                dmem = cmd->w0 & (DMEM_SIZE - 1);
+                for (i = 0; (i < count) && (dmem + i < DMEM_SIZE); i++) {
+                    state->dmem[dmem + i] = state->rdram[(cmd->w1 + i) % RDRAM_SIZE];
+                }
+                break;
+
+            case A_SAVEBUFF:
+                count = (cmd->w0 >> 12) & 0xFF0;
+                dmem = cmd->w0 & (DMEM_SIZE - 1);
+                for (i = 0; (i < count) && (dmem + i < DMEM_SIZE); i++) {
+                    state->rdram[(cmd->w1 + i) % RDRAM_SIZE] = state->dmem[dmem + i];
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+/*
+ * Test driver
+ */
+
+static uint32_t sRandState = 1;
+
+static uint32_t next_rand(void) {
+    sRandState = sRandState * 1664525 + 1013904223;
+    return sRandState >> 8;
+}
+
+static void print_usage(void) {
+    printf("Usage: reverbsave [-n CASES] [-s SEED]\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("-n CASES  random cases to run (default 30000)\n");
+    printf("-s SEED   random seed (default 1)\n");
+}
+
+int main(int argc, char** argv) {
+    static const uint16_t sSrcDmems[] = { DMEM_WET_SCRATCH, DMEM_WET_LEFT_CH, DMEM_WET_RIGHT_CH };
+    static AudioState sInitial;
+    static AudioState sOriginal;
+    static AudioState sNew;
+    static uint8_t sExpected[RDRAM_SIZE];
+    Acmd cmds[8];
+    Acmd* end;
+    unsigned numCases = 30000;
+    unsigned numOriginalCmds = 0;
+    unsigned numNewCmds = 0;
+    unsigned numOriginalErrors = 0;
+    unsigned numErrors = 0;
+    unsigned n;
+    unsigned i;
+    uint16_t dmem;
+    uint16_t size;
+    uintptr_t startAddr;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:s:?")) != -1) {
+        switch (opt) {
+            case 'n':
+                numCases = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                sRandState = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("reverbsave version %s\n", REVERBSAVE_VER);
+                print_usage();
+                return (opt == '?') ? 0 : 1;
+        }
+    }
+
+    for (n = 0; n < numCases; n++) {
+        // Samples are 2 bytes, and a wrapped save starts its source right after the first part's samples
+        size = 2 + 2 * (next_rand() % (DMEM_1CH_SIZE / 2));
+        dmem = sSrcDmems[next_rand() % 3];
+        if ((next_rand() % 2) != 0) {
+            dmem += 2 * (next_rand() % (DMEM_1CH_SIZE / 2 - size / 2 + 1));
+        }
+        startAddr = 0x100 + 2 * (next_rand() % 0x20);
+
+        for (i = 0; i < DMEM_SIZE; i++) {
+            sInitial.dmem[i] = next_rand();
+        }
+        for (i = 0; i < RDRAM_SIZE; i++) {
+            sInitial.rdram[i] = next_rand();
+        }
+        memcpy(sExpected, sInitial.rdram, RDRAM_SIZE);
+        memcpy(&sExpected[startAddr], &sInitial.dmem[dmem], size);
+
+        sOriginal = sInitial;
+        end = save_reverb_samples_original(cmds, dmem, size, startAddr);
+        run_cmds(&sOriginal, cmds, end);
+        numOriginalCmds += end - cmds;
+        if (memcmp(sOriginal.rdram, sExpected, RDRAM_SIZE) != 0) {
+            numOriginalErrors++;
+        }
+
+        sNew = sInitial;
+        end = save_reverb_samples(cmds, dmem, size, startAddr);
+        run_cmds(&sNew, cmds, end);
+        numNewCmds += end - cmds;
+        if ((memcmp(sNew.rdram, sExpected, RDRAM_SIZE) != 0) ||
+            (memcmp(&sNew.dmem[DMEM_WET_SCRATCH], &sInitial.dmem[DMEM_WET_SCRATCH], DMEM_SIZE - DMEM_WET_SCRATCH) !=
+             0)) {
+            if (numErrors < 10) {
+                printf("error: size 0x%X from DMEM 0x%X to 0x%X\n", size, dmem, (unsigned)startAddr);
+            }
+            numErrors++;
+        }
+    }
+
+    printf("%u cases: original %u commands, %u wrong; new %u commands\n", numCases, numOriginalCmds,
+           numOriginalErrors, numNewCmds);
+    if (numOriginalErrors != 0) {
+        printf("FAILED: the original sequence does not match the expected RDRAM, the model is wrong\n");
+        return 1;
+    }
+    if (numErrors != 0) {
+        printf("FAILED: %u errors\n", numErrors);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
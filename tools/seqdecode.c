@@ -0,0 +1,702 @@
+/*
+ * seqdecode: checks the decoded instruction cache of the sequence interpreter against the way the interpreter read
+ * instructions before it, and reports how often a sequence player's cache hits.
+ *
+ * decode_instr and the cache functions are copies of AudioScript_DecodeInstr, AudioScript_GetDecodedInstr and
+ * AudioScript_InvalidateDecodedInstrs in src/audio/lib/seqplayer.c, and need to be kept in sync with them.
+ * read_instr_original reads an instruction the way the channel interpreter and AudioScript_SeqLayerProcessScriptStep2
+ * and AudioScript_SeqLayerProcessScriptStep3 did before instructions were decoded ahead of running them. For notes,
+ * its args are the note event: delay, velocity and gate time.
+ *
+ * Two checks are run over the bytes of a sequence file, or random bytes if none is given:
+ * - every offset is decoded as a channel, small notes layer and large notes layer instruction, and the length and
+ *   args are compared with read_instr_original
+ * - scripts of every sequence player loop over short runs of the bytes via the cache while others write into them,
+ *   and each instruction returned is compared with read_instr_original at the same address. The hit rate of the
+ *   single 128 entry direct mapped cache all players used to share is reported next to it for the same walk
+ */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SEQDECODE_VER "0.1"
+
+#define SEQ_PLAYER_MAX 5
+#define SEQ_NUM_CHANNELS 16
+#define SEQ_DECODE_CACHE_BITS 8
+#define SEQ_DECODE_CACHE_SIZE (1 << SEQ_DECODE_CACHE_BITS)
+#define SEQ_DECODE_CACHE_FILL_MAX (SEQ_DECODE_CACHE_SIZE * 3 / 4)
+#define SEQ_DECODE_MAX_LENGTH 5
+#define SEQ_DECODE_DROPPED ((uint8_t*)1)
+#define SEQ_DECODE_SHARED_CACHE_SIZE 128
+
+#define RANDOM_SEQ_SIZE 0x4000
+// Script bytes ahead of the last offset checked, so no instruction reads past the buffer
+#define SEQ_PADDING 8
+
+enum {
+    SEQ_DECODE_KIND_NONE,
+    SEQ_DECODE_KIND_CHANNEL,
+    SEQ_DECODE_KIND_LAYER_SMALL_NOTES,
+    SEQ_DECODE_KIND_LAYER_LARGE_NOTES
+};
+
+typedef struct {
+    uint8_t* pc;
+    uint8_t cmd;
+    uint8_t kind;
+    uint8_t length;
+    int16_t args[3];
+} SeqDecodedInstr;
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t invalidations;
+    uint32_t flushes;
+} SeqDecodeCacheStats;
+
+typedef struct {
+    uint8_t* pc;
+} SeqScriptState;
+
+#define CMD_ARGS_0() 0
+#define CMD_ARGS_1(arg0Type) (((sizeof(arg0Type) - 1) << 7) | 1)
+#define CMD_ARGS_2(arg0Type, arg1Type) (((sizeof(arg0Type) - 1) << 7) | ((sizeof(arg1Type) - 1) << 6) | 2)
+#define CMD_ARGS_3(arg0Type, arg1Type, arg2Type) \
+    (((sizeof(arg0Type) - 1) << 7) | ((sizeof(arg1Type) - 1) << 6) | ((sizeof(arg2Type) - 1) << 5) | 3)
+
+static const uint8_t sSeqInstructionArgsTable[] = {
+    CMD_ARGS_1(int16_t),        // 0xA0 (channel:)
+    CMD_ARGS_0(),           // 0xA1 (channel:)
+    CMD_ARGS_1(int16_t),        // 0xA2 (channel:)
+    CMD_ARGS_0(),           // 0xA3 (channel:)
+    CMD_ARGS_1(uint8_t),         // 0xA4 (channel:)
+    CMD_ARGS_0(),           // 0xA5 (channel:)
+    CMD_ARGS_2(uint8_t, int16_t),    // 0xA6 (channel:)
+    CMD_ARGS_1(uint8_t),         // 0xA7 (channel:)
+    CMD_ARGS_2(int16_t, int16_t),   // 0xA8 (channel: random range large)
+    CMD_ARGS_0(),           // 0xA9 ()
+    CMD_ARGS_0(),           // 0xAA ()
+    CMD_ARGS_0(),           // 0xAB ()
+    CMD_ARGS_0(),           // 0xAC ()
+    CMD_ARGS_0(),           // 0xAD ()
+    CMD_ARGS_0(),           // 0xAE ()
+    CMD_ARGS_0(),           // 0xAF ()
+    CMD_ARGS_1(int16_t),        // 0xB0 (channel: set filter)
+    CMD_ARGS_0(),           // 0xB1 (channel: clear filter)
+    CMD_ARGS_1(int16_t),        // 0xB2 (channel: dynread sequence large)
+    CMD_ARGS_1(uint8_t),         // 0xB3 (channel: load filter)
+    CMD_ARGS_0(),           // 0xB4 (channel: set dyntable large)
+    CMD_ARGS_0(),           // 0xB5 (channel: read dyntable large)
+    CMD_ARGS_0(),           // 0xB6 (channel: read dyntable)
+    CMD_ARGS_1(int16_t),        // 0xB7 (channel: random large)
+    CMD_ARGS_1(uint8_t),         // 0xB8 (channel: random)
+    CMD_ARGS_1(uint8_t),         // 0xB9 (channel: set velocity random variance)
+    CMD_ARGS_1(uint8_t),         // 0xBA (channel: set gatetime random variance)
+    CMD_ARGS_2(uint8_t, int16_t),    // 0xBB (channel:)
+    CMD_ARGS_1(int16_t),        // 0xBC (channel: add large)
+    CMD_ARGS_1(int16_t),        // 0xBD (channel:)
+    CMD_ARGS_1(uint8_t),         // 0xBE (channel:)
+    CMD_ARGS_0(),           // 0xBF ()
+    CMD_ARGS_0(),           // 0xC0 ()
+    CMD_ARGS_1(uint8_t),         // 0xC1 (channel: set instrument)
+    CMD_ARGS_1(int16_t),        // 0xC2 (channel: set dyntable)
+    CMD_ARGS_0(),           // 0xC3 (channel: large notes off)
+    CMD_ARGS_0(),           // 0xC4 (channel: large notes on)
+    CMD_ARGS_0(),           // 0xC5 (channel: dyn set dyntable)
+    CMD_ARGS_1(uint8_t),         // 0xC6 (channel: set soundFont)
+    CMD_ARGS_2(uint8_t, int16_t),    // 0xC7 (channel: write into sequence script)
+    CMD_ARGS_1(uint8_t),         // 0xC8 (channel: subtract -> set value)
+    CMD_ARGS_1(uint8_t),         // 0xC9 (channel: `bit and` -> set value)
+    CMD_ARGS_1(uint8_t),         // 0xCA (channel: set mute behavior)
+    CMD_ARGS_1(int16_t),        // 0xCB (channel: read sequence -> set value)
+    CMD_ARGS_1(uint8_t),         // 0xCC (channel: set value)
+    CMD_ARGS_1(uint8_t),         // 0xCD (channel: disable channel)
+    CMD_ARGS_1(int16_t),        // 0xCE (channel:)
+    CMD_ARGS_1(int16_t),        // 0xCF (channel: write large into sequence script)
+    CMD_ARGS_1(uint8_t),         // 0xD0 (channel: stereo headset effects)
+    CMD_ARGS_1(uint8_t),         // 0xD1 (channel: set note allocation policy)
+    CMD_ARGS_1(uint8_t),         // 0xD2 (channel: set sustain)
+    CMD_ARGS_1(uint8_t),         // 0xD3 (channel: large bend pitch)
+    CMD_ARGS_1(uint8_t),         // 0xD4 (channel: set reverb)
+    CMD_ARGS_1(uint8_t),         // 0xD5 ()
+    CMD_ARGS_1(uint8_t),         // 0xD6 ()
+    CMD_ARGS_1(uint8_t),         // 0xD7 (channel: set vibrato rate)
+    CMD_ARGS_1(uint8_t),         // 0xD8 (channel: set vibrato depth)
+    CMD_ARGS_1(uint8_t),         // 0xD9 (channel: set decay index)
+    CMD_ARGS_1(int16_t),        // 0xDA (channel: set envelope)
+    CMD_ARGS_1(uint8_t),         // 0xDB (channel: transpose)
+    CMD_ARGS_1(uint8_t),         // 0xDC (channel: set pan mix)
+    CMD_ARGS_1(uint8_t),         // 0xDD (channel: set pan)
+    CMD_ARGS_1(int16_t),        // 0xDE (channel: set freqscale)
+    CMD_ARGS_1(uint8_t),         // 0xDF (channel: set volume)
+    CMD_ARGS_1(uint8_t),         // 0xE0 (channel: set volume scale)
+    CMD_ARGS_3(uint8_t, uint8_t, uint8_t), // 0xE1 (channel: set vibratorate linear)
+    CMD_ARGS_3(uint8_t, uint8_t, uint8_t), // 0xE2 (channel: set vibrato depth linear)
+    CMD_ARGS_1(uint8_t),         // 0xE3 (channel: set vibrato delay)
+    CMD_ARGS_0(),           // 0xE4 (channel: dyncall)
+    CMD_ARGS_1(uint8_t),         // 0xE5 (channel: set reverb index)
+    CMD_ARGS_1(uint8_t),         // 0xE6 (channel: set book offset)
+    CMD_ARGS_1(int16_t),        // 0xE7 (channel:)
+    CMD_ARGS_3(uint8_t, uint8_t, uint8_t), // 0xE8 (channel:)
+    CMD_ARGS_1(uint8_t),         // 0xE9 (channel: set note priority)
+    CMD_ARGS_0(),           // 0xEA (channel: stop script)
+    CMD_ARGS_2(uint8_t, uint8_t),     // 0xEB (channel: set soundFont and instrument)
+    CMD_ARGS_0(),           // 0xEC (channel: reset vibrato)
+    CMD_ARGS_1(uint8_t),         // 0xED (channel: set hilo gain)
+    CMD_ARGS_1(uint8_t),         // 0xEE (channel: small bend pitch)
+    CMD_ARGS_2(int16_t, uint8_t),    // 0xEF ()
+    CMD_ARGS_0(),           // 0xF0 (channel: unreserve notes)
+    CMD_ARGS_1(uint8_t),         // 0xF1 (channel: reserve notes)
+    // Control flow instructions (>= 0xF2) can only have 0 or 1 args
+    CMD_ARGS_1(uint8_t),  // 0xF2 (branch relative if less than zero)
+    CMD_ARGS_1(uint8_t),  // 0xF3 (branch relative if equal to zero)
+    CMD_ARGS_1(uint8_t),  // 0xF4 (jump relative)
+    CMD_ARGS_1(int16_t), // 0xF5 (branch if greater than or equal to zero)
+    CMD_ARGS_0(),    // 0xF6 (break)
+    CMD_ARGS_0(),    // 0xF7 (loop end)
+    CMD_ARGS_1(uint8_t),  // 0xF8 (loop)
+    CMD_ARGS_1(int16_t), // 0xF9 (branch if less than zero)
+    CMD_ARGS_1(int16_t), // 0xFA (branch if equal to zero)
+    CMD_ARGS_1(int16_t), // 0xFB (jump)
+    CMD_ARGS_1(int16_t), // 0xFC (call and jump to a function)
+    CMD_ARGS_0(),    // 0xFD (delay n frames)
+    CMD_ARGS_0(),    // 0xFE (delay 1 frame)
+    CMD_ARGS_0(),    // 0xFF (end script)
+};
+
+static SeqDecodedInstr sSeqDecodeCaches[SEQ_PLAYER_MAX][SEQ_DECODE_CACHE_SIZE];
+static int sSeqDecodeCacheFill[SEQ_PLAYER_MAX];
+static SeqDecodeCacheStats sStats;
+static SeqDecodedInstr sSharedCache[SEQ_DECODE_SHARED_CACHE_SIZE];
+static uint32_t sSharedCacheHits;
+
+static uint8_t read_u8(SeqScriptState* state) {
+    return *(state->pc++);
+}
+
+static int16_t read_s16(SeqScriptState* state) {
+    int16_t ret = *(state->pc++) << 8;
+
+    ret = *(state->pc++) | ret;
+    return ret;
+}
+
+static uint16_t read_compressed_u16(SeqScriptState* state) {
+    uint16_t ret = *(state->pc++);
+
+    if (ret & 0x80) {
+        ret = (ret << 8) & 0x7F00;
+        ret = *(state->pc++) | ret;
+    }
+    return ret;
+}
+
+/**
+ * Reads the instruction at `pc` as the interpreter for `kind` did, into `args`. Returns its length
+ */
+static int read_instr_original(uint8_t* pc, int kind, uint16_t args[3]) {
+    SeqScriptState state;
+    uint8_t cmd;
+    uint8_t highBits;
+    uint8_t lowBits;
+    int i;
+
+    state.pc = pc;
+    cmd = read_u8(&state);
+    args[0] = args[1] = args[2] = 0;
+
+    if (kind == SEQ_DECODE_KIND_CHANNEL) {
+        // AudioScript_SequenceChannelProcessScript
+        if (cmd >= 0xA0) {
+            highBits = sSeqInstructionArgsTable[cmd - 0xA0];
+            lowBits = highBits & 3;
+            for (i = 0; i < lowBits; i++, highBits <<= 1) {
+                if (!(highBits & 0x80)) {
+                    args[i] = read_u8(&state);
+                } else {
+                    args[i] = read_s16(&state);
+                }
+            }
+        }
+        return state.pc - pc;
+    }
+
+    if (cmd >= 0xF2) {
+        // AudioScript_GetScriptControlFlowArgument
+        highBits = sSeqInstructionArgsTable[cmd - 0xA0];
+        if ((highBits & 3) == 1) {
+            if (!(highBits & 0x80)) {
+                args[0] = read_u8(&state);
+            } else {
+                args[0] = read_s16(&state);
+            }
+        }
+        return state.pc - pc;
+    }
+
+    if (cmd == 0xC0) {
+        args[0] = read_compressed_u16(&state);
+        return state.pc - pc;
+    }
+
+    if (cmd < 0xC0) {
+        // AudioScript_SeqLayerProcessScriptStep3
+        if (kind == SEQ_DECODE_KIND_LAYER_LARGE_NOTES) {
+            switch (cmd & 0xC0) {
+                case 0x00:
+                    args[0] = read_compressed_u16(&state);
+                    args[1] = read_u8(&state);
+                    args[2] = read_u8(&state);
+                    break;
+
+                case 0x40:
+                    args[0] = read_compressed_u16(&state);
+                    args[1] = read_u8(&state);
+                    break;
+
+                case 0x80:
+                    args[1] = read_u8(&state);
+                    args[2] = read_u8(&state);
+                    break;
+            }
+        } else if ((cmd & 0xC0) == 0x00) {
+            args[0] = read_compressed_u16(&state);
+        }
+        return state.pc - pc;
+    }
+
+    // AudioScript_SeqLayerProcessScriptStep2
+    switch (cmd) {
+        case 0xC1:
+        case 0xC2:
+        case 0xC6:
+        case 0xC9:
+        case 0xCA:
+        case 0xCD:
+        case 0xCE:
+        case 0xCF:
+        case 0xF1:
+            args[0] = read_u8(&state);
+            break;
+
+        case 0xC3:
+            args[0] = read_compressed_u16(&state);
+            break;
+
+        case 0xC7:
+            args[0] = read_u8(&state);
+            args[1] = read_u8(&state);
+            if (args[0] & 0x80) {
+                args[2] = read_u8(&state);
+            } else {
+                args[2] = read_compressed_u16(&state);
+            }
+            break;
+
+        case 0xCB:
+            args[0] = read_s16(&state);
+            args[1] = read_u8(&state);
+            break;
+
+        case 0xF0:
+            args[0] = read_s16(&state);
+            break;
+    }
+    return state.pc - pc;
+}
+
+static void decode_instr(uint8_t* pc, int kind, SeqDecodedInstr* instr) {
+    SeqScriptState reader;
+    uint8_t cmd;
+    uint8_t highBits;
+    uint8_t lowBits;
+    int i;
+
+    reader.pc = pc;
+    cmd = read_u8(&reader);
+
+    instr->pc = pc;
+    instr->cmd = cmd;
+    instr->kind = kind;
+    instr->args[0] = instr->args[1] = instr->args[2] = 0;
+
+    if ((cmd >= 0xF2) || ((kind == SEQ_DECODE_KIND_CHANNEL) && (cmd >= 0xA0))) {
+        highBits = sSeqInstructionArgsTable[cmd - 0xA0];
+        lowBits = highBits & 3;
+
+        for (i = 0; i < lowBits; i++, highBits <<= 1) {
+            if (!(highBits & 0x80)) {
+                instr->args[i] = read_u8(&reader);
+            } else {
+                instr->args[i] = read_s16(&reader);
+            }
+        }
+    } else if (kind == SEQ_DECODE_KIND_CHANNEL) {
+    } else if (cmd == 0xC0) {
+        instr->args[0] = read_compressed_u16(&reader);
+    } else if (cmd < 0xC0) {
+        if (kind == SEQ_DECODE_KIND_LAYER_LARGE_NOTES) {
+            if ((cmd & 0xC0) != 0x80) {
+                instr->args[0] = read_compressed_u16(&reader);
+            }
+            instr->args[1] = read_u8(&reader);
+            if ((cmd & 0xC0) != 0x40) {
+                instr->args[2] = read_u8(&reader);
+            }
+        } else if ((cmd & 0xC0) == 0x00) {
+            instr->args[0] = read_compressed_u16(&reader);
+        }
+    } else {
+        switch (cmd) {
+            case 0xC1:
+            case 0xC2:
+            case 0xC6:
+            case 0xC9:
+            case 0xCA:
+            case 0xCD:
+            case 0xCE:
+            case 0xCF:
+            case 0xF1:
+                instr->args[0] = read_u8(&reader);
+                break;
+
+            case 0xC3:
+                instr->args[0] = read_compressed_u16(&reader);
+                break;
+
+            case 0xC7:
+                instr->args[0] = read_u8(&reader);
+                instr->args[1] = read_u8(&reader);
+                if (instr->args[0] & 0x80) {
+                    instr->args[2] = read_u8(&reader);
+                } else {
+                    instr->args[2] = read_compressed_u16(&reader);
+                }
+                break;
+
+            case 0xCB:
+                instr->args[0] = read_s16(&reader);
+                instr->args[1] = read_u8(&reader);
+                break;
+
+            case 0xF0:
+                instr->args[0] = read_s16(&reader);
+                break;
+        }
+    }
+
+    instr->length = reader.pc - pc;
+}
+
+static int get_cache_index(uint8_t* pc) {
+    return ((uint32_t)(uintptr_t)pc * 0x9E3779B1) >> (32 - SEQ_DECODE_CACHE_BITS);
+}
+
+static SeqDecodedInstr* find_decoded_instr(SeqDecodedInstr* cache, uint8_t* pc, int kind) {
+    int index = get_cache_index(pc);
+    SeqDecodedInstr* instr;
+
+    while (1) {
+        instr = &cache[index];
+        if ((instr->pc == NULL) || ((instr->pc == pc) && (instr->kind == kind))) {
+            return instr;
+        }
+        index = (index + 1) & (SEQ_DECODE_CACHE_SIZE - 1);
+    }
+}
+
+static void flush_player(int playerIndex) {
+    int i;
+
+    for (i = 0; i < SEQ_DECODE_CACHE_SIZE; i++) {
+        sSeqDecodeCaches[playerIndex][i].pc = NULL;
+    }
+    sSeqDecodeCacheFill[playerIndex] = 0;
+}
+
+static SeqDecodedInstr* get_decoded_instr(int playerIndex, SeqScriptState* state, int kind) {
+    SeqDecodedInstr* instr = find_decoded_instr(sSeqDecodeCaches[playerIndex], state->pc, kind);
+
+    if (instr->pc != NULL) {
+        sStats.hits++;
+    } else {
+        sStats.misses++;
+        if (sSeqDecodeCacheFill[playerIndex] >= SEQ_DECODE_CACHE_FILL_MAX) {
+            sStats.flushes++;
+            flush_player(playerIndex);
+            instr = find_decoded_instr(sSeqDecodeCaches[playerIndex], state->pc, kind);
+        }
+        sSeqDecodeCacheFill[playerIndex]++;
+        decode_instr(state->pc, kind, instr);
+    }
+
+    state->pc += instr->length;
+    return instr;
+}
+
+/**
+ * The lookup of the shared cache this replaced, only kept to count its hits
+ */
+static void get_shared_decoded_instr(uint8_t* pc, int kind) {
+    SeqDecodedInstr* instr = &sSharedCache[(uintptr_t)pc & (SEQ_DECODE_SHARED_CACHE_SIZE - 1)];
+
+    if ((instr->pc == pc) && (instr->kind == kind)) {
+        sSharedCacheHits++;
+    } else {
+        decode_instr(pc, kind, instr);
+    }
+}
+
+static void invalidate_decoded_instrs(uint8_t* addr, int size) {
+    SeqDecodedInstr* instr;
+    int playerIndex;
+    int kind;
+    uint8_t* pc;
+
+    for (playerIndex = 0; playerIndex < SEQ_PLAYER_MAX; playerIndex++) {
+        for (pc = addr - (SEQ_DECODE_MAX_LENGTH - 1); pc < addr + size; pc++) {
+            for (kind = SEQ_DECODE_KIND_CHANNEL; kind <= SEQ_DECODE_KIND_LAYER_LARGE_NOTES; kind++) {
+                instr = find_decoded_instr(sSeqDecodeCaches[playerIndex], pc, kind);
+                if ((instr->pc != NULL) && (pc + instr->length > addr)) {
+                    instr->pc = SEQ_DECODE_DROPPED;
+                    sStats.invalidations++;
+                }
+            }
+        }
+    }
+    for (pc = addr - (SEQ_DECODE_MAX_LENGTH - 1); pc < addr + size; pc++) {
+        SeqDecodedInstr* shared = &sSharedCache[(uintptr_t)pc & (SEQ_DECODE_SHARED_CACHE_SIZE - 1)];
+
+        if ((shared->pc == pc) && (pc + shared->length > addr)) {
+            shared->pc = NULL;
+        }
+    }
+}
+
+static uint32_t sRandState = 1;
+
+static uint32_t next_rand(void) {
+    sRandState = sRandState * 1664525 + 1013904223;
+    return sRandState >> 8;
+}
+
+/**
+ * Compares a decoded instruction with the original read of the same bytes. Returns true if they match
+ */
+static bool check_instr(SeqDecodedInstr* instr, uint8_t* pc, int kind) {
+    uint16_t args[3];
+    int length = read_instr_original(pc, kind, args);
+    int i;
+
+    if ((instr->pc != pc) || (instr->cmd != pc[0]) || (instr->kind != kind) || (instr->length != length)) {
+        return false;
+    }
+    for (i = 0; i < 3; i++) {
+        if ((uint16_t)instr->args[i] != args[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void print_mismatch(const char* check, uint8_t* base, uint8_t* pc, int kind) {
+    SeqDecodedInstr instr;
+    uint16_t args[3];
+    int length = read_instr_original(pc, kind, args);
+
+    decode_instr(pc, kind, &instr);
+    printf("%s: offset 0x%04X kind %d cmd 0x%02X: decoded length %d args %04X %04X %04X, original length %d args "
+           "%04X %04X %04X\n",
+           check, (unsigned)(pc - base), kind, pc[0], instr.length, (uint16_t)instr.args[0], (uint16_t)instr.args[1],
+           (uint16_t)instr.args[2], length, args[0], args[1], args[2]);
+}
+
+/**
+ * Decodes every offset of `seq` as every kind. Returns the number of mismatches
+ */
+static unsigned check_all_offsets(uint8_t* seq, size_t size) {
+    SeqDecodedInstr instr;
+    unsigned numBad = 0;
+    size_t offset;
+    int kind;
+
+    for (offset = 0; offset < size; offset++) {
+        for (kind = SEQ_DECODE_KIND_CHANNEL; kind <= SEQ_DECODE_KIND_LAYER_LARGE_NOTES; kind++) {
+            decode_instr(&seq[offset], kind, &instr);
+            if (!check_instr(&instr, &seq[offset], kind)) {
+                if (numBad < 10) {
+                    print_mismatch("offsets", seq, &seq[offset], kind);
+                }
+                numBad++;
+            }
+        }
+    }
+    return numBad;
+}
+
+/**
+ * Steps SEQ_NUM_CHANNELS scripts per sequence player through `seq` via the cache for `numSteps` instructions in total.
+ * Each script loops over its first `loopLength` instructions, as looping sequences do, and `writeRate` in 1024 steps
+ * writes into the script bytes like the script writing commands do. Returns the number of mismatches
+ */
+static unsigned check_cached_walk(uint8_t* seq, size_t size, unsigned numSteps, unsigned writeRate) {
+    SeqScriptState states[SEQ_PLAYER_MAX][SEQ_NUM_CHANNELS];
+    uint8_t* starts[SEQ_PLAYER_MAX][SEQ_NUM_CHANNELS];
+    int kinds[SEQ_PLAYER_MAX][SEQ_NUM_CHANNELS];
+    unsigned loopLengths[SEQ_PLAYER_MAX][SEQ_NUM_CHANNELS];
+    unsigned loopPositions[SEQ_PLAYER_MAX][SEQ_NUM_CHANNELS];
+    unsigned numBad = 0;
+    unsigned step;
+    int playerIndex;
+    int i;
+
+    for (playerIndex = 0; playerIndex < SEQ_PLAYER_MAX; playerIndex++) {
+        flush_player(playerIndex);
+        for (i = 0; i < SEQ_NUM_CHANNELS; i++) {
+            starts[playerIndex][i] = &seq[next_rand() % size];
+            states[playerIndex][i].pc = starts[playerIndex][i];
+            kinds[playerIndex][i] = SEQ_DECODE_KIND_CHANNEL + (next_rand() % 3);
+            loopLengths[playerIndex][i] = 2 + (next_rand() % 15);
+            loopPositions[playerIndex][i] = 0;
+        }
+    }
+
+    for (step = 0; step < numSteps; step++) {
+        SeqScriptState* state;
+        SeqDecodedInstr* instr;
+        uint8_t* pc;
+        int kind;
+
+        playerIndex = next_rand() % SEQ_PLAYER_MAX;
+        i = next_rand() % SEQ_NUM_CHANNELS;
+        state = &states[playerIndex][i];
+        kind = kinds[playerIndex][i];
+
+        if ((state->pc >= &seq[size]) || (loopPositions[playerIndex][i] == loopLengths[playerIndex][i])) {
+            state->pc = starts[playerIndex][i];
+            loopPositions[playerIndex][i] = 0;
+        }
+        loopPositions[playerIndex][i]++;
+
+        pc = state->pc;
+        get_shared_decoded_instr(pc, kind);
+        instr = get_decoded_instr(playerIndex, state, kind);
+        if (!check_instr(instr, pc, kind) || (state->pc != pc + instr->length)) {
+            if (numBad < 10) {
+                print_mismatch("cached walk", seq, pc, kind);
+            }
+            numBad++;
+        }
+
+        if ((next_rand() % 1024) < writeRate) {
+            uint8_t* addr = &seq[next_rand() % size];
+            int writeSize = 1 + (next_rand() % 2);
+
+            addr[0] = next_rand();
+            if (writeSize == 2) {
+                addr[1] = next_rand();
+            }
+            invalidate_decoded_instrs(addr, writeSize);
+        }
+    }
+    return numBad;
+}
+
+static uint8_t* read_file(const char* filename, size_t* size) {
+    FILE* f = fopen(filename, "rb");
+    uint8_t* buf;
+    long fileSize;
+
+    if (f == NULL) {
+        perror(filename);
+        exit(1);
+    }
+    fseek(f, 0, SEEK_END);
+    fileSize = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = calloc(1, fileSize + SEQ_PADDING);
+    if ((buf == NULL) || (fread(buf, 1, fileSize, f) != (size_t)fileSize)) {
+        perror(filename);
+        exit(1);
+    }
+    fclose(f);
+    *size = fileSize;
+    return buf;
+}
+
+static void print_usage(void) {
+    printf("Usage: seqdecode [-f FILE] [-n STEPS] [-w RATE] [-s SEED]\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("-f FILE   sequence binary to check, random bytes if not given\n");
+    printf("-n STEPS  instructions stepped through the cache (default 5000000)\n");
+    printf("-w RATE   script writes per 1024 steps (default 4)\n");
+    printf("-s SEED   random seed (default 1)\n");
+}
+
+int main(int argc, char** argv) {
+    int opt;
+    char* filename = NULL;
+    unsigned numSteps = 5000000;
+    unsigned writeRate = 4;
+    uint8_t* seq;
+    size_t size;
+    unsigned numBad;
+    size_t i;
+
+    while ((opt = getopt(argc, argv, "f:n:w:s:?")) != -1) {
+        switch (opt) {
+            case 'f':
+                filename = optarg;
+                break;
+            case 'n':
+                numSteps = strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                writeRate = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                sRandState = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("seqdecode version %s\n", SEQDECODE_VER);
+                print_usage();
+                return (opt == '?') ? 0 : 1;
+        }
+    }
+
+    if (filename != NULL) {
+        seq = read_file(filename, &size);
+    } else {
+        size = RANDOM_SEQ_SIZE;
+        seq = calloc(1, size + SEQ_PADDING);
+        for (i = 0; i < size; i++) {
+            seq[i] = next_rand();
+        }
+    }
+    if (size == 0) {
+        printf("%s is empty\n", filename);
+        return 1;
+    }
+
+    numBad = check_all_offsets(seq, size);
+    printf("offsets: %zu checked, %u mismatches\n", size * 3, numBad);
+
+    numBad += check_cached_walk(seq, size, numSteps, writeRate);
+    printf("cached walk: %u steps, %u hits, %u misses, %u flushes, %u invalidations\n", numSteps, sStats.hits,
+           sStats.misses, sStats.flushes, sStats.invalidations);
+    printf("shared cache: %u hits, %u misses\n", sSharedCacheHits, numSteps - sSharedCacheHits);
+
+    free(seq);
+    if (numBad != 0) {
+        printf("FAILED, %u mismatches\n", numBad);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,350 @@
+/*
+ * skinverts: checks that Skin_UpdateVertices writes the same vertices and leaves the limb matrix the same as the
+ * version that transformed each normal with SkinMatrix_Vec3fMtxFMultXYZ, and times both.
+ *
+ * update_vertices is a copy of Skin_UpdateVertices in src/code/z_skin.c and needs to be kept in sync with it.
+ * update_vertices_original and vec3f_mtxf_mult_xyz are Skin_UpdateVertices as it was before, clearing and restoring the
+ * translation of the matrix around the loop, and SkinMatrix_Vec3fMtxFMultXYZ from src/code/z_skin_matrix.c.
+ *
+ * Limb matrices are random rotations with a scale of at most 1 and random translations, so that rotated normals stay
+ * in the s8 range as they do in game. Each case runs both versions on the same modification entry, vertex buffer and
+ * matrix, and compares the vertex buffers and matrices byte for byte.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#define SKINVERTS_VER "0.1"
+
+#define VTX_BUF_SIZE 256
+
+typedef struct {
+    float xx, yx, zx, wx;
+    float xy, yy, zy, wy;
+    float xz, yz, zz, wz;
+    float xw, yw, zw, ww;
+} MtxF;
+
+typedef struct {
+    float x, y, z;
+} Vec3f;
+
+typedef struct {
+    int16_t ob[3];
+    uint16_t flag;
+    int16_t tc[2];
+    int8_t n[3];
+    uint8_t a;
+} VtxN;
+
+typedef union {
+    VtxN n;
+} Vtx;
+
+typedef struct {
+    uint16_t index;
+    int16_t s;
+    int16_t t;
+    int8_t normX;
+    int8_t normY;
+    int8_t normZ;
+    uint8_t alpha;
+} SkinVertex;
+
+typedef struct {
+    uint16_t vtxCount;
+} SkinLimbModif;
+
+/*
+ * Previous version
+ */
+
+static void vec3f_mtxf_mult_xyz(MtxF* mf, Vec3f* src, Vec3f* dest) {
+    float mx = mf->xx;
+    float my = mf->xy;
+    float mz = mf->xz;
+    float mw = mf->xw;
+
+    dest->x = mw + ((src->x * mx) + (src->y * my) + (src->z * mz));
+
+    mx = mf->yx;
+    my = mf->yy;
+    mz = mf->yz;
+    mw = mf->yw;
+    dest->y = mw + ((src->x * mx) + (src->y * my) + (src->z * mz));
+
+    mx = mf->zx;
+    my = mf->zy;
+    mz = mf->zz;
+    mw = mf->zw;
+    dest->z = mw + ((src->x * mx) + (src->y * my) + (src->z * mz));
+}
+
+static void update_vertices_original(MtxF* mtx, SkinVertex* skinVertices, SkinLimbModif* modifEntry, Vtx* vtxBuf,
+                                     Vec3f* pos) {
+    SkinVertex* vertexEntry;
+    Vtx* vtx;
+    Vec3f wTemp;
+    Vec3f normal;
+    Vec3f sp44;
+
+    wTemp.x = mtx->xw;
+    wTemp.y = mtx->yw;
+    wTemp.z = mtx->zw;
+
+    mtx->xw = 0.0f;
+    mtx->yw = 0.0f;
+    mtx->zw = 0.0f;
+
+    for (vertexEntry = skinVertices; vertexEntry < &skinVertices[modifEntry->vtxCount]; vertexEntry++) {
+        vtx = &vtxBuf[vertexEntry->index];
+
+        vtx->n.ob[0] = pos->x;
+        vtx->n.ob[1] = pos->y;
+        vtx->n.ob[2] = pos->z;
+
+        sp44.x = vertexEntry->normX;
+        sp44.y = vertexEntry->normY;
+        sp44.z = vertexEntry->normZ;
+
+        vec3f_mtxf_mult_xyz(mtx, &sp44, &normal);
+
+        vtx->n.n[0] = normal.x;
+        vtx->n.n[1] = normal.y;
+        vtx->n.n[2] = normal.z;
+    }
+
+    mtx->xw = wTemp.x;
+    mtx->yw = wTemp.y;
+    mtx->zw = wTemp.z;
+}
+
+/*
+ * Current version
+ */
+
+static void update_vertices(MtxF* mtx, SkinVertex* skinVertices, SkinLimbModif* modifEntry, Vtx* vtxBuf, Vec3f* pos) {
+    SkinVertex* vertexEntry;
+    Vtx* vtx;
+    float xx = mtx->xx;
+    float xy = mtx->xy;
+    float xz = mtx->xz;
+    float yx = mtx->yx;
+    float yy = mtx->yy;
+    float yz = mtx->yz;
+    float zx = mtx->zx;
+    float zy = mtx->zy;
+    float zz = mtx->zz;
+    float normX;
+    float normY;
+    float normZ;
+    int16_t posX = pos->x;
+    int16_t posY = pos->y;
+    int16_t posZ = pos->z;
+
+    for (vertexEntry = skinVertices; vertexEntry < &skinVertices[modifEntry->vtxCount]; vertexEntry++) {
+        vtx = &vtxBuf[vertexEntry->index];
+
+        vtx->n.ob[0] = posX;
+        vtx->n.ob[1] = posY;
+        vtx->n.ob[2] = posZ;
+
+        normX = vertexEntry->normX;
+        normY = vertexEntry->normY;
+        normZ = vertexEntry->normZ;
+
+        vtx->n.n[0] = (normX * xx) + (normY * xy) + (normZ * xz);
+        vtx->n.n[1] = (normX * yx) + (normY * yy) + (normZ * yz);
+        vtx->n.n[2] = (normX * zx) + (normY * zy) + (normZ * zz);
+    }
+}
+
+/*
+ * Test driver
+ */
+
+static uint32_t sRandState = 1;
+
+static uint32_t next_rand(void) {
+    sRandState = sRandState * 1664525 + 1013904223;
+    return sRandState >> 8;
+}
+
+static float rand_float(void) {
+    return (next_rand() & 0xFFFFFF) / (float)0x1000000;
+}
+
+/**
+ * Sets `mtx` to a random rotation scaled by at most 1, from a random unit quaternion, with a random translation
+ */
+static void random_limb_matrix(MtxF* mtx) {
+    float w = rand_float() * 2.0f - 1.0f;
+    float x = rand_float() * 2.0f - 1.0f;
+    float y = rand_float() * 2.0f - 1.0f;
+    float z = rand_float() * 2.0f - 1.0f;
+    float len = sqrtf(w * w + x * x + y * y + z * z);
+    float scale = 0.25f + 0.75f * rand_float();
+
+    if (len < 1e-3f) {
+        w = 1.0f;
+        len = 1.0f;
+    }
+    w /= len;
+    x /= len;
+    y /= len;
+    z /= len;
+
+    mtx->xx = scale * (1.0f - 2.0f * (y * y + z * z));
+    mtx->xy = scale * (2.0f * (x * y - w * z));
+    mtx->xz = scale * (2.0f * (x * z + w * y));
+    mtx->yx = scale * (2.0f * (x * y + w * z));
+    mtx->yy = scale * (1.0f - 2.0f * (x * x + z * z));
+    mtx->yz = scale * (2.0f * (y * z - w * x));
+    mtx->zx = scale * (2.0f * (x * z - w * y));
+    mtx->zy = scale * (2.0f * (y * z + w * x));
+    mtx->zz = scale * (1.0f - 2.0f * (x * x + y * y));
+    mtx->xw = (rand_float() - 0.5f) * 4000.0f;
+    mtx->yw = (rand_float() - 0.5f) * 4000.0f;
+    mtx->zw = (rand_float() - 0.5f) * 4000.0f;
+    mtx->wx = mtx->wy = mtx->wz = 0.0f;
+    mtx->ww = 1.0f;
+}
+
+static void random_modif(SkinVertex* skinVertices, SkinLimbModif* modifEntry, int vtxCount) {
+    int i;
+
+    modifEntry->vtxCount = vtxCount;
+    for (i = 0; i < vtxCount; i++) {
+        skinVertices[i].index = next_rand() % VTX_BUF_SIZE;
+        skinVertices[i].s = next_rand();
+        skinVertices[i].t = next_rand();
+        skinVertices[i].normX = (int)(next_rand() % 255) - 127;
+        skinVertices[i].normY = (int)(next_rand() % 255) - 127;
+        skinVertices[i].normZ = (int)(next_rand() % 255) - 127;
+        skinVertices[i].alpha = next_rand();
+    }
+}
+
+static double get_time(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void print_usage(void) {
+    printf("Usage: skinverts [-n CASES] [-v VERTICES] [-i ITERATIONS] [-s SEED]\n");
+    printf("\n");
+    printf("Options:\n");
+    printf("-n CASES       random modification entries to check (default 100000)\n");
+    printf("-v VERTICES    vertices in the timed modification entry, at most %d (default 40)\n", VTX_BUF_SIZE);
+    printf("-i ITERATIONS  timed runs of each version (default 2000000)\n");
+    printf("-s SEED        random seed (default 1)\n");
+}
+
+int main(int argc, char** argv) {
+    static SkinVertex sSkinVertices[VTX_BUF_SIZE];
+    static Vtx sInitialVtxBuf[VTX_BUF_SIZE];
+    static Vtx sOriginalVtxBuf[VTX_BUF_SIZE];
+    static Vtx sVtxBuf[VTX_BUF_SIZE];
+    SkinLimbModif modifEntry;
+    MtxF initialMtx;
+    MtxF originalMtx;
+    MtxF mtx;
+    Vec3f pos;
+    unsigned numCases = 100000;
+    unsigned numTimedVertices = 40;
+    unsigned iterations = 2000000;
+    unsigned numMismatches = 0;
+    unsigned n;
+    unsigned i;
+    double originalTime;
+    double time;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:v:i:s:?")) != -1) {
+        switch (opt) {
+            case 'n':
+                numCases = strtoul(optarg, NULL, 0);
+                break;
+            case 'v':
+                numTimedVertices = strtoul(optarg, NULL, 0);
+                break;
+            case 'i':
+                iterations = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                sRandState = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("skinverts version %s\n", SKINVERTS_VER);
+                print_usage();
+                return (opt == '?') ? 0 : 1;
+        }
+    }
+    if (numTimedVertices > VTX_BUF_SIZE) {
+        print_usage();
+        return 1;
+    }
+
+    for (n = 0; n < numCases; n++) {
+        random_limb_matrix(&initialMtx);
+        random_modif(sSkinVertices, &modifEntry, 1 + next_rand() % VTX_BUF_SIZE);
+        pos.x = (rand_float() - 0.5f) * 60000.0f;
+        pos.y = (rand_float() - 0.5f) * 60000.0f;
+        pos.z = (rand_float() - 0.5f) * 60000.0f;
+        for (i = 0; i < sizeof(sInitialVtxBuf); i++) {
+            ((uint8_t*)sInitialVtxBuf)[i] = next_rand();
+        }
+
+        originalMtx = initialMtx;
+        memcpy(sOriginalVtxBuf, sInitialVtxBuf, sizeof(sInitialVtxBuf));
+        update_vertices_original(&originalMtx, sSkinVertices, &modifEntry, sOriginalVtxBuf, &pos);
+
+        mtx = initialMtx;
+        memcpy(sVtxBuf, sInitialVtxBuf, sizeof(sInitialVtxBuf));
+        update_vertices(&mtx, sSkinVertices, &modifEntry, sVtxBuf, &pos);
+
+        if ((memcmp(sOriginalVtxBuf, sVtxBuf, sizeof(sVtxBuf)) != 0) ||
+            (memcmp(&originalMtx, &mtx, sizeof(MtxF)) != 0)) {
+            if (numMismatches < 10) {
+                printf("error: case %u with %u vertices differs\n", n, modifEntry.vtxCount);
+            }
+            numMismatches++;
+        }
+    }
+
+    random_limb_matrix(&mtx);
+    random_modif(sSkinVertices, &modifEntry, numTimedVertices);
+    pos.x = pos.y = pos.z = 100.0f;
+
+    originalTime = get_time();
+    for (i = 0; i < iterations; i++) {
+        update_vertices_original(&mtx, sSkinVertices, &modifEntry, sVtxBuf, &pos);
+    }
+    originalTime = get_time() - originalTime;
+
+    time = get_time();
+    for (i = 0; i < iterations; i++) {
+        update_vertices(&mtx, sSkinVertices, &modifEntry, sVtxBuf, &pos);
+    }
+    time = get_time() - time;
+
+    printf("%u cases checked, %u mismatches\n", numCases, numMismatches);
+    printf("%u vertices, %u runs: original %.1f ns/run, current %.1f ns/run\n", numTimedVertices, iterations,
+           originalTime * 1e9 / iterations, time * 1e9 / iterations);
+
+    if (numMismatches != 0) {
+        printf("FAILED\n");
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}